@@ -0,0 +1,80 @@
+#ifndef _FURY_ALIGNED_ALLOCATOR_H_
+#define _FURY_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#include "Fury/Macros.h"
+
+namespace fury
+{
+	// stl allocator that aligns memory to Alignment bytes, used by dense arrays that are streamed or loaded by simd.
+	template<class T, size_t Alignment = 64>
+	class AlignedAllocator
+	{
+	public:
+
+		typedef T value_type;
+
+		template<class U>
+		struct rebind
+		{
+			typedef AlignedAllocator<U, Alignment> other;
+		};
+
+		AlignedAllocator() {}
+
+		template<class U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment> &other) {}
+
+		T *allocate(size_t count)
+		{
+			if (count == 0)
+				return nullptr;
+
+			void *ptr = nullptr;
+#ifdef _MSC_VER
+			ptr = _aligned_malloc(count * sizeof(T), Alignment);
+#else
+			if (posix_memalign(&ptr, Alignment, count * sizeof(T)) != 0)
+				ptr = nullptr;
+#endif
+			if (ptr == nullptr)
+				throw std::bad_alloc();
+
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T *ptr, size_t)
+		{
+#ifdef _MSC_VER
+			_aligned_free(ptr);
+#else
+			free(ptr);
+#endif
+		}
+
+		template<class U>
+		bool operator == (const AlignedAllocator<U, Alignment> &other) const
+		{
+			return true;
+		}
+
+		template<class U>
+		bool operator != (const AlignedAllocator<U, Alignment> &other) const
+		{
+			return false;
+		}
+	};
+
+	template<class T, size_t Alignment = 64>
+	using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+}
+
+#endif // _FURY_ALIGNED_ALLOCATOR_H_
\ No newline at end of file
@@ -1,8 +1,210 @@
+#include <algorithm>
+#include <cmath>
+
 #include "Fury/AnimationClip.h"
 #include "Fury/Log.h"
+#include "Fury/MathUtil.h"
 
 namespace fury
 {
+	// compressed tracks keep ticks as shorts.
+	template<class TickType>
+	static unsigned int FindKeyInTicks(const std::vector<TickType> &ticks, float tick, unsigned int &cursor)
+	{
+		unsigned int count = ticks.size();
+		if (count < 2)
+			return cursor = 0;
+
+		unsigned int last = count - 2;
+
+		// playback moves forward a key or two per frame.
+		if (cursor <= last && ticks[cursor] <= tick)
+		{
+			for (unsigned int i = 0; i < 3 && cursor <= last; i++, cursor++)
+			{
+				if (cursor == last || ticks[cursor + 1] > tick)
+					return cursor;
+			}
+		}
+
+		// looped, seeked or skipped far.
+		auto it = std::upper_bound(ticks.begin(), ticks.end(), tick);
+		unsigned int index = it == ticks.begin() ? 0 : (unsigned int)(it - ticks.begin()) - 1;
+		return cursor = std::min(index, last);
+	}
+
+	unsigned int AnimationTrack::GetKeyCount() const
+	{
+		return compressed != nullptr ? compressed->ticks.size() : ticks.size();
+	}
+
+	float AnimationTrack::GetTick(unsigned int index) const
+	{
+		return compressed != nullptr ? (float)compressed->ticks[index] : ticks[index];
+	}
+
+	unsigned int AnimationTrack::FindKey(float tick, unsigned int &cursor) const
+	{
+		if (compressed != nullptr)
+			return FindKeyInTicks(compressed->ticks, tick, cursor);
+
+		return FindKeyInTicks(ticks, tick, cursor);
+	}
+
+	bool AnimationTrack::Sample(float tick, unsigned int &cursor, float *output) const
+	{
+		unsigned int count = GetKeyCount();
+		if (count == 0)
+			return false;
+
+		unsigned int key = FindKey(tick, cursor);
+		unsigned int next = std::min(key + 1, count - 1);
+
+		float ratio = 0.0f;
+		if (next != key)
+		{
+			float from = GetTick(key);
+			ratio = std::min(std::max((tick - from) / (GetTick(next) - from), 0.0f), 1.0f);
+		}
+
+		// only the two keys around tick are decoded.
+		Vector4 a, b;
+		if (compressed != nullptr)
+		{
+			a = compressed->GetKey(key, rotation);
+			b = next != key ? compressed->GetKey(next, rotation) : a;
+		}
+		else
+		{
+			a = Vector4(x[key], y[key], z[key], rotation ? w[key] : 0.0f);
+			b = Vector4(x[next], y[next], z[next], rotation ? w[next] : 0.0f);
+		}
+
+		if (rotation)
+		{
+			Quaternion q = Quaternion(a.x, a.y, a.z, a.w).Slerp(Quaternion(b.x, b.y, b.z, b.w), ratio);
+			output[0] = q.x;
+			output[1] = q.y;
+			output[2] = q.z;
+			output[3] = q.w;
+		}
+		else
+		{
+			output[0] = a.x + (b.x - a.x) * ratio;
+			output[1] = a.y + (b.y - a.y) * ratio;
+			output[2] = a.z + (b.z - a.z) * ratio;
+		}
+
+		return true;
+	}
+
+	bool CompressedTrack::IsConstant() const
+	{
+		return values.empty() && !ticks.empty();
+	}
+
+	size_t CompressedTrack::GetMemorySize() const
+	{
+		if (ticks.empty())
+			return 0;
+
+		return (ticks.size() + values.size()) * sizeof(unsigned short) + sizeof(Vector4) * 2;
+	}
+
+	Vector4 CompressedTrack::GetKey(unsigned int index, bool rotation) const
+	{
+		if (IsConstant())
+			return min;
+
+		if (rotation)
+		{
+			Quaternion q = DecodeQuat(&values[index * 3]);
+			return Vector4(q.x, q.y, q.z, q.w);
+		}
+
+		return DecodeVector(&values[index * 3], min, extent);
+	}
+
+	void CompressedTrack::EncodeQuat(const Quaternion &quat, unsigned short *output)
+	{
+		float q[4] = { quat.x, quat.y, quat.z, quat.w };
+
+		float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		if (length == 0.0f)
+		{
+			q[3] = length = 1.0f;
+		}
+
+		unsigned int largest = 0;
+		for (unsigned int i = 1; i < 4; i++)
+		{
+			if (std::abs(q[i]) > std::abs(q[largest]))
+				largest = i;
+		}
+
+		// q and -q are the same rotation, so the dropped component can always be positive,
+		// the other three are then within +-1/sqrt(2).
+		float scale = (q[largest] < 0.0f ? -1.0f : 1.0f) * 1.41421356f / length;
+
+		unsigned short packed[3];
+		for (unsigned int i = 0, j = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			float value = std::min(std::max(q[i] * scale, -1.0f), 1.0f);
+			packed[j++] = (unsigned short)std::lround((value * 0.5f + 0.5f) * 32767.0f);
+		}
+
+		output[0] = packed[0] | (unsigned short)((largest & 1) << 15);
+		output[1] = packed[1] | (unsigned short)((largest >> 1) << 15);
+		output[2] = packed[2];
+	}
+
+	Quaternion CompressedTrack::DecodeQuat(const unsigned short *input)
+	{
+		unsigned int largest = (input[0] >> 15) | ((input[1] >> 15) << 1);
+
+		float q[4];
+		float sum = 0.0f;
+		for (unsigned int i = 0, j = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			q[i] = ((input[j++] & 0x7fff) / 32767.0f * 2.0f - 1.0f) * 0.70710678f;
+			sum += q[i] * q[i];
+		}
+
+		q[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+
+		return Quaternion(q[0], q[1], q[2], q[3]);
+	}
+
+	void CompressedTrack::EncodeVector(const Vector4 &vector, const Vector4 &min, const Vector4 &extent, unsigned short *output)
+	{
+		auto Encode = [](float value, float min, float extent) -> unsigned short
+		{
+			if (extent <= 0.0f)
+				return 0;
+
+			float ratio = std::min(std::max((value - min) / extent, 0.0f), 1.0f);
+			return (unsigned short)std::lround(ratio * 65535.0f);
+		};
+
+		output[0] = Encode(vector.x, min.x, extent.x);
+		output[1] = Encode(vector.y, min.y, extent.y);
+		output[2] = Encode(vector.z, min.z, extent.z);
+	}
+
+	Vector4 CompressedTrack::DecodeVector(const unsigned short *input, const Vector4 &min, const Vector4 &extent)
+	{
+		return Vector4(
+			min.x + input[0] / 65535.0f * extent.x,
+			min.y + input[1] / 65535.0f * extent.y,
+			min.z + input[2] / 65535.0f * extent.z);
+	}
+
 	AnimationClip::Ptr AnimationClip::Create(const std::string &name, int ticksPerSecond)
 	{
 		return std::make_shared<AnimationClip>(name, ticksPerSecond);
@@ -19,6 +221,218 @@ namespace fury
 		FURYD << "AnimationClip " << m_Name << " destoried!";
 	}
 
+	bool AnimationClip::Load(const void* wrapper, bool object)
+	{
+		if (object && !IsObject(wrapper))
+		{
+			FURYE << "Json node is not an object!";
+			return false;
+		}
+
+		if (!Entity::Load(wrapper, false))
+			return false;
+
+		LoadMemberValue(wrapper, "ticks_per_second", m_TicksPerSecond);
+		LoadMemberValue(wrapper, "speed", m_Speed);
+		LoadMemberValue(wrapper, "loop", m_Loop);
+
+		m_Channels.clear();
+		m_CompressedChannels.clear();
+		m_CompileDirty = true;
+
+		// track is { ticks, values }, 3 values per tick.
+		auto LoadTrack = [&](const void* node, const std::string &name, std::vector<KeyFrame> &frames) -> bool
+		{
+			auto trackWrapper = FindMember(node, name);
+			if (trackWrapper == nullptr)
+				return true;
+
+			std::vector<unsigned int> ticks;
+			std::vector<float> values;
+			if (!LoadArray(trackWrapper, "ticks", ticks) || !LoadArray(trackWrapper, "values", values) ||
+				values.size() != ticks.size() * 3)
+			{
+				FURYE << "Invalide " << name << " track!";
+				return false;
+			}
+
+			for (unsigned int i = 0; i < ticks.size(); i++)
+				frames.push_back(KeyFrame(ticks[i], values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+
+			return true;
+		};
+
+		// compressed track is { ticks, values, min, extent }, 3 values per tick or none if constant.
+		auto LoadCompressedTrack = [&](const void* node, const std::string &name, CompressedTrack &track) -> bool
+		{
+			auto trackWrapper = FindMember(node, name);
+			if (trackWrapper == nullptr)
+				return true;
+
+			std::vector<unsigned int> ticks, values;
+			if (!LoadArray(trackWrapper, "ticks", ticks) || !LoadArray(trackWrapper, "values", values) ||
+				!LoadMemberValue(trackWrapper, "min", track.min) || !LoadMemberValue(trackWrapper, "extent", track.extent) ||
+				(values.size() != ticks.size() * 3 && !values.empty()))
+			{
+				FURYE << "Invalide " << name << " track!";
+				return false;
+			}
+
+			track.ticks.assign(ticks.begin(), ticks.end());
+			track.values.assign(values.begin(), values.end());
+			return true;
+		};
+
+		if (IsArray(wrapper, "compressed_channels"))
+		{
+			if (!LoadArray(wrapper, "compressed_channels", [&](const void* node) -> bool
+			{
+				CompressedChannel channel;
+				if (!LoadMemberValue(node, "name", channel.name))
+				{
+					FURYE << "Channel name not found!";
+					return false;
+				}
+
+				if (!LoadCompressedTrack(node, "positions", channel.positions) ||
+					!LoadCompressedTrack(node, "rotations", channel.rotations) ||
+					!LoadCompressedTrack(node, "scalings", channel.scalings))
+					return false;
+
+				m_CompressedChannels.push_back(std::move(channel));
+				return true;
+			}))
+			{
+				FURYE << "Error serializing compressed channels!";
+				return false;
+			}
+		}
+		else if (!LoadArray(wrapper, "channels", [&](const void* node) -> bool
+		{
+			std::string name;
+			if (!LoadMemberValue(node, "name", name))
+			{
+				FURYE << "Channel name not found!";
+				return false;
+			}
+
+			auto channel = AddChannel(name);
+			return LoadTrack(node, "positions", channel->positions) &&
+				LoadTrack(node, "rotations", channel->rotations) &&
+				LoadTrack(node, "scalings", channel->scalings);
+		}))
+		{
+			FURYE << "Error serializing channels!";
+			return false;
+		}
+
+		if (!LoadMemberValue(wrapper, "duration", m_Duration))
+			CalculateDuration();
+
+		return true;
+	}
+
+	void AnimationClip::Save(void* wrapper, bool object)
+	{
+		if (object)
+			StartObject(wrapper);
+
+		Entity::Save(wrapper, false);
+
+		SaveKey(wrapper, "ticks_per_second");
+		SaveValue(wrapper, m_TicksPerSecond);
+
+		SaveKey(wrapper, "duration");
+		SaveValue(wrapper, m_Duration);
+
+		SaveKey(wrapper, "speed");
+		SaveValue(wrapper, m_Speed);
+
+		SaveKey(wrapper, "loop");
+		SaveValue(wrapper, m_Loop);
+
+		auto SaveTrack = [&](const std::string &name, const std::vector<KeyFrame> &frames)
+		{
+			if (frames.empty())
+				return;
+
+			std::vector<unsigned int> ticks;
+			std::vector<float> values;
+			for (const auto &frame : frames)
+			{
+				ticks.push_back(frame.tick);
+				values.push_back(frame.x);
+				values.push_back(frame.y);
+				values.push_back(frame.z);
+			}
+
+			SaveKey(wrapper, name);
+			StartObject(wrapper);
+			SaveKey(wrapper, "ticks");
+			SaveArray(wrapper, ticks);
+			SaveKey(wrapper, "values");
+			SaveArray(wrapper, values);
+			EndObject(wrapper);
+		};
+
+		auto SaveCompressedTrack = [&](const std::string &name, const CompressedTrack &track)
+		{
+			if (track.ticks.empty())
+				return;
+
+			std::vector<unsigned int> ticks(track.ticks.begin(), track.ticks.end());
+			std::vector<unsigned int> values(track.values.begin(), track.values.end());
+
+			SaveKey(wrapper, name);
+			StartObject(wrapper);
+			SaveKey(wrapper, "ticks");
+			SaveArray(wrapper, ticks);
+			SaveKey(wrapper, "values");
+			SaveArray(wrapper, values);
+			SaveKey(wrapper, "min");
+			SaveValue(wrapper, track.min);
+			SaveKey(wrapper, "extent");
+			SaveValue(wrapper, track.extent);
+			EndObject(wrapper);
+		};
+
+		if (IsCompressed())
+		{
+			SaveKey(wrapper, "compressed_channels");
+			SaveArray(wrapper, m_CompressedChannels.size(), [&](unsigned int index)
+			{
+				const auto &channel = m_CompressedChannels[index];
+
+				StartObject(wrapper);
+				SaveKey(wrapper, "name");
+				SaveValue(wrapper, channel.name);
+				SaveCompressedTrack("positions", channel.positions);
+				SaveCompressedTrack("rotations", channel.rotations);
+				SaveCompressedTrack("scalings", channel.scalings);
+				EndObject(wrapper);
+			});
+		}
+		else
+		{
+			SaveKey(wrapper, "channels");
+			SaveArray(wrapper, m_Channels.size(), [&](unsigned int index)
+			{
+				const auto &channel = m_Channels[index];
+
+				StartObject(wrapper);
+				SaveKey(wrapper, "name");
+				SaveValue(wrapper, channel->name);
+				SaveTrack("positions", channel->positions);
+				SaveTrack("rotations", channel->rotations);
+				SaveTrack("scalings", channel->scalings);
+				EndObject(wrapper);
+			});
+		}
+
+		if (object)
+			EndObject(wrapper);
+	}
+
 	void AnimationClip::CalculateDuration()
 	{
 		m_Duration = 0.0f;
@@ -44,6 +458,15 @@ namespace fury
 			if (sclCount > 0)
 				Try(channel->scalings[sclCount - 1].tick);
 		}
+
+		for (const auto &channel : m_CompressedChannels)
+		{
+			for (const auto *track : { &channel.positions, &channel.rotations, &channel.scalings })
+			{
+				if (!track->ticks.empty())
+					Try(track->ticks.back());
+			}
+		}
 	}
 
 	float AnimationClip::GetDuration() const
@@ -99,12 +522,14 @@ namespace fury
 	{
 		auto channel = std::make_shared<AnimationChannel>(name);
 		m_Channels.push_back(channel);
+		m_CompileDirty = true;
 		return channel;
 	}
 
 	void AnimationClip::AddChannel(const AnimationClip::ChannelPtr &channel)
 	{
 		m_Channels.push_back(channel);
+		m_CompileDirty = true;
 	}
 
 	AnimationClip::ChannelPtr AnimationClip::RemoveChannel(const std::string &name)
@@ -115,6 +540,7 @@ namespace fury
 			if (channel->name == name)
 			{
 				m_Channels.erase(m_Channels.begin() + i);
+				m_CompileDirty = true;
 				return channel;
 			}
 		}
@@ -139,4 +565,108 @@ namespace fury
 		else
 			return nullptr;
 	}
+
+	bool AnimationClip::IsCompressed() const
+	{
+		return !m_CompressedChannels.empty();
+	}
+
+	const std::vector<CompressedChannel> &AnimationClip::GetCompressedChannels() const
+	{
+		return m_CompressedChannels;
+	}
+
+	void AnimationClip::Compile()
+	{
+		auto CompileTrack = [](const std::vector<KeyFrame> &frames, AnimationTrack &track, bool rotation)
+		{
+			unsigned int count = frames.size();
+			track.compressed = nullptr;
+			track.rotation = rotation;
+			track.ticks.resize(count);
+			track.x.resize(count);
+			track.y.resize(count);
+			track.z.resize(count);
+			track.w.resize(rotation ? count : 0);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				const KeyFrame &frame = frames[i];
+				track.ticks[i] = (float)frame.tick;
+
+				if (rotation)
+				{
+					// keyframes store euler radians, convert once instead of every sample.
+					Quaternion q = MathUtil::EulerRadToQuat(Vector4(frame.x, frame.y, frame.z));
+					track.x[i] = q.x;
+					track.y[i] = q.y;
+					track.z[i] = q.z;
+					track.w[i] = q.w;
+				}
+				else
+				{
+					track.x[i] = frame.x;
+					track.y[i] = frame.y;
+					track.z[i] = frame.z;
+				}
+			}
+		};
+
+		// keys stay compressed, so the clip only keeps the compressed copy resident.
+		auto BindTrack = [](const CompressedTrack &compressed, AnimationTrack &track, bool rotation)
+		{
+			track = AnimationTrack();
+			track.compressed = &compressed;
+			track.rotation = rotation;
+		};
+
+		if (IsCompressed())
+		{
+			m_CompiledChannels.resize(m_CompressedChannels.size());
+			for (unsigned int i = 0; i < m_CompressedChannels.size(); i++)
+			{
+				const auto &channel = m_CompressedChannels[i];
+				auto &compiled = m_CompiledChannels[i];
+
+				compiled.name = channel.name;
+				compiled.hashCode = std::hash<std::string>()(channel.name);
+				BindTrack(channel.positions, compiled.positions, false);
+				BindTrack(channel.rotations, compiled.rotations, true);
+				BindTrack(channel.scalings, compiled.scalings, false);
+			}
+
+			m_CompileDirty = false;
+			m_CompileVersion++;
+			return;
+		}
+
+		m_CompiledChannels.resize(m_Channels.size());
+		for (unsigned int i = 0; i < m_Channels.size(); i++)
+		{
+			const auto &channel = m_Channels[i];
+			auto &compiled = m_CompiledChannels[i];
+
+			compiled.name = channel->name;
+			compiled.hashCode = std::hash<std::string>()(channel->name);
+			CompileTrack(channel->positions, compiled.positions, false);
+			CompileTrack(channel->rotations, compiled.rotations, true);
+			CompileTrack(channel->scalings, compiled.scalings, false);
+		}
+
+		m_CompileDirty = false;
+		m_CompileVersion++;
+	}
+
+	const std::vector<CompiledChannel> &AnimationClip::GetCompiledChannels()
+	{
+		if (m_CompileDirty)
+			Compile();
+
+		return m_CompiledChannels;
+	}
+
+	unsigned int AnimationClip::GetCompileVersion() const
+	{
+		return m_CompileVersion;
+	}
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "Fury/Entity.h"
+#include "Fury/Quaternion.h"
+#include "Fury/Vector4.h"
 
 namespace fury
 {
@@ -35,6 +37,95 @@ namespace fury
 			name(name) {}
 	};
 
+	// one curve of a compressed clip, built by AnimationUtil::CompressAnimClip.
+	// keys are reduced and quantized to 3 shorts each, constant tracks keep no keys.
+	struct FURY_API CompressedTrack
+	{
+	public:
+
+		// ticks of kept keys, first and last key are always kept.
+		std::vector<unsigned short> ticks;
+
+		// 3 shorts per key. positions and scalings are min + q / 65535 * extent,
+		// rotations use smallest three, 2 bits for the dropped component and 15 bits for the others.
+		std::vector<unsigned short> values;
+
+		// range of positions and scalings. constant tracks keep their value in min, a quaternion for rotations.
+		Vector4 min, extent;
+
+		bool IsConstant() const;
+
+		// bytes used by keys and ranges.
+		size_t GetMemorySize() const;
+
+		// decoded key, a quaternion in x, y, z, w for rotations.
+		Vector4 GetKey(unsigned int index, bool rotation) const;
+
+		static void EncodeQuat(const Quaternion &quat, unsigned short *output);
+
+		static Quaternion DecodeQuat(const unsigned short *input);
+
+		static void EncodeVector(const Vector4 &vector, const Vector4 &min, const Vector4 &extent, unsigned short *output);
+
+		static Vector4 DecodeVector(const unsigned short *input, const Vector4 &min, const Vector4 &extent);
+	};
+
+	// keys of one channel curve as struct of arrays, built by AnimationClip::Compile.
+	// rotations are quaternions in x, y, z, w, positions and scalings leave w empty.
+	// tracks of compressed clips keep no keys, they point to the clip's compressed track and decode keys while sampling.
+	struct FURY_API AnimationTrack
+	{
+	public:
+
+		std::vector<float> ticks;
+
+		std::vector<float> x, y, z, w;
+
+		const CompressedTrack *compressed = nullptr;
+
+		bool rotation = false;
+
+		unsigned int GetKeyCount() const;
+
+		float GetTick(unsigned int index) const;
+
+		// first key of the segment holding tick. tries cursor and the next keys first,
+		// so forward playback is O(1), then falls back to binary search. cursor is updated.
+		unsigned int FindKey(float tick, unsigned int &cursor) const;
+
+		// interpolates the track at tick into output, 3 floats, or 4 for rotations.
+		// ticks outside the keys clamp to the first or last key. false if track has no keys.
+		bool Sample(float tick, unsigned int &cursor, float *output) const;
+	};
+
+	struct CompiledChannel
+	{
+	public:
+
+		std::string name;
+
+		size_t hashCode;
+
+		AnimationTrack positions;
+
+		AnimationTrack rotations;
+
+		AnimationTrack scalings;
+	};
+
+	struct CompressedChannel
+	{
+	public:
+
+		std::string name;
+
+		CompressedTrack positions;
+
+		CompressedTrack rotations;
+
+		CompressedTrack scalings;
+	};
+
 	class FURY_API AnimationClip final : public Entity
 	{
 	public:
@@ -59,12 +150,26 @@ namespace fury
 
 		bool m_Loop = true;
 
+		std::vector<CompiledChannel> m_CompiledChannels;
+
+		bool m_CompileDirty = true;
+
+		// set by AnimationUtil::CompressAnimClip, which clears m_Channels.
+		std::vector<CompressedChannel> m_CompressedChannels;
+
+		// increases every Compile, so players know their joint bindings are stale.
+		unsigned int m_CompileVersion = 0;
+
 	public:
 
 		AnimationClip(const std::string &name, int ticksPerSecond = 24);
 
 		virtual ~AnimationClip();
 
+		virtual bool Load(const void* wrapper, bool object = true) override;
+
+		virtual void Save(void* wrapper, bool object = true) override;
+
 		void CalculateDuration();
 
 		float GetDuration() const;
@@ -94,6 +199,19 @@ namespace fury
 		ChannelPtr GetChannel(const std::string &name) const;
 
 		ChannelPtr GetChannelAt(unsigned int index) const;
+
+		// channels are empty for compressed clips, use AnimationUtil::DecompressAnimClip to edit them.
+		bool IsCompressed() const;
+
+		const std::vector<CompressedChannel> &GetCompressedChannels() const;
+
+		// rebuilds compiled channels from channels, or points them to compressed ones, call after editing channel keyframes.
+		// Add/RemoveChannel mark the clip dirty, GetCompiledChannels compiles dirty clips.
+		void Compile();
+
+		const std::vector<CompiledChannel> &GetCompiledChannels();
+
+		unsigned int GetCompileVersion() const;
 	};
 
 }
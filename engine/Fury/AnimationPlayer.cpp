@@ -1,6 +1,9 @@
+#include <cmath>
+
 #include "Fury/MathUtil.h"
 #include "Fury/AnimationClip.h"
 #include "Fury/AnimationPlayer.h"
+#include "Fury/AnimationUtil.h"
 #include "Fury/Log.h"
 #include "Fury/Joint.h"
 #include "Fury/Mesh.h"
@@ -8,6 +11,7 @@
 #include "Fury/Quaternion.h"
 #include "Fury/SceneNode.h"
 #include "Fury/MeshRender.h"
+#include "Fury/Skeleton.h"
 
 namespace fury
 {
@@ -55,162 +59,267 @@ namespace fury
 		AdvanceTime(dt);
 	}
 
-	void AnimationPlayer::AdvanceTime(float dt)
+	std::shared_ptr<Skeleton> AnimationPlayer::Prepare()
 	{
 		if (m_SceneNode.expired() || m_AnimClip.expired())
 		{
 			FURYW << "Node or AnimClip empty!";
-			return;
+			return nullptr;
 		}
 
 		auto clip = m_AnimClip.lock();
-		auto node = m_SceneNode.lock();
-		auto mesh = node->GetComponent<MeshRender>()->GetMesh();
+		auto skeleton = GetSkeleton(m_SceneNode.lock());
+		if (skeleton == nullptr)
+			return nullptr;
 
-		m_Time += dt;
+		bool force = m_BoundSkeleton.lock() != skeleton;
+		m_BoundSkeleton = skeleton;
+
+		Bind(m_Binding, clip, skeleton, force);
+
+		if (auto fadeClip = m_FadeClip.lock())
+			Bind(m_FadeBinding, fadeClip, skeleton, force);
 
-		float current = 0.0f, ratio = 0.0f, duration = 0.0f;
+		for (auto &layer : m_Layers)
+		{
+			auto layerClip = layer.clip.lock();
+			if (layerClip == nullptr || !Bind(layer.binding, layerClip, skeleton, force) || !layer.additive)
+				continue;
+
+			// reference pose only changes with the binding.
+			layer.reference.resize(skeleton->GetJointCount());
+
+			PoseBuffer reference;
+			reference.poses = layer.reference.data();
+			reference.count = layer.reference.size();
+
+			skeleton->GetBindPose(reference);
+			AnimationUtil::SamplePose(layerClip->GetCompiledChannels(), layer.binding.joints.data(), layer.binding.cursors.data(), 0.0f, reference);
+		}
 
-		current = m_Time * clip->GetTicksPerSecond() * m_Speed;
-		duration = clip->GetDuration() * clip->GetTicksPerSecond();
+		return skeleton;
+	}
+
+	void AnimationPlayer::AdvanceTime(float dt)
+	{
+		if (auto skeleton = Prepare())
+			Sample(skeleton, dt);
+	}
+
+	void AnimationPlayer::Sample(const std::shared_ptr<Skeleton> &skeleton, float dt)
+	{
+		auto clip = m_AnimClip.lock();
+		if (clip == nullptr || m_Binding.channels == nullptr)
+			return;
+
+		m_Time += dt;
 
-		if (!clip->GetLoop() && current > duration)
+		float tick;
+		if (!GetTick(clip, m_Time, tick))
 			return;
 
-		while (current > duration)
-			current -= duration;
+		// dt 0 resets old and new TRS, otherwise new TRS becomes the old one.
+		bool reset = dt == 0.0f;
 
-		auto ApplyAnim = [&](std::vector<KeyFrame> &frames, Vector4 &output)
+		auto fadeClip = m_FadeClip.lock();
+		if (fadeClip != nullptr)
 		{
-			auto count = frames.size();
-			if (count < 1)
-				return;
+			m_FadeTime += dt;
+			m_FadeElapsed += dt;
 
-			if (count == 1)
+			if (m_FadeElapsed >= m_FadeDuration)
 			{
-				auto frame = frames[0];
-				output.x = frame.x;
-				output.y = frame.y;
-				output.z = frame.z;
+				m_FadeClip.reset();
+				fadeClip = nullptr;
 			}
-			else
+		}
+
+		m_PoseArena.Reset();
+
+		unsigned int jointCount = skeleton->GetJointCount();
+		PoseBuffer pose = m_PoseArena.Allocate(jointCount);
+
+		const auto &channels = *m_Binding.channels;
+
+		// a lone clip only poses the joints it animates, the rest keep their bind matrix.
+		if (fadeClip == nullptr && m_Layers.empty())
+		{
+			AnimationUtil::SamplePose(channels, m_Binding.joints.data(), m_Binding.cursors.data(), tick, pose);
+
+			for (auto joint : m_Binding.joints)
 			{
-				auto it = frames.begin();
-				while (true)
-				{
-					if (it == frames.end())
-						break;
-
-					auto &first = *it++;
-					auto &second = *it;
-
-					if (first.tick <= current && second.tick >= current)
-					{
-						ratio = (current - first.tick) / (second.tick - first.tick);
-						auto v0 = Vector4(first.x, first.y, first.z);
-						auto v1 = Vector4(second.x, second.y, second.z);
-						output = v0 + (v1 - v0) * ratio;
-						break;
-					}
-				}
+				if (joint >= 0)
+					skeleton->SetPose(joint, pose.poses[joint], reset);
 			}
-		};
 
-		// apply animation to joint's local transforms
-		auto channelCount = clip->GetChannelCount();
-		for (int i = 0; i < channelCount; i++)
+			return;
+		}
+
+		skeleton->GetBindPose(pose);
+		AnimationUtil::SamplePose(channels, m_Binding.joints.data(), m_Binding.cursors.data(), tick, pose);
+
+		if (fadeClip != nullptr && m_FadeBinding.channels != nullptr)
 		{
-			auto channel = clip->GetChannelAt(i);
-			auto joint = mesh->GetJoint(channel->name);
-			if (joint == nullptr)
+			PoseBuffer from = m_PoseArena.Allocate(jointCount);
+			skeleton->GetBindPose(from);
+
+			float fadeTick;
+			GetTick(fadeClip, m_FadeTime, fadeTick);
+			AnimationUtil::SamplePose(*m_FadeBinding.channels, m_FadeBinding.joints.data(), m_FadeBinding.cursors.data(), fadeTick, from);
+
+			AnimationUtil::BlendPoses(from, pose, m_FadeElapsed / m_FadeDuration, nullptr, pose);
+		}
+
+		for (auto &layer : m_Layers)
+		{
+			auto layerClip = layer.clip.lock();
+			if (layerClip == nullptr || layer.binding.channels == nullptr)
 				continue;
 
-			auto rotCount = channel->rotations.size();
-			Vector4 position, scaling(1, 1), rotation;
-			Quaternion quatRotation;
-			
-			if (rotCount > 0)
-			{
-				if (rotCount == 1)
-				{
-					auto frame = channel->rotations[0];
-					rotation.x = frame.x;
-					rotation.y = frame.y;
-					rotation.z = frame.z;
-					quatRotation = MathUtil::EulerRadToQuat(rotation);
-				}
-				else
-				{
-					auto it = channel->rotations.begin();
-					while (true)
-					{
-						if (it == channel->rotations.end())
-							break;
-
-						auto &first = *it++;
-						auto &second = *it;
-
-						if (first.tick <= current && second.tick >= current)
-						{
-							ratio = (current - first.tick) / (second.tick - first.tick);
-							auto q0 = MathUtil::EulerRadToQuat(Vector4(first.x, first.y, first.z));
-							auto q1 = MathUtil::EulerRadToQuat(Vector4(second.x, second.y, second.z));
-							quatRotation = q0.Slerp(q1, ratio);
-							break;
-						}
-					}
-				}
-			}
+			layer.time += dt;
+			if (layer.weight <= 0.0f)
+				continue;
+
+			PoseBuffer layerPose = m_PoseArena.Allocate(jointCount);
+			skeleton->GetBindPose(layerPose);
 
-			ApplyAnim(channel->positions, position);
-			ApplyAnim(channel->scalings, scaling);
+			float layerTick;
+			GetTick(layerClip, layer.time, layerTick);
+			AnimationUtil::SamplePose(*layer.binding.channels, layer.binding.joints.data(), layer.binding.cursors.data(), layerTick, layerPose);
 
-			if (dt == 0.0f)
+			const float *mask = !layer.mask.empty() && layer.mask.size() >= jointCount ? layer.mask.data() : nullptr;
+
+			if (layer.additive && layer.reference.size() == jointCount)
 			{
-				// reset old and new TRS
-				joint->SetPosition(position, true);
-				joint->SetRotation(quatRotation, true);
-				joint->SetScaling(scaling, true);
+				PoseBuffer reference;
+				reference.poses = layer.reference.data();
+				reference.count = jointCount;
+
+				AnimationUtil::AddPoses(pose, layerPose, reference, layer.weight, mask, pose);
 			}
 			else
 			{
-				// copy new TRS to old TRS
-				joint->SetPosition(joint->GetPosition(), true);
-				joint->SetRotation(joint->GetRotation(), true);
-				joint->SetScaling(joint->GetScaling(), true);
+				AnimationUtil::BlendPoses(pose, layerPose, layer.weight, mask, pose);
 			}
-
-			// assign new TRS values
-			joint->SetPosition(position, false);
-			joint->SetRotation(quatRotation, false);
-			joint->SetScaling(scaling, false);
 		}
+
+		skeleton->SetPose(pose, reset);
 	}
 
 	void AnimationPlayer::Display(float dt)
 	{
-		if (m_SceneNode.expired() || m_AnimClip.expired())
+		if (auto skeleton = Prepare())
+			skeleton->Update(dt);
+	}
+
+	std::shared_ptr<Skeleton> AnimationPlayer::GetSkeleton(const std::shared_ptr<SceneNode> &node) const
+	{
+		if (auto skeleton = node->GetComponent<Skeleton>())
+			return skeleton;
+
+		auto render = node->GetComponent<MeshRender>();
+		auto mesh = render != nullptr ? render->GetMesh() : nullptr;
+		if (mesh == nullptr || !mesh->IsSkinnedMesh())
 		{
-			FURYW << "Node or AnimClip empty.";
-			return;
+			FURYW << node->GetName() << " has no skinned mesh!";
+			return nullptr;
 		}
 
-		auto clip = m_AnimClip.lock();
-		auto node = m_SceneNode.lock();
-		auto mesh = node->GetComponent<MeshRender>()->GetMesh();
+		// first time this node animates, give it it's own pose.
+		auto skeleton = Skeleton::Create(mesh);
+		node->AddComponent(skeleton);
+		return skeleton;
+	}
 
-		auto channelCount = clip->GetChannelCount();
-		for (int i = 0; i < channelCount; i++)
+	void AnimationPlayer::CrossFade(const std::shared_ptr<AnimationClip> &clip, float duration)
+	{
+		auto current = m_AnimClip.lock();
+		if (current != nullptr && current != clip && duration > 0.0f)
 		{
-			auto channel = clip->GetChannelAt(i);
-			auto joint = mesh->GetJoint(channel->name);
-			if (joint == nullptr)
-				continue;
+			// old binding keeps its cursors, the new clip rebinds in Prepare.
+			std::swap(m_FadeBinding, m_Binding);
+			m_FadeClip = current;
+			m_FadeTime = m_Time;
+			m_FadeElapsed = 0.0f;
+			m_FadeDuration = duration;
+		}
+		else
+		{
+			m_FadeClip.reset();
+		}
+
+		m_AnimClip = clip;
+		m_Time = 0.0f;
+	}
+
+	unsigned int AnimationPlayer::AddLayer(const std::shared_ptr<AnimationClip> &clip, float weight, bool additive, const std::vector<float> &mask)
+	{
+		AnimationLayer layer;
+		layer.clip = clip;
+		layer.weight = weight;
+		layer.additive = additive;
+		layer.mask = mask;
+
+		m_Layers.push_back(std::move(layer));
+		return m_Layers.size() - 1;
+	}
+
+	void AnimationPlayer::RemoveLayer(unsigned int index)
+	{
+		if (index < m_Layers.size())
+			m_Layers.erase(m_Layers.begin() + index);
+	}
+
+	unsigned int AnimationPlayer::GetLayerCount() const
+	{
+		return m_Layers.size();
+	}
+
+	void AnimationPlayer::SetLayerWeight(unsigned int index, float weight)
+	{
+		if (index < m_Layers.size())
+			m_Layers[index].weight = weight;
+	}
+
+	float AnimationPlayer::GetLayerWeight(unsigned int index) const
+	{
+		return index < m_Layers.size() ? m_Layers[index].weight : 0.0f;
+	}
 
-			joint->Update(dt);
+	bool AnimationPlayer::Bind(ClipBinding &binding, const std::shared_ptr<AnimationClip> &clip, const std::shared_ptr<Skeleton> &skeleton, bool force)
+	{
+		const auto &channels = clip->GetCompiledChannels();
+		binding.channels = &channels;
+
+		if (!force && binding.clip.lock() == clip && binding.version == clip->GetCompileVersion())
+			return false;
+
+		binding.clip = clip;
+		binding.version = clip->GetCompileVersion();
+
+		binding.joints.resize(channels.size());
+		binding.cursors.assign(channels.size() * 3, 0);
+
+		for (unsigned int i = 0; i < channels.size(); i++)
+			binding.joints[i] = skeleton->GetJointIndex(channels[i].hashCode);
+
+		return true;
+	}
+
+	bool AnimationPlayer::GetTick(const std::shared_ptr<AnimationClip> &clip, float time, float &tick) const
+	{
+		tick = time * clip->GetTicksPerSecond() * m_Speed;
+		float duration = clip->GetDuration() * clip->GetTicksPerSecond();
+
+		if (!clip->GetLoop() && tick > duration)
+		{
+			tick = duration;
+			return false;
 		}
 
-		// update joint tree
-		mesh->GetRootJoint()->Update(Matrix4());
+		if (duration > 0.0f && tick > duration)
+			tick = std::fmod(tick, duration);
+
+		return true;
 	}
 }
\ No newline at end of file
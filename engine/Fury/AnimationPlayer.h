@@ -1,24 +1,72 @@
 #ifndef _FURY_ANIMATION_PLAYER_H_
 #define _FURY_ANIMATION_PLAYER_H_
 
+#include <vector>
+
 #include "Fury/Entity.h"
+#include "Fury/PoseBuffer.h"
 
 namespace fury
 {
 	class AnimationClip;
 
+	struct CompiledChannel;
+
 	class SceneNode;
 
+	class Skeleton;
+
+	// Samples a clip into the node's Skeleton, adding one if the node has none.
+	// Nodes sharing a skinned mesh each get their own pose.
+	// Layers and cross fades sample into pose buffers from a per player arena, blend them, then set the skeleton once.
 	class FURY_API AnimationPlayer : public Entity
 	{
 	public:
 
+		friend class AnimationSystem;
+
 		typedef std::shared_ptr<AnimationPlayer> Ptr;
 
 		static Ptr Create(const std::string &name, float speed = 1.0f);
 
 	protected:
 
+		// channel to joint bindings of a clip, rebuilt when the clip recompiles or skeleton changes.
+		struct ClipBinding
+		{
+			std::weak_ptr<AnimationClip> clip;
+
+			unsigned int version = 0;
+
+			// clip's compiled channels, set by every Bind so sampling never compiles.
+			const std::vector<CompiledChannel> *channels = nullptr;
+
+			// skeleton joint index of each compiled channel, -1 if skeleton doesn't have it.
+			std::vector<int> joints;
+
+			// last key of position, rotation and scaling track of each channel.
+			std::vector<unsigned int> cursors;
+		};
+
+		struct AnimationLayer
+		{
+			std::weak_ptr<AnimationClip> clip;
+
+			ClipBinding binding;
+
+			float time = 0.0f;
+
+			float weight = 1.0f;
+
+			bool additive = false;
+
+			// weight of each skeleton joint, empty for all joints.
+			std::vector<float> mask;
+
+			// clip's first key, additive layers add their difference from it.
+			std::vector<Skeleton::JointPose> reference;
+		};
+
 		std::weak_ptr<SceneNode> m_SceneNode;
 
 		std::weak_ptr<AnimationClip> m_AnimClip;
@@ -27,10 +75,34 @@ namespace fury
 
 		float m_Time = 0.0f;
 
+		std::weak_ptr<Skeleton> m_BoundSkeleton;
+
+		ClipBinding m_Binding;
+
+		std::vector<AnimationLayer> m_Layers;
+
+		// clip CrossFade fades out from.
+		std::weak_ptr<AnimationClip> m_FadeClip;
+
+		ClipBinding m_FadeBinding;
+
+		float m_FadeTime = 0.0f;
+
+		float m_FadeElapsed = 0.0f;
+
+		float m_FadeDuration = 0.0f;
+
+		// temporary poses of AdvanceTime, reset every call.
+		PoseArena m_PoseArena;
+
 	public:
 
 		AnimationPlayer(const std::string &name, float speed = 1.0f);
 
+		// adds the node's Skeleton if missing, compiles the clip and binds channels to joints.
+		// AdvanceTime and Display call this, AnimationSystem calls it on main thread before updating players in parallel.
+		std::shared_ptr<Skeleton> Prepare();
+
 		void SetSpeed(float speed);
 
 		float GetSpeed() const;
@@ -48,6 +120,37 @@ namespace fury
 
 		// 0 - 1, this interpolates the result from advanceTime call.
 		void Display(float dt);
+
+		// plays clip from start, blending from the current clip over duration seconds.
+		// a fade in progress is replaced.
+		void CrossFade(const std::shared_ptr<AnimationClip> &clip, float duration);
+
+		// blends clip over the base clip by weight, and by mask's weight of each joint if given, see Skeleton::GetJointMask.
+		// additive layers add clip's difference from its first key instead of blending towards it.
+		unsigned int AddLayer(const std::shared_ptr<AnimationClip> &clip, float weight = 1.0f, bool additive = false, 
+			const std::vector<float> &mask = std::vector<float>());
+
+		void RemoveLayer(unsigned int index);
+
+		unsigned int GetLayerCount() const;
+
+		void SetLayerWeight(unsigned int index, float weight);
+
+		float GetLayerWeight(unsigned int index) const;
+
+	protected:
+
+		std::shared_ptr<Skeleton> GetSkeleton(const std::shared_ptr<SceneNode> &node) const;
+
+		// advances time by dt and poses skeleton, which must come from Prepare.
+		// only reads prepared bindings, so AnimationSystem runs it on workers.
+		void Sample(const std::shared_ptr<Skeleton> &skeleton, float dt);
+
+		// true if binding was rebuilt.
+		bool Bind(ClipBinding &binding, const std::shared_ptr<AnimationClip> &clip, const std::shared_ptr<Skeleton> &skeleton, bool force);
+
+		// clip's tick at time, false if a non looping clip has ended, tick is then its last one.
+		bool GetTick(const std::shared_ptr<AnimationClip> &clip, float time, float &tick) const;
 	};
 }
 
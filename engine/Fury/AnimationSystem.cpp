@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "Fury/AnimationPlayer.h"
+#include "Fury/AnimationSystem.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Log.h"
+#include "Fury/Shader.h"
+#include "Fury/Skeleton.h"
+#include "Fury/StreamBuffer.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	AnimationSystem::AnimationSystem()
+	{
+		m_PaletteStream = StreamBuffer::Create("AnimationPalettes", GL_UNIFORM_BUFFER, 256 * 1024);
+	}
+
+	AnimationSystem::~AnimationSystem()
+	{
+		m_ActiveSkeletons.clear();
+		m_Players.clear();
+	}
+
+	void AnimationSystem::Add(const std::shared_ptr<AnimationPlayer> &player)
+	{
+		for (const auto &ptr : m_Players)
+		{
+			if (ptr.lock() == player)
+				return;
+		}
+
+		m_Players.push_back(player);
+	}
+
+	void AnimationSystem::Remove(const std::shared_ptr<AnimationPlayer> &player)
+	{
+		m_Players.erase(std::remove_if(m_Players.begin(), m_Players.end(),
+			[&](const std::weak_ptr<AnimationPlayer> &ptr) { return ptr.expired() || ptr.lock() == player; }), m_Players.end());
+	}
+
+	unsigned int AnimationSystem::GetPlayerCount() const
+	{
+		return m_Players.size();
+	}
+
+	void AnimationSystem::AdvanceTime(float dt)
+	{
+		Collect();
+
+		ForEachChunk([&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				m_ActivePlayers[i]->Sample(m_ActiveSkeletons[i], dt);
+		});
+
+		m_ActivePlayers.clear();
+		m_ActiveSkeletons.clear();
+	}
+
+	void AnimationSystem::Display(float ratio)
+	{
+		Collect();
+
+		// slots must start at uniform buffer offset alignment, so Shader::BindSkeleton can bind one as the bone block.
+		if (m_PaletteStride == 0)
+		{
+			int alignment = 256;
+			if (glGetIntegerv != nullptr)
+				glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+			size_t bytes = Shader::MAX_JOINT_COUNT * 16 * sizeof(float);
+			alignment = std::max(alignment, (int)sizeof(float));
+			m_PaletteStride = (bytes + alignment - 1) / alignment * alignment / sizeof(float);
+		}
+
+		m_Generation++;
+		m_Palettes.assign(m_ActiveSkeletons.size() * m_PaletteStride, 0.0f);
+
+		for (size_t i = 0; i < m_ActiveSkeletons.size(); i++)
+		{
+			m_ActiveSkeletons[i]->m_PaletteSlot = i;
+			m_ActiveSkeletons[i]->m_PaletteGeneration = m_Generation;
+		}
+
+		ForEachChunk([&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const auto &skeleton = m_ActiveSkeletons[i];
+				skeleton->Update(ratio);
+
+				size_t count = std::min<size_t>(skeleton->GetPaletteSize(), Shader::MAX_JOINT_COUNT) * 16;
+				if (count > 0)
+					std::copy(skeleton->GetPalette(), skeleton->GetPalette() + count, &m_Palettes[i * m_PaletteStride]);
+			}
+		});
+
+		m_ActivePlayers.clear();
+		m_ActiveSkeletons.clear();
+
+		Upload();
+	}
+
+	const std::vector<float> &AnimationSystem::GetPalettes() const
+	{
+		return m_Palettes;
+	}
+
+	size_t AnimationSystem::GetPaletteStride() const
+	{
+		return m_PaletteStride;
+	}
+
+	bool AnimationSystem::GetPaletteRange(const Skeleton &skeleton, unsigned int &buffer, size_t &offset) const
+	{
+		if (m_PaletteBuffer == 0 || skeleton.m_PaletteGeneration != m_Generation)
+			return false;
+
+		buffer = m_PaletteBuffer;
+		offset = m_PaletteOffset + skeleton.m_PaletteSlot * m_PaletteStride * sizeof(float);
+		return true;
+	}
+
+	void AnimationSystem::Collect()
+	{
+		m_ActivePlayers.clear();
+		m_ActiveSkeletons.clear();
+		m_SkeletonSet.clear();
+
+		auto it = m_Players.begin();
+		while (it != m_Players.end())
+		{
+			auto player = it->lock();
+			if (player == nullptr)
+			{
+				it = m_Players.erase(it);
+				continue;
+			}
+
+			// creates skeletons and compiles clips here, workers only read them.
+			// players sharing a skeleton would pose it concurrently, only the first one runs.
+			auto skeleton = player->Prepare();
+			if (skeleton != nullptr)
+			{
+				if (m_SkeletonSet.insert(skeleton.get()).second)
+				{
+					m_ActivePlayers.push_back(player.get());
+					m_ActiveSkeletons.push_back(skeleton);
+				}
+				else
+				{
+					FURYD << player->GetName() << " skipped, it's skeleton is already posed by another player!";
+				}
+			}
+
+			++it;
+		}
+	}
+
+	void AnimationSystem::ForEachChunk(const std::function<void(size_t, size_t)> &fn)
+	{
+		ThreadUtil::ParallelFor(0, m_ActivePlayers.size(), GRAIN_SIZE, fn);
+	}
+
+	void AnimationSystem::Upload()
+	{
+		m_PaletteBuffer = 0;
+
+		// nothing to upload to without a gl context.
+		if (m_Palettes.empty() || glBufferData == nullptr)
+			return;
+
+		m_PaletteOffset = m_PaletteStream->Upload(&m_Palettes[0], m_Palettes.size() * sizeof(float));
+		m_PaletteBuffer = m_PaletteStream->GetID();
+	}
+}
\ No newline at end of file
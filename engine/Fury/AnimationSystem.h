@@ -0,0 +1,97 @@
+#ifndef _FURY_ANIMATION_SYSTEM_H_
+#define _FURY_ANIMATION_SYSTEM_H_
+
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class AnimationPlayer;
+
+	class Skeleton;
+
+	class StreamBuffer;
+
+	// Updates all added AnimationPlayers together, sampling and building poses in parallel on ThreadUtil.
+	// Display packs every skeleton's palette into one buffer, uploaded once per frame,
+	// Shader::BindSkeleton binds a skeleton's range of it instead of uploading per draw.
+	// Players are prepared on the calling thread first, workers only sample bound clips and update skeletons,
+	// so they never touch scene nodes or compile clips. a skeleton is posed by the first player added for it.
+	class FURY_API AnimationSystem final : public Singleton<AnimationSystem>
+	{
+	public:
+
+		typedef std::shared_ptr<AnimationSystem> Ptr;
+
+		// players per job.
+		static const unsigned int GRAIN_SIZE = 8;
+
+	protected:
+
+		std::vector<std::weak_ptr<AnimationPlayer>> m_Players;
+
+		// players and skeletons of current update, valid ones only.
+		std::vector<AnimationPlayer*> m_ActivePlayers;
+
+		std::vector<std::shared_ptr<Skeleton>> m_ActiveSkeletons;
+
+		std::unordered_set<Skeleton*> m_SkeletonSet;
+
+		// palettes of last Display, one slot of m_PaletteStride floats per skeleton.
+		std::vector<float> m_Palettes;
+
+		size_t m_PaletteStride = 0;
+
+		std::shared_ptr<StreamBuffer> m_PaletteStream;
+
+		unsigned int m_PaletteBuffer = 0;
+
+		size_t m_PaletteOffset = 0;
+
+		// increases every Display, skeletons with an older one aren't in the uploaded buffer.
+		unsigned int m_Generation = 0;
+
+	public:
+
+		AnimationSystem();
+
+		~AnimationSystem();
+
+		void Add(const std::shared_ptr<AnimationPlayer> &player);
+
+		void Remove(const std::shared_ptr<AnimationPlayer> &player);
+
+		unsigned int GetPlayerCount() const;
+
+		// AnimationPlayer::AdvanceTime for every player.
+		void AdvanceTime(float dt);
+
+		// AnimationPlayer::Display for every player, then packs and uploads palettes.
+		// call after RenderUtil::BeginFrame and before drawing.
+		void Display(float ratio);
+
+		const std::vector<float> &GetPalettes() const;
+
+		// floats per skeleton in GetPalettes, at least Shader::MAX_JOINT_COUNT matrices.
+		size_t GetPaletteStride() const;
+
+		// buffer and byte offset of skeleton's palette uploaded this frame, false if it has none.
+		bool GetPaletteRange(const Skeleton &skeleton, unsigned int &buffer, size_t &offset) const;
+
+	protected:
+
+		// drops expired players and prepares the rest, fills m_ActivePlayers with one player per skeleton.
+		void Collect();
+
+		// runs fn(begin, end) over m_ActivePlayers, in parallel if ThreadUtil has workers.
+		void ForEachChunk(const std::function<void(size_t, size_t)> &fn);
+
+		void Upload();
+	};
+}
+
+#endif // _FURY_ANIMATION_SYSTEM_H_
\ No newline at end of file
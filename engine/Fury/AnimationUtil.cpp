@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <cmath>
 
 #include "Fury/MathUtil.h"
 #include "Fury/AnimationClip.h"
 #include "Fury/AnimationUtil.h"
 #include "Fury/Log.h"
+#include "Fury/PoseBuffer.h"
 
 namespace fury
 {
@@ -79,6 +81,306 @@ namespace fury
 			}
 		}
 
+		clip->m_CompileDirty = true;
+
 		FURYD << "Before: " << oldCount << " After: " << newCount;
 	}
+
+	bool AnimationUtil::CompressAnimClip(const std::shared_ptr<AnimationClip> &clip, const AnimationCompressOptions &options)
+	{
+		if (clip->IsCompressed())
+			return true;
+
+		// ticks are stored as shorts.
+		for (auto channel : clip->m_Channels)
+		{
+			for (auto frames : { &channel->positions, &channel->rotations, &channel->scalings })
+			{
+				if (!frames->empty() && frames->back().tick > 65535)
+				{
+					FURYW << "AnimationClip " << clip->GetName() << " is too long to compress!";
+					return false;
+				}
+			}
+		}
+
+		// keys as vectors, rotations as quaternions in x, y, z, w.
+		std::vector<Vector4> keys, decoded;
+		std::vector<unsigned short> quantized;
+		std::vector<unsigned int> kept;
+
+		unsigned int oldCount = 0, newCount = 0, constCount = 0;
+
+		auto CompressTrack = [&](const std::vector<KeyFrame> &frames, CompressedTrack &track, bool rotation, float maxError)
+		{
+			unsigned int count = frames.size();
+			if (count == 0)
+				return;
+
+			auto Error = [&](const Vector4 &a, const Vector4 &b) -> float
+			{
+				// angle between unit quaternions from their chord, acos of the dot is too coarse near 1.
+				if (rotation)
+				{
+					float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+					float dx = a.x - b.x * sign, dy = a.y - b.y * sign, dz = a.z - b.z * sign, dw = a.w - b.w * sign;
+					return 4.0f * std::asin(std::min(std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw) * 0.5f, 1.0f));
+				}
+
+				return std::max(std::max(std::abs(a.x - b.x), std::abs(a.y - b.y)), std::abs(a.z - b.z));
+			};
+
+			// Vector4's assignment ignores w, keys are copy constructed to keep it.
+			keys.clear();
+			for (const auto &frame : frames)
+			{
+				if (rotation)
+				{
+					Quaternion q = MathUtil::EulerRadToQuat(Vector4(frame.x, frame.y, frame.z));
+					keys.push_back(Vector4(q.x, q.y, q.z, q.w));
+				}
+				else
+				{
+					keys.push_back(Vector4(frame.x, frame.y, frame.z, 0.0f));
+				}
+			}
+
+			oldCount += count;
+
+			// constant tracks keep first and last tick, and first key at full precision.
+			bool constant = true;
+			for (unsigned int i = 1; i < count && constant; i++)
+				constant = Error(keys[i], keys[0]) <= maxError;
+
+			if (constant)
+			{
+				track.ticks.push_back(frames[0].tick);
+				if (count > 1)
+					track.ticks.push_back(frames[count - 1].tick);
+
+				track.min = keys[0];
+				track.min.w = keys[0].w;
+				track.extent = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+				newCount++;
+				constCount++;
+				return;
+			}
+
+			track.min = track.extent = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+			if (!rotation)
+			{
+				Vector4 max = keys[0];
+				track.min = keys[0];
+				for (unsigned int i = 1; i < count; i++)
+				{
+					track.min = Vector4(std::min(track.min.x, keys[i].x), std::min(track.min.y, keys[i].y), std::min(track.min.z, keys[i].z), 0.0f);
+					max = Vector4(std::max(max.x, keys[i].x), std::max(max.y, keys[i].y), std::max(max.z, keys[i].z), 0.0f);
+				}
+				track.extent = Vector4(max.x - track.min.x, max.y - track.min.y, max.z - track.min.z, 0.0f);
+			}
+
+			// reduce against quantized keys, so error covers both.
+			quantized.resize(count * 3);
+			decoded.clear();
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned short *output = &quantized[i * 3];
+				if (rotation)
+				{
+					CompressedTrack::EncodeQuat(Quaternion(keys[i].x, keys[i].y, keys[i].z, keys[i].w), output);
+					Quaternion q = CompressedTrack::DecodeQuat(output);
+					decoded.push_back(Vector4(q.x, q.y, q.z, q.w));
+				}
+				else
+				{
+					CompressedTrack::EncodeVector(keys[i], track.min, track.extent, output);
+					decoded.push_back(CompressedTrack::DecodeVector(output, track.min, track.extent));
+				}
+			}
+
+			// same interpolation as AnimationTrack::Sample.
+			auto Interpolate = [&](unsigned int from, unsigned int to, unsigned int index) -> Vector4
+			{
+				unsigned int span = frames[to].tick - frames[from].tick;
+				float ratio = span > 0 ? (float)(frames[index].tick - frames[from].tick) / span : 0.0f;
+
+				const Vector4 &a = decoded[from];
+				const Vector4 &b = decoded[to];
+				if (rotation)
+				{
+					Quaternion q = Quaternion(a.x, a.y, a.z, a.w).Slerp(Quaternion(b.x, b.y, b.z, b.w), ratio);
+					q.Normalize();
+					return Vector4(q.x, q.y, q.z, q.w);
+				}
+
+				return Vector4(a.x + (b.x - a.x) * ratio, a.y + (b.y - a.y) * ratio, a.z + (b.z - a.z) * ratio, 0.0f);
+			};
+
+			// grow a segment from last kept key until it can't rebuild the keys it skips,
+			// then keep the key before the one that broke it.
+			kept.clear();
+			kept.push_back(0);
+
+			unsigned int anchor = 0;
+			for (unsigned int end = 2; end < count; end++)
+			{
+				for (unsigned int i = anchor + 1; i < end; i++)
+				{
+					if (Error(Interpolate(anchor, end, i), keys[i]) > maxError)
+					{
+						anchor = end - 1;
+						kept.push_back(anchor);
+						break;
+					}
+				}
+			}
+
+			kept.push_back(count - 1);
+
+			for (auto index : kept)
+			{
+				track.ticks.push_back(frames[index].tick);
+				track.values.insert(track.values.end(), &quantized[index * 3], &quantized[index * 3] + 3);
+			}
+
+			newCount += kept.size();
+		};
+
+		size_t oldSize = 0, newSize = 0;
+
+		std::vector<CompressedChannel> channels(clip->m_Channels.size());
+		for (unsigned int i = 0; i < channels.size(); i++)
+		{
+			const auto &channel = clip->m_Channels[i];
+			auto &compressed = channels[i];
+
+			compressed.name = channel->name;
+			CompressTrack(channel->positions, compressed.positions, false, options.PositionError);
+			CompressTrack(channel->rotations, compressed.rotations, true, options.RotationError);
+			CompressTrack(channel->scalings, compressed.scalings, false, options.ScalingError);
+
+			oldSize += (channel->positions.size() + channel->rotations.size() + channel->scalings.size()) * sizeof(KeyFrame);
+			newSize += compressed.positions.GetMemorySize() + compressed.rotations.GetMemorySize() + compressed.scalings.GetMemorySize();
+		}
+
+		clip->m_Channels.clear();
+		clip->m_CompressedChannels = std::move(channels);
+		clip->m_CompileDirty = true;
+
+		FURYD << "AnimationClip " << clip->GetName() << " compressed, keys: " << oldCount << " -> " << newCount << " (" << constCount << " constant tracks)"
+			<< ", bytes: " << oldSize << " -> " << newSize << ", ratio: " << (newSize > 0 ? (float)oldSize / newSize : 0.0f);
+
+		return true;
+	}
+
+	void AnimationUtil::DecompressAnimClip(const std::shared_ptr<AnimationClip> &clip)
+	{
+		if (!clip->IsCompressed())
+			return;
+
+		auto DecompressTrack = [](const CompressedTrack &track, std::vector<KeyFrame> &frames, bool rotation)
+		{
+			for (unsigned int i = 0; i < track.ticks.size(); i++)
+			{
+				Vector4 key = track.GetKey(i, rotation);
+
+				// keyframes store euler radians.
+				if (rotation)
+					key = MathUtil::QuatToEulerRad(Quaternion(key.x, key.y, key.z, key.w));
+
+				frames.push_back(KeyFrame(track.ticks[i], key.x, key.y, key.z));
+			}
+		};
+
+		clip->m_Channels.clear();
+		for (const auto &compressed : clip->m_CompressedChannels)
+		{
+			auto channel = clip->AddChannel(compressed.name);
+			DecompressTrack(compressed.positions, channel->positions, false);
+			DecompressTrack(compressed.rotations, channel->rotations, true);
+			DecompressTrack(compressed.scalings, channel->scalings, false);
+		}
+
+		clip->m_CompressedChannels.clear();
+		clip->m_CompileDirty = true;
+	}
+
+	void AnimationUtil::SamplePose(const std::vector<CompiledChannel> &channels, const int *joints, unsigned int *cursors, 
+		float tick, PoseBuffer &pose)
+	{
+		for (unsigned int i = 0; i < channels.size(); i++)
+		{
+			int joint = joints[i];
+			if (joint < 0 || (unsigned int)joint >= pose.count)
+				continue;
+
+			const auto &channel = channels[i];
+			unsigned int *channelCursors = &cursors[i * 3];
+
+			Skeleton::JointPose sampled;
+			float value[4];
+
+			if (channel.positions.Sample(tick, channelCursors[0], value))
+				sampled.position = Vector4(value[0], value[1], value[2]);
+
+			if (channel.rotations.Sample(tick, channelCursors[1], value))
+				sampled.rotation = Quaternion(value[0], value[1], value[2], value[3]);
+
+			if (channel.scalings.Sample(tick, channelCursors[2], value))
+				sampled.scaling = Vector4(value[0], value[1], value[2]);
+
+			pose.poses[joint] = sampled;
+		}
+	}
+
+	void AnimationUtil::BlendPoses(const PoseBuffer &from, const PoseBuffer &to, float weight, const float *mask, PoseBuffer &output)
+	{
+		unsigned int count = std::min(std::min(from.count, to.count), output.count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto &a = from.poses[i];
+			const auto &b = to.poses[i];
+			float t = mask != nullptr ? weight * mask[i] : weight;
+
+			// output may alias an input, so build the pose first.
+			Skeleton::JointPose blended;
+			blended.position = a.position + (b.position - a.position) * t;
+			blended.rotation = a.rotation.Slerp(b.rotation, t);
+			blended.scaling = a.scaling + (b.scaling - a.scaling) * t;
+
+			output.poses[i] = blended;
+		}
+	}
+
+	void AnimationUtil::AddPoses(const PoseBuffer &base, const PoseBuffer &additive, const PoseBuffer &reference, 
+		float weight, const float *mask, PoseBuffer &output)
+	{
+		auto Ratio = [](float value, float reference) -> float
+		{
+			return reference != 0.0f ? value / reference : 1.0f;
+		};
+
+		unsigned int count = std::min(std::min(std::min(base.count, additive.count), reference.count), output.count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto &a = base.poses[i];
+			const auto &add = additive.poses[i];
+			const auto &ref = reference.poses[i];
+			float t = mask != nullptr ? weight * mask[i] : weight;
+
+			// additive = reference * delta in joint space, apply the scaled delta after base.
+			Quaternion delta = Quaternion().Slerp(ref.rotation.Conjugate() * add.rotation, t);
+
+			Skeleton::JointPose added;
+			added.position = a.position + (add.position - ref.position) * t;
+			added.rotation = a.rotation * delta;
+			added.scaling = Vector4(
+				a.scaling.x * (1.0f + (Ratio(add.scaling.x, ref.scaling.x) - 1.0f) * t),
+				a.scaling.y * (1.0f + (Ratio(add.scaling.y, ref.scaling.y) - 1.0f) * t),
+				a.scaling.z * (1.0f + (Ratio(add.scaling.z, ref.scaling.z) - 1.0f) * t));
+
+			output.poses[i] = added;
+		}
+	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _FURY_ANIMATION_UTIL_H_
 
 #include <memory>
+#include <vector>
 
 #include "Macros.h"
 
@@ -9,11 +10,49 @@ namespace fury
 {
 	class AnimationClip;
 
+	struct CompiledChannel;
+
+	struct PoseBuffer;
+
+	// max error of compressed keys, positions and scalings in units, rotations in radians.
+	struct AnimationCompressOptions
+	{
+	public:
+
+		float PositionError = 0.001f;
+
+		float RotationError = 0.001f;
+
+		float ScalingError = 0.001f;
+	};
+
 	class FURY_API AnimationUtil final
 	{
 	public:
 
 		static void OptimizeAnimClip(const std::shared_ptr<AnimationClip> &clip, float quality = 0.5f);
+
+		// drops keys linear interpolation can rebuild within error, quantizes the rest and detects constant tracks.
+		// raw channels are replaced by compressed ones, false if clip is longer than 65535 ticks.
+		static bool CompressAnimClip(const std::shared_ptr<AnimationClip> &clip, 
+			const AnimationCompressOptions &options = AnimationCompressOptions());
+
+		// rebuilds raw channels from compressed ones, so the clip can be edited again.
+		static void DecompressAnimClip(const std::shared_ptr<AnimationClip> &clip);
+
+		// samples channels at tick into pose. joints holds each channel's skeleton joint index, -1 to skip,
+		// cursors 3 per channel, see AnimationTrack::FindKey. a channel's missing tracks sample as JointPose's defaults.
+		static void SamplePose(const std::vector<CompiledChannel> &channels, const int *joints, unsigned int *cursors, 
+			float tick, PoseBuffer &pose);
+
+		// output = from to to by weight, times mask's weight of each joint if mask isn't null.
+		// output may be from or to.
+		static void BlendPoses(const PoseBuffer &from, const PoseBuffer &to, float weight, const float *mask, PoseBuffer &output);
+
+		// output = base plus additive's difference from reference, scaled by weight and mask.
+		// output may be base.
+		static void AddPoses(const PoseBuffer &base, const PoseBuffer &additive, const PoseBuffer &reference, 
+			float weight, const float *mask, PoseBuffer &output);
 	};
 }
 
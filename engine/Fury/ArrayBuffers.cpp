@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Fury/ArrayBuffers.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
@@ -28,17 +30,42 @@ namespace fury
 	template<class DataType>
 	void ArrayBuffer<DataType>::UpdateBuffer()
 	{
-		int sizeNew = Data.size();
-		bool sizeChanged = false;
+		unsigned int sizeNew = Data.size();
+		bool sizeChanged = sizeNew != m_SizeOld;
 		bool isNewBuffer = false;
 
-		if (sizeNew != m_SizeOld)
+		if (!m_DirtyRanges.empty())
 		{
-			m_SizeOld = sizeNew;
-			sizeChanged = true;
+			if (!m_Dirty && !sizeChanged && m_ID != 0 && !GetStreaming() && !IsFullUploadCheaper())
+			{
+				glBindBuffer(m_BufferTarget, m_ID);
+
+				const char *data = (const char*)Data.data();
+				for (const auto &range : m_DirtyRanges)
+					glBufferSubData(m_BufferTarget, range.first, range.second - range.first, data + range.first);
+
+				glBindBuffer(m_BufferTarget, 0);
+
+				m_DirtyRanges.clear();
+				return;
+			}
+
+			m_Dirty = true;
+			m_DirtyRanges.clear();
 		}
 
-		if (m_Dirty && sizeNew > 0)
+		if (m_Dirty && sizeNew > 0 && GetStreaming())
+		{
+			m_Dirty = false;
+
+			if (m_Stream == nullptr)
+				m_Stream = StreamBuffer::Create(Name, m_BufferTarget, sizeNew * sizeof(DataType));
+
+			// each upload is a fresh copy in this frame's region, older copies may still be in use.
+			m_Offset = m_Stream->Upload(Data.data(), sizeNew * sizeof(DataType), sizeof(DataType));
+			m_ID = m_Stream->GetID();
+		}
+		else if (m_Dirty && sizeNew > 0)
 		{
 			m_Dirty = false;
 
@@ -50,8 +77,12 @@ namespace fury
 
 			glBindBuffer(m_BufferTarget, m_ID);
 
+			// m_SizeOld is the size of gl storage, only a glBufferData changes it.
 			if (sizeChanged || isNewBuffer)
+			{
 				glBufferData(m_BufferTarget, sizeNew * sizeof(DataType), Data.data(), m_BufferUsage);
+				m_SizeOld = sizeNew;
+			}
 			else
 				glBufferSubData(m_BufferTarget, 0, sizeNew * sizeof(DataType), Data.data());
 
@@ -64,9 +95,65 @@ namespace fury
 	{
 		m_Dirty = true;
 		
-		if (m_ID != 0)
+		if (m_Stream != nullptr)
+			m_Stream = nullptr;
+		else if (m_ID != 0)
 			glDeleteBuffers(1, &m_ID);
 		m_ID = 0;
+		m_Offset = 0;
+		m_SizeOld = 0;
+		m_DirtyRanges.clear();
+	}
+
+	template<class DataType>
+	void ArrayBuffer<DataType>::MarkDirty(size_t offset, size_t count)
+	{
+		if (count == 0)
+			return;
+
+		size_t begin = offset * sizeof(DataType);
+		size_t end = (offset + count) * sizeof(DataType);
+
+		// first range ending at or after begin, ranges before it can't touch the new one.
+		auto first = std::lower_bound(m_DirtyRanges.begin(), m_DirtyRanges.end(), begin,
+			[](const std::pair<size_t, size_t> &range, size_t value) { return range.second < value; });
+
+		// merge all ranges overlapping or adjacent to [begin, end).
+		auto last = first;
+		while (last != m_DirtyRanges.end() && last->first <= end)
+		{
+			begin = std::min(begin, last->first);
+			end = std::max(end, last->second);
+			++last;
+		}
+
+		first = m_DirtyRanges.erase(first, last);
+		m_DirtyRanges.insert(first, std::make_pair(begin, end));
+	}
+
+	template<class DataType>
+	bool ArrayBuffer<DataType>::HasDirtyRanges() const
+	{
+		return !m_DirtyRanges.empty();
+	}
+
+	template<class DataType>
+	bool ArrayBuffer<DataType>::IsFullUploadCheaper() const
+	{
+		if (m_DirtyRanges.size() > MAX_DIRTY_RANGES)
+			return true;
+
+		size_t dirtySize = 0;
+		for (const auto &range : m_DirtyRanges)
+		{
+			// ranges past the end of Data, upload everything.
+			if (range.second > Data.size() * sizeof(DataType))
+				return true;
+
+			dirtySize += range.second - range.first;
+		}
+
+		return dirtySize * 100 > Data.size() * sizeof(DataType) * FULL_UPLOAD_PERCENT;
 	}
 
 	template<class DataType>
@@ -75,19 +162,34 @@ namespace fury
 		return m_ID;
 	}
 
+	template<class DataType>
+	size_t ArrayBuffer<DataType>::GetOffset() const
+	{
+		return m_Offset;
+	}
+
 	template<class DataType>
 	void ArrayBuffer<DataType>::SetBufferUsage(unsigned int usage)
 	{
 		if (m_BufferUsage != usage)
 		{
 			DeleteBuffer();
+			m_BufferUsage = usage;
 			UpdateBuffer();
 		}
 	}
 
+	template<class DataType>
+	bool ArrayBuffer<DataType>::GetStreaming() const
+	{
+		return m_BufferTarget == GL_ARRAY_BUFFER && (m_BufferUsage == GL_STREAM_DRAW || m_BufferUsage == GL_DYNAMIC_DRAW);
+	}
+
 	template class ArrayBuffer<float>;
 
 	template class ArrayBuffer<int>;
 
 	template class ArrayBuffer<unsigned int>;
+
+	template class ArrayBuffer<unsigned char>;
 }
\ No newline at end of file
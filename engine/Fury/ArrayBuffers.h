@@ -2,9 +2,11 @@
 #define _FURY_ARRAYBUFFERS_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Fury/Buffer.h"
+#include "Fury/StreamBuffer.h"
 #include "Fury/Signal.h"
 #include "Fury/TypeComparable.h"
 
@@ -25,8 +27,23 @@ namespace fury
 
 		unsigned int m_BufferUsage;
 
+		// GL_ARRAY_BUFFER with GL_STREAM_DRAW or GL_DYNAMIC_DRAW usage is uploaded to it's own ring.
+		StreamBuffer::Ptr m_Stream;
+
+		// byte offset of Data in buffer GetID().
+		size_t m_Offset = 0;
+
+		// dirty byte ranges [first, second), sorted and merged.
+		std::vector<std::pair<size_t, size_t>> m_DirtyRanges;
+
 	public:
 
+		// past this many dirty ranges, one full upload is cheaper than many small ones.
+		static const unsigned int MAX_DIRTY_RANGES = 32;
+
+		// past this percentage of dirty bytes, the whole buffer is uploaded.
+		static const unsigned int FULL_UPLOAD_PERCENT = 50;
+
 		std::string Name;
 
 		std::vector<DataType> Data;
@@ -37,13 +54,29 @@ namespace fury
 
 		virtual ~ArrayBuffer();
 
+		// uploads whole Data when dirty, otherwise only the ranges passed to MarkDirty.
 		void UpdateBuffer();
 
 		virtual void DeleteBuffer();
 
+		// marks count elements of Data from offset changed, without making the whole buffer dirty.
+		// Data's size must not change, resizing needs SetDirty.
+		void MarkDirty(size_t offset, size_t count);
+
+		bool HasDirtyRanges() const;
+
 		unsigned int GetID() const;
 
+		size_t GetOffset() const;
+
 		void SetBufferUsage(unsigned int usage);
+
+		// true if Data is streamed through a StreamBuffer.
+		bool GetStreaming() const;
+
+	protected:
+
+		bool IsFullUploadCheaper() const;
 	};
 
 	typedef ArrayBuffer<float> ArrayBufferf;
@@ -51,6 +84,8 @@ namespace fury
 	typedef ArrayBuffer<int> ArrayBufferi;
 
 	typedef ArrayBuffer<unsigned int> ArrayBufferui;
+
+	typedef ArrayBuffer<unsigned char> ArrayBufferub;
 }
 
 #endif // _FURY_ARRAYBUFFERS_H_
\ No newline at end of file
@@ -0,0 +1,783 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BVHTree.h"
+#include "Fury/Frustum.h"
+#include "Fury/Log.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	static const unsigned int INVALID_INDEX = 0xffffffff;
+
+	static const int BIN_COUNT = 16;
+
+	// ranges this small always become leaves.
+	static const unsigned int MIN_SPLIT_COUNT = 2;
+
+	// ranges larger than this are always split.
+	static const unsigned int MAX_LEAF_SIZE = 8;
+
+	// ranges larger than this build their childs in parallel.
+	static const unsigned int PARALLEL_COUNT = 4096;
+
+	struct Aabb
+	{
+		float min[3];
+
+		float max[3];
+
+		Aabb()
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = FLT_MAX;
+				max[axis] = -FLT_MAX;
+			}
+		}
+
+		Aabb(const float *minPoint, const float *maxPoint)
+		{
+			std::copy(minPoint, minPoint + 3, min);
+			std::copy(maxPoint, maxPoint + 3, max);
+		}
+
+		void Grow(const float *point)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::min(min[axis], point[axis]);
+				max[axis] = std::max(max[axis], point[axis]);
+			}
+		}
+
+		void Grow(const float *center, const float *extents)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::min(min[axis], center[axis] - extents[axis]);
+				max[axis] = std::max(max[axis], center[axis] + extents[axis]);
+			}
+		}
+
+		void Grow(const Aabb &other)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::min(min[axis], other.min[axis]);
+				max[axis] = std::max(max[axis], other.max[axis]);
+			}
+		}
+
+		float GetArea() const
+		{
+			return SurfaceArea(min, max);
+		}
+
+		static float SurfaceArea(const float *min, const float *max)
+		{
+			float x = max[0] - min[0];
+			float y = max[1] - min[1];
+			float z = max[2] - min[2];
+			if (x < 0.0f || y < 0.0f || z < 0.0f)
+				return 0.0f;
+
+			return 2.0f * (x * y + y * z + z * x);
+		}
+	};
+
+	static BoxBounds ToBoxBounds(const float *min, const float *max)
+	{
+		return BoxBounds(Vector4(min[0], min[1], min[2]), Vector4(max[0], max[1], max[2]));
+	}
+
+	BVHTree::Ptr BVHTree::Create(float rebuildThreshold)
+	{
+		return std::make_shared<BVHTree>(rebuildThreshold);
+	}
+
+	BVHTree::BVHTree(float rebuildThreshold) :
+		m_TypeIndex(typeid(BVHTree)), m_RebuildThreshold(rebuildThreshold), m_PairCount(0), m_NeedBuild(true),
+		m_Cost(0.0), m_BuiltCost(0.0)
+	{
+
+	}
+
+	BVHTree::~BVHTree()
+	{
+		Clear();
+		FURYD << "BVHTree::~BVHTree";
+	}
+
+	std::type_index BVHTree::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	void BVHTree::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->m_SceneManager == this)
+		{
+			UpdateSceneNode(sceneNode);
+			return;
+		}
+
+		if (sceneNode->GetSceneManager() != nullptr)
+			sceneNode->RemoveFromOcTree(false);
+
+		unsigned int prim;
+		if (m_FreePrims.size() > 0)
+		{
+			prim = m_FreePrims.back();
+			m_FreePrims.pop_back();
+		}
+		else
+		{
+			prim = m_SceneNodes.size();
+			m_SceneNodes.push_back(nullptr);
+			m_Centers.resize(m_Centers.size() + 3);
+			m_Extents.resize(m_Extents.size() + 3);
+		}
+
+		m_SceneNodes[prim] = sceneNode;
+		SetBounds(prim, sceneNode->GetWorldAABB());
+
+		sceneNode->m_SceneManager = this;
+		sceneNode->m_SceneManagerProxy = prim;
+
+		m_NeedBuild = true;
+	}
+
+	void BVHTree::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void BVHTree::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->m_SceneManager != this)
+			return;
+
+		// sceneNode may refer to the slot we clear.
+		SceneNode::Ptr node = sceneNode;
+
+		unsigned int prim = node->m_SceneManagerProxy;
+		m_SceneNodes[prim] = nullptr;
+		m_FreePrims.push_back(prim);
+
+		node->m_SceneManager = nullptr;
+		node->m_SceneManagerProxy = INVALID_INDEX;
+
+		// leaves skip removed primitives, so only bounds need to shrink.
+		if (!m_NeedBuild)
+		{
+			std::vector<unsigned int> leaves(1, m_PrimLeaves[prim]);
+			Refit(leaves);
+		}
+	}
+
+	void BVHTree::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		UpdateSceneNodes({ sceneNode });
+	}
+
+	void BVHTree::UpdateSceneNodes(const SceneNodes &sceneNodes)
+	{
+		std::vector<unsigned int> leaves;
+		leaves.reserve(sceneNodes.size());
+
+		for (auto &sceneNode : sceneNodes)
+		{
+			if (sceneNode->m_SceneManager != this)
+			{
+				AddSceneNode(sceneNode);
+				continue;
+			}
+
+			unsigned int prim = sceneNode->m_SceneManagerProxy;
+			SetBounds(prim, sceneNode->GetWorldAABB());
+
+			if (!m_NeedBuild)
+				leaves.push_back(m_PrimLeaves[prim]);
+		}
+
+		if (!m_NeedBuild)
+			Refit(leaves);
+	}
+
+	void BVHTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		BuildIfNeeded();
+
+		if (auto frustum = dynamic_cast<const Frustum*>(&collider))
+		{
+			WalkFrustum(*frustum, filterFunc);
+			return;
+		}
+
+		// node, known to be inside
+		std::vector<std::pair<unsigned int, bool>> stack;
+		stack.push_back(std::make_pair(0u, false));
+
+		while (!stack.empty())
+		{
+			auto entry = stack.back();
+			stack.pop_back();
+
+			const Node &node = m_Nodes[entry.first];
+			if (node.min[0] > node.max[0])
+				continue;
+
+			bool inside = entry.second;
+			if (!inside)
+			{
+				Side side = collider.IsInside(ToBoxBounds(node.min, node.max));
+				if (side == Side::OUT)
+					continue;
+
+				inside = side == Side::IN;
+			}
+
+			if (node.left != 0)
+			{
+				stack.push_back(std::make_pair(node.left + 1, inside));
+				stack.push_back(std::make_pair(node.left, inside));
+				continue;
+			}
+
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				unsigned int prim = m_PrimOrder[i];
+				auto &sceneNode = m_SceneNodes[prim];
+				if (sceneNode == nullptr)
+					continue;
+
+				if (inside)
+				{
+					filterFunc(sceneNode);
+				}
+				else
+				{
+					Vector4 center(m_Centers[prim * 3], m_Centers[prim * 3 + 1], m_Centers[prim * 3 + 2]);
+					Vector4 extents(m_Extents[prim * 3], m_Extents[prim * 3 + 1], m_Extents[prim * 3 + 2]);
+					if (collider.IsInsideFast(BoxBounds(center - extents, center + extents)))
+						filterFunc(sceneNode);
+				}
+			}
+		}
+	}
+
+	void BVHTree::WalkFrustum(const Frustum &frustum, const FilterFunc &filterFunc) const
+	{
+		// node, planes it's parent straddles
+		std::vector<std::pair<unsigned int, unsigned int>> stack;
+		stack.push_back(std::make_pair(0u, Frustum::ALL_PLANES));
+
+		std::vector<float> centers, extents;
+		std::vector<unsigned int> prims;
+		std::vector<uint8_t> visibleMask;
+
+		while (!stack.empty())
+		{
+			auto entry = stack.back();
+			stack.pop_back();
+
+			const Node &node = m_Nodes[entry.first];
+			if (node.min[0] > node.max[0])
+				continue;
+
+			unsigned int planeMask = entry.second;
+			if (planeMask != 0 && frustum.IsInside(ToBoxBounds(node.min, node.max), planeMask) == Side::OUT)
+				continue;
+
+			if (node.left != 0)
+			{
+				stack.push_back(std::make_pair(node.left + 1, planeMask));
+				stack.push_back(std::make_pair(node.left, planeMask));
+				continue;
+			}
+
+			prims.clear();
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				if (m_SceneNodes[m_PrimOrder[i]] != nullptr)
+					prims.push_back(m_PrimOrder[i]);
+			}
+
+			if (planeMask == 0)
+			{
+				for (auto prim : prims)
+					filterFunc(m_SceneNodes[prim]);
+				continue;
+			}
+
+			centers.resize(prims.size() * 3);
+			extents.resize(prims.size() * 3);
+			visibleMask.resize(prims.size());
+
+			for (size_t i = 0; i < prims.size(); i++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					centers[i * 3 + axis] = m_Centers[prims[i] * 3 + axis];
+					extents[i * 3 + axis] = m_Extents[prims[i] * 3 + axis];
+				}
+			}
+
+			frustum.CullAABBs(centers.data(), extents.data(), prims.size(), visibleMask.data(), planeMask);
+
+			for (size_t i = 0; i < prims.size(); i++)
+			{
+				if (visibleMask[i])
+					filterFunc(m_SceneNodes[prims[i]]);
+			}
+		}
+	}
+
+	void BVHTree::Clear()
+	{
+		for (auto &sceneNode : m_SceneNodes)
+		{
+			if (sceneNode != nullptr)
+			{
+				sceneNode->m_SceneManager = nullptr;
+				sceneNode->m_SceneManagerProxy = INVALID_INDEX;
+			}
+		}
+
+		m_SceneNodes.clear();
+		m_Centers.clear();
+		m_Extents.clear();
+		m_FreePrims.clear();
+
+		m_Nodes.clear();
+		m_FreePairs.clear();
+		m_PrimOrder.clear();
+		m_PrimLeaves.clear();
+		m_PairCount = 0;
+		m_NeedBuild = true;
+	}
+
+	void BVHTree::Rebuild()
+	{
+		std::lock_guard<std::mutex> lock(m_BuildMutex);
+		Build();
+	}
+
+	void BVHTree::SetRebuildThreshold(float threshold)
+	{
+		m_RebuildThreshold = threshold;
+	}
+
+	float BVHTree::GetRebuildThreshold() const
+	{
+		return m_RebuildThreshold;
+	}
+
+	size_t BVHTree::GetSceneNodeCount() const
+	{
+		return m_SceneNodes.size() - m_FreePrims.size();
+	}
+
+	size_t BVHTree::GetTreeNodeCount() const
+	{
+		BuildIfNeeded();
+		return (m_PairCount - m_FreePairs.size()) * 2 + 1;
+	}
+
+	float BVHTree::GetCost() const
+	{
+		BuildIfNeeded();
+
+		float rootArea = Aabb::SurfaceArea(m_Nodes[0].min, m_Nodes[0].max);
+		if (rootArea <= 0.0f)
+			return 0.0f;
+
+		return (float)(m_Cost / rootArea);
+	}
+
+	void BVHTree::SetBounds(unsigned int prim, const BoxBounds &aabb)
+	{
+		Frustum::PackAABB(aabb, &m_Centers[prim * 3], &m_Extents[prim * 3]);
+	}
+
+	void BVHTree::BuildIfNeeded() const
+	{
+		std::lock_guard<std::mutex> lock(m_BuildMutex);
+		if (m_NeedBuild)
+			Build();
+	}
+
+	void BVHTree::Build() const
+	{
+		m_PrimOrder.clear();
+		m_PrimLeaves.assign(m_SceneNodes.size(), INVALID_INDEX);
+
+		for (unsigned int prim = 0; prim < m_SceneNodes.size(); prim++)
+		{
+			if (m_SceneNodes[prim] != nullptr)
+				m_PrimOrder.push_back(prim);
+		}
+
+		unsigned int count = m_PrimOrder.size();
+
+		// a binary tree with n leaves has 2n - 1 nodes.
+		m_FreePairs.clear();
+		m_PairCount = 0;
+		m_Nodes.resize(count > 1 ? count * 2 - 1 : 1);
+		m_Nodes[0].parent = INVALID_INDEX;
+
+		bool parallel = ThreadUtil::HasInstance() && ThreadUtil::Instance()->GetWorkerCount() > 0;
+		BuildNode(0, 0, count, parallel);
+
+		m_Nodes.resize(m_PairCount * 2 + 1);
+		m_NeedBuild = false;
+
+		m_Cost = m_BuiltCost = GetSubtreeCost(0);
+	}
+
+	void BVHTree::BuildNode(unsigned int index, unsigned int first, unsigned int count, bool parallel) const
+	{
+		Node &node = m_Nodes[index];
+		node.left = 0;
+		node.first = first;
+		node.count = count;
+
+		Aabb bounds, centroids;
+		for (unsigned int i = first; i < first + count; i++)
+		{
+			unsigned int prim = m_PrimOrder[i];
+			bounds.Grow(&m_Centers[prim * 3], &m_Extents[prim * 3]);
+			centroids.Grow(&m_Centers[prim * 3]);
+		}
+
+		std::copy(bounds.min, bounds.min + 3, node.min);
+		std::copy(bounds.max, bounds.max + 3, node.max);
+
+		float area = bounds.GetArea();
+		node.builtArea = area;
+
+		auto MakeLeaf = [&]()
+		{
+			for (unsigned int i = first; i < first + count; i++)
+				m_PrimLeaves[m_PrimOrder[i]] = index;
+		};
+
+		if (count <= MIN_SPLIT_COUNT)
+		{
+			MakeLeaf();
+			return;
+		}
+
+		// split along the longest axis of centroids.
+		int axis = 0;
+		float extent[3];
+		for (int i = 0; i < 3; i++)
+		{
+			extent[i] = centroids.max[i] - centroids.min[i];
+			if (extent[i] > extent[axis])
+				axis = i;
+		}
+
+		auto begin = m_PrimOrder.begin() + first;
+		auto end = begin + count;
+		unsigned int leftCount = count / 2;
+
+		if (extent[axis] > 0.0f)
+		{
+			float binScale = BIN_COUNT / extent[axis];
+			float binMin = centroids.min[axis];
+			auto GetBin = [&](unsigned int prim) -> int
+			{
+				int bin = (int)((m_Centers[prim * 3 + axis] - binMin) * binScale);
+				return bin < BIN_COUNT ? bin : BIN_COUNT - 1;
+			};
+
+			unsigned int binCounts[BIN_COUNT] = {};
+			Aabb binBounds[BIN_COUNT];
+			for (auto it = begin; it != end; ++it)
+			{
+				int bin = GetBin(*it);
+				binCounts[bin]++;
+				binBounds[bin].Grow(&m_Centers[*it * 3], &m_Extents[*it * 3]);
+			}
+
+			// sweep from right to get costs of every right side.
+			float rightCosts[BIN_COUNT];
+			Aabb rightBounds;
+			unsigned int rightCount = 0;
+			for (int i = BIN_COUNT - 1; i > 0; i--)
+			{
+				rightBounds.Grow(binBounds[i]);
+				rightCount += binCounts[i];
+				rightCosts[i] = rightBounds.GetArea() * rightCount;
+			}
+
+			Aabb leftBounds;
+			unsigned int leftBinCount = 0;
+			float bestCost = FLT_MAX;
+			int bestSplit = -1;
+			for (int i = 1; i < BIN_COUNT; i++)
+			{
+				leftBounds.Grow(binBounds[i - 1]);
+				leftBinCount += binCounts[i - 1];
+				if (leftBinCount == 0 || leftBinCount == count)
+					continue;
+
+				float cost = leftBounds.GetArea() * leftBinCount + rightCosts[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			// sah: splitting costs one traversal plus the childs weighted by area.
+			if (count <= MAX_LEAF_SIZE && (bestSplit < 0 || (area > 0.0f && 1.0f + bestCost / area >= count)))
+			{
+				MakeLeaf();
+				return;
+			}
+
+			if (bestSplit > 0)
+			{
+				auto mid = std::partition(begin, end, [&](unsigned int prim) { return GetBin(prim) < bestSplit; });
+				leftCount = mid - begin;
+			}
+		}
+		else if (count <= MAX_LEAF_SIZE)
+		{
+			MakeLeaf();
+			return;
+		}
+
+		// fall back to a median split.
+		if (leftCount == 0 || leftCount == count)
+		{
+			leftCount = count / 2;
+			std::nth_element(begin, begin + leftCount, end, [&](unsigned int a, unsigned int b)
+			{
+				return m_Centers[a * 3 + axis] < m_Centers[b * 3 + axis];
+			});
+		}
+
+		unsigned int left = AllocatePair();
+		node.left = left;
+		m_Nodes[left].parent = index;
+		m_Nodes[left + 1].parent = index;
+
+		if (parallel && count >= PARALLEL_COUNT)
+		{
+			auto threadUtil = ThreadUtil::Instance();
+			auto job = threadUtil->CreateJob([this, left, first, leftCount]()
+			{
+				BuildNode(left, first, leftCount, true);
+			});
+			threadUtil->Run(job);
+			BuildNode(left + 1, first + leftCount, count - leftCount, true);
+			threadUtil->WaitFor(job);
+		}
+		else
+		{
+			BuildNode(left, first, leftCount, parallel);
+			BuildNode(left + 1, first + leftCount, count - leftCount, parallel);
+		}
+	}
+
+	unsigned int BVHTree::AllocatePair() const
+	{
+		// free pairs only exist during serial subtree rebuilds.
+		if (m_FreePairs.size() > 0)
+		{
+			unsigned int pair = m_FreePairs.back();
+			m_FreePairs.pop_back();
+			return pair * 2 + 1;
+		}
+
+		return m_PairCount++ * 2 + 1;
+	}
+
+	void BVHTree::Refit(std::vector<unsigned int> &leaves)
+	{
+		std::sort(leaves.begin(), leaves.end());
+		leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+		std::vector<unsigned int> degraded;
+
+		for (auto leaf : leaves)
+		{
+			if (leaf == INVALID_INDEX)
+				continue;
+
+			for (unsigned int index = leaf; index != INVALID_INDEX; index = m_Nodes[index].parent)
+			{
+				bool changed = RefitNode(index);
+
+				const Node &node = m_Nodes[index];
+				if (node.left != 0 && Aabb::SurfaceArea(node.min, node.max) > node.builtArea * m_RebuildThreshold)
+					degraded.push_back(index);
+
+				// ancestors are unchanged too.
+				if (!changed)
+					break;
+			}
+		}
+
+		// subtree rebuilds can't fix primitives moving across subtrees, rebuild all when the tree gets too bad.
+		if (m_Cost > m_BuiltCost * m_RebuildThreshold)
+		{
+			m_NeedBuild = true;
+			return;
+		}
+
+		if (degraded.empty())
+			return;
+
+		std::sort(degraded.begin(), degraded.end());
+		degraded.erase(std::unique(degraded.begin(), degraded.end()), degraded.end());
+
+		// rebuild the topmost degraded nodes only.
+		for (auto index : degraded)
+		{
+			bool nested = false;
+			for (unsigned int parent = m_Nodes[index].parent; parent != INVALID_INDEX; parent = m_Nodes[parent].parent)
+			{
+				if (std::binary_search(degraded.begin(), degraded.end(), parent))
+				{
+					nested = true;
+					break;
+				}
+			}
+
+			if (nested)
+				continue;
+
+			if (index == 0)
+			{
+				Rebuild();
+				return;
+			}
+
+			m_Cost -= GetSubtreeCost(index);
+			RebuildSubtree(index);
+			m_Cost += GetSubtreeCost(index);
+
+			for (unsigned int parent = m_Nodes[index].parent; parent != INVALID_INDEX; parent = m_Nodes[parent].parent)
+			{
+				if (!RefitNode(parent))
+					break;
+			}
+		}
+	}
+
+	bool BVHTree::RefitNode(unsigned int index)
+	{
+		Node &node = m_Nodes[index];
+
+		Aabb bounds;
+		if (node.left != 0)
+		{
+			// empty childs have inverted bounds, so they don't grow it.
+			bounds.Grow(Aabb(m_Nodes[node.left].min, m_Nodes[node.left].max));
+			bounds.Grow(Aabb(m_Nodes[node.left + 1].min, m_Nodes[node.left + 1].max));
+		}
+		else
+		{
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				unsigned int prim = m_PrimOrder[i];
+				if (m_SceneNodes[prim] != nullptr)
+					bounds.Grow(&m_Centers[prim * 3], &m_Extents[prim * 3]);
+			}
+		}
+
+		bool changed = !std::equal(bounds.min, bounds.min + 3, node.min) || !std::equal(bounds.max, bounds.max + 3, node.max);
+		if (changed)
+		{
+			double weight = node.left != 0 ? 1.0 : node.count;
+			m_Cost += (bounds.GetArea() - Aabb::SurfaceArea(node.min, node.max)) * weight;
+
+			std::copy(bounds.min, bounds.min + 3, node.min);
+			std::copy(bounds.max, bounds.max + 3, node.max);
+		}
+
+		return changed;
+	}
+
+	void BVHTree::RebuildSubtree(unsigned int index)
+	{
+		unsigned int first = m_Nodes[index].first;
+		unsigned int count = m_Nodes[index].count;
+		unsigned int parent = m_Nodes[index].parent;
+
+		FreeChilds(index);
+
+		// removed primitives go to the end of the range, leaves never see them.
+		auto begin = m_PrimOrder.begin() + first;
+		auto liveEnd = std::stable_partition(begin, begin + count, [&](unsigned int prim) { return m_SceneNodes[prim] != nullptr; });
+		unsigned int liveCount = liveEnd - begin;
+
+		// make room for the worst case, so building won't reallocate.
+		unsigned int pairs = liveCount > 1 ? liveCount - 1 : 0;
+		if (pairs > m_FreePairs.size())
+		{
+			size_t size = (m_PairCount + pairs - m_FreePairs.size()) * 2 + 1;
+			if (size > m_Nodes.size())
+				m_Nodes.resize(size);
+		}
+
+		BuildNode(index, first, liveCount, false);
+
+		m_Nodes[index].parent = parent;
+		m_Nodes[index].count = count;
+	}
+
+	double BVHTree::GetSubtreeCost(unsigned int index) const
+	{
+		// traversal cost 1 for internal nodes, 1 per primitive for leaves, weighted by area.
+		double cost = 0.0;
+		std::vector<unsigned int> stack(1, index);
+		while (!stack.empty())
+		{
+			const Node &node = m_Nodes[stack.back()];
+			stack.pop_back();
+
+			double area = Aabb::SurfaceArea(node.min, node.max);
+			if (node.left != 0)
+			{
+				cost += area;
+				stack.push_back(node.left);
+				stack.push_back(node.left + 1);
+			}
+			else
+			{
+				cost += area * node.count;
+			}
+		}
+
+		return cost;
+	}
+
+	void BVHTree::FreeChilds(unsigned int index)
+	{
+		std::vector<unsigned int> stack(1, index);
+		while (!stack.empty())
+		{
+			unsigned int left = m_Nodes[stack.back()].left;
+			stack.pop_back();
+
+			if (left != 0)
+			{
+				m_FreePairs.push_back((left - 1) / 2);
+				stack.push_back(left);
+				stack.push_back(left + 1);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef _FURY_BVH_TREE_H_
+#define _FURY_BVH_TREE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+#include "Fury/SceneManager.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	class Frustum;
+
+	// Bounding volume hierarchy over scene node world aabbs, an alternative to OcTree that needs no world bounds.
+	// The tree is built with binned SAH, large ranges are split across ThreadUtil's workers when it's available.
+	// Moving scene nodes refit their leaf and ancestors right away, a subtree whose surface area grows past
+	// rebuildThreshold times it's area at build time is rebuilt. When the SAH cost of the whole tree grows
+	// past rebuildThreshold times it's cost at build time, the whole tree is rebuilt before the next query.
+	// Adding scene nodes marks the whole tree for a rebuild before the next query.
+	class FURY_API BVHTree : public SceneManager, public std::enable_shared_from_this<BVHTree>
+	{
+	public:
+
+		typedef std::shared_ptr<BVHTree> Ptr;
+
+		static Ptr Create(float rebuildThreshold = 2.0f);
+
+	protected:
+
+		struct Node
+		{
+			float min[3];
+
+			float max[3];
+
+			// left child, right child is left + 1. 0 for leaves.
+			unsigned int left;
+
+			// range in m_PrimOrder covered by this node.
+			unsigned int first;
+
+			unsigned int count;
+
+			unsigned int parent;
+
+			// surface area when this node was built.
+			float builtArea;
+		};
+
+		std::type_index m_TypeIndex;
+
+		float m_RebuildThreshold;
+
+		// scene nodes by primitive id, nullptr for free ids.
+		SceneNodes m_SceneNodes;
+
+		// xyz triples of each primitive's world aabb.
+		std::vector<float> m_Centers;
+
+		std::vector<float> m_Extents;
+
+		std::vector<unsigned int> m_FreePrims;
+
+		// tree data below is rebuilt lazily in const queries, so it's mutable.
+
+		// root is 0, childs are allocated in pairs.
+		mutable std::vector<Node> m_Nodes;
+
+		mutable std::atomic<unsigned int> m_PairCount;
+
+		mutable std::vector<unsigned int> m_FreePairs;
+
+		// primitive ids ordered by leaf.
+		mutable std::vector<unsigned int> m_PrimOrder;
+
+		// leaf of each primitive.
+		mutable std::vector<unsigned int> m_PrimLeaves;
+
+		mutable bool m_NeedBuild;
+
+		// SAH cost, kept up to date by refits.
+		mutable double m_Cost;
+
+		mutable double m_BuiltCost;
+
+		mutable std::mutex m_BuildMutex;
+
+	public:
+
+		BVHTree(float rebuildThreshold = 2.0f);
+
+		~BVHTree();
+
+		virtual std::type_index GetTypeIndex() const;
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		// refits once for the whole batch.
+		virtual void UpdateSceneNodes(const SceneNodes &sceneNodes);
+
+		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const;
+
+		virtual void Clear();
+
+		// rebuilds the whole tree now instead of before the next query.
+		void Rebuild();
+
+		void SetRebuildThreshold(float threshold);
+
+		float GetRebuildThreshold() const;
+
+		size_t GetSceneNodeCount() const;
+
+		size_t GetTreeNodeCount() const;
+
+		// SAH cost of the tree, relative to root's surface area.
+		float GetCost() const;
+
+	protected:
+
+		void SetBounds(unsigned int prim, const BoxBounds &aabb);
+
+		void BuildIfNeeded() const;
+
+		void Build() const;
+
+		// builds node over m_PrimOrder[first, first + count).
+		void BuildNode(unsigned int index, unsigned int first, unsigned int count, bool parallel) const;
+
+		unsigned int AllocatePair() const;
+
+		// recomputes bounds of dirty leaves and their ancestors, then rebuilds degraded subtrees.
+		void Refit(std::vector<unsigned int> &leaves);
+
+		bool RefitNode(unsigned int index);
+
+		void RebuildSubtree(unsigned int index);
+
+		void FreeChilds(unsigned int index);
+
+		double GetSubtreeCost(unsigned int index) const;
+
+		void WalkFrustum(const Frustum &frustum, const FilterFunc &filterFunc) const;
+	};
+}
+
+#endif // _FURY_BVH_TREE_H_
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <SFML/Window.hpp>
 
+#include "Fury/AnimationSystem.h"
 #include "Fury/BufferManager.h"
 #include "Fury/Engine.h"
 #include "Fury/FbxParser.h"
@@ -7,9 +8,11 @@
 #include "Fury/Gui.h"
 #include "Fury/InputUtil.h"
 #include "Fury/Log.h"
+#include "Fury/MeshPool.h"
 #include "Fury/MeshUtil.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/ThreadUtil.h"
+#include "Fury/TransformManager.h"
 #include "Fury/Vector4.h"
 
 namespace fury
@@ -19,7 +22,7 @@ namespace fury
 	Signal<>::Ptr Engine::OnFixedUpdate = Signal<>::Create();
 
 	bool Engine::Initialize(sf::Window &window, float guiScale, int numThreads, LogLevel level, const char* logfile,
-		bool console, const LogFormatter &formatter, bool append)
+		bool console, const LogFormatter &formatter, bool append, unsigned int meshPoolPageSize)
 	{
 		Log<0>::Initialize(std::move(level), std::move(logfile), std::move(console), formatter, std::move(append));
 
@@ -27,6 +30,8 @@ namespace fury
 		ThreadUtil::Instance()->SetMainThread();
 
 		FURYD << ThreadUtil::Instance()->GetWorkerCount() << " thread launched!";
+
+		TransformManager::Initialize();
 		FURYD << "Window width: " << window.getSize().x << ", height: " << window.getSize().y;
 
 		MeshUtil::m_UnitQuad = MeshUtil::CreateQuad("quad_mesh", Vector4(-1.0f, -1.0f, 0.0f), Vector4(1.0f, 1.0f, 0.0f));
@@ -48,6 +53,10 @@ namespace fury
 
 		BufferManager::Initialize();
 
+		MeshPool::Initialize(std::move(meshPoolPageSize));
+
+		AnimationSystem::Initialize();
+
 #ifdef _FURY_GUI_IMP_
 		Gui::Initialize(&window, guiScale);
 #endif
@@ -137,6 +146,7 @@ namespace fury
 	{
 		ThreadUtil::Instance()->Update();
 		OnUpdate->Emit(std::move(dt));
+		TransformManager::Instance()->Update();
 	}
 
 	void Engine::FixedUpdate()
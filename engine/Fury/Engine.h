@@ -19,7 +19,8 @@ namespace fury
 
 		static bool Initialize(sf::Window &window, float guiScale, int numThreads, 
 			LogLevel level = LogLevel::EROR, const char* logfile = nullptr, 
-			bool console = true, const LogFormatter &formatter = Formatter::Simple, bool append = false);
+			bool console = true, const LogFormatter &formatter = Formatter::Simple, bool append = false, 
+			unsigned int meshPoolPageSize = 1 << 20);
 
 		static void HandleEvent(sf::Event &event);
 
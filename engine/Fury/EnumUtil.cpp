@@ -196,6 +196,13 @@ namespace fury
 		GL_LINE_STRIP
 	};
 
+	const std::vector<std::pair<VertexLayout, std::string>> EnumUtil::m_VertexLayout =
+	{
+		std::make_pair(VertexLayout::SEPARATE, "separate"),
+		std::make_pair(VertexLayout::INTERLEAVED, "interleaved"),
+		std::make_pair(VertexLayout::QUANTIZED, "quantized")
+	};
+
 
 	std::string EnumUtil::ClearModeToString(ClearMode mode)
 	{
@@ -504,4 +511,19 @@ namespace fury
 	{
 		return m_LineMode[(unsigned int)mode];
 	}
+
+	std::string EnumUtil::VertexLayoutToString(VertexLayout layout)
+	{
+		return m_VertexLayout[(int)layout].second;
+	}
+
+	VertexLayout EnumUtil::VertexLayoutFromString(const std::string &name)
+	{
+		for (const auto &pair : m_VertexLayout)
+		{
+			if (pair.second == name)
+				return pair.first;
+		}
+		return VertexLayout::SEPARATE;
+	}
 }
\ No newline at end of file
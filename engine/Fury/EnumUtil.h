@@ -156,6 +156,13 @@ namespace fury
 		LINE_STRIP
 	};
 
+	enum class VertexLayout : unsigned int
+	{
+		SEPARATE = 0,
+		INTERLEAVED,
+		QUANTIZED
+	};
+
 	class FURY_API EnumUtil final
 	{
 	private:
@@ -190,6 +197,8 @@ namespace fury
 
 		static const std::vector<unsigned int> m_LineMode;
 
+		static const std::vector<std::pair<VertexLayout, std::string>> m_VertexLayout;
+
 	public:
 
 		static std::string ClearModeToString(ClearMode mode);
@@ -279,6 +288,11 @@ namespace fury
 
 
 		static unsigned int LineModeToUnit(LineMode mode);
+
+
+		static std::string VertexLayoutToString(VertexLayout layout);
+
+		static VertexLayout VertexLayoutFromString(const std::string &name);
 	};
 }
 
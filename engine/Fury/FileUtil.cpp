@@ -457,6 +457,8 @@ namespace fury
 		bool optOptimizeMesh = (options & GLTFImportFlags::OPTMZ_MESH) == 1;
 		bool optGenNormal = (options & GLTFImportFlags::GEN_NORMAL) == 1;
 		bool optGenTangent = (options & GLTFImportFlags::GEN_TANGENT) == 1;
+		bool optInterleave = (options & GLTFImportFlags::INTERLEAVE_VERTEX) != 0;
+		bool optQuantize = (options & GLTFImportFlags::QUANTIZE_VERTEX) != 0;
 
 		for (unsigned int i = 0; i < gltfDom->Meshes.size(); i++)
 		{
@@ -595,6 +597,11 @@ namespace fury
 			if (optOptimizeMesh)
 				MeshUtil::OptimizeMesh(meshPtr);
 
+			if (optQuantize)
+				MeshUtil::ConvertVertexLayout(meshPtr, VertexLayout::QUANTIZED);
+			else if (optInterleave)
+				MeshUtil::ConvertVertexLayout(meshPtr, VertexLayout::INTERLEAVED);
+
 			meshPtr->CalculateAABB();
 			meshes.emplace_back(meshPtr);
 			scene->GetEntityManager()->Add(meshPtr);
@@ -25,11 +25,13 @@ namespace fury
 
 	class Serializable;
 
-	enum GLTFImportFlags : unsigned int
-	{
-		OPTMZ_MESH = 0x0001, 
-		GEN_NORMAL = 0x0002, 
-		GEN_TANGENT = 0x0004, 
+	enum GLTFImportFlags : unsigned int
+	{
+		OPTMZ_MESH = 0x0001, 
+		GEN_NORMAL = 0x0002, 
+		GEN_TANGENT = 0x0004, 
+		INTERLEAVE_VERTEX = 0x0008, 
+		QUANTIZE_VERTEX = 0x0010, 
 	};
 
 	class FURY_API FileUtil final
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <cmath>
 
 #include "Fury/BoxBounds.h"
 #include "Fury/Frustum.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Plane.h"
+#include "Fury/Simd.h"
 #include "Fury/SphereBounds.h"
 #include "Fury/Vector4.h"
 
@@ -165,11 +167,199 @@ namespace fury
 		return true;
 	}
 
+	Side Frustum::IsInside(const BoxBounds &aabb, unsigned int &planeMask) const
+	{
+		if (aabb.GetInfinite())
+		{
+			planeMask = 0;
+			return Side::IN;
+		}
+
+		for (int i = 0; i < 6; i++)
+		{
+			if ((planeMask & (1 << i)) == 0)
+				continue;
+
+			Side side = m_Planes[i].IsInside(aabb);
+			if (side == Side::OUT)
+				return Side::OUT;
+			else if (side == Side::IN)
+				planeMask &= ~(1 << i);
+		}
+
+		return planeMask == 0 ? Side::IN : Side::STRADDLE;
+	}
+
+	// tests boxes in groups of 4, fill(index, count, lanes) writes cx, cy, cz, ex, ey, ez of
+	// boxes [index, index + count) to lanes, unused lanes are ignored.
+	template<class FillFunc>
+	static void CullBoxes(const std::array<Plane, 6> &planes, unsigned int planeMask, size_t n, uint8_t *visibleMask, FillFunc fill)
+	{
+		int order[6];
+		int planeCount = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			if (planeMask & (1 << i))
+				order[planeCount++] = i;
+		}
+
+		if (planeCount == 0)
+		{
+			std::fill(visibleMask, visibleMask + n, 1);
+			return;
+		}
+
+		// box is outside if n . c + d + |n| . e < 0
+		float nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+		for (int i = 0; i < planeCount; i++)
+		{
+			const Plane &plane = planes[order[i]];
+			Vector4 normal = plane.GetNormal();
+			nx[i] = normal.x;
+			ny[i] = normal.y;
+			nz[i] = normal.z;
+			ax[i] = std::abs(normal.x);
+			ay[i] = std::abs(normal.y);
+			az[i] = std::abs(normal.z);
+			d[i] = plane.GetDistance();
+		}
+
+		// plane coherency: neighbouring boxes tend to be rejected by the same plane, so start from it.
+		int first = 0;
+
+		FURY_SIMD_ALIGN float lanes[6][4];
+
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		using namespace simd;
+
+		Float4 zero = Splat(0.0f);
+
+		for (size_t i = 0; i < n; i += 4)
+		{
+			size_t count = n - i < 4 ? n - i : 4;
+			fill(i, count, lanes);
+
+			Float4 cx = Load(lanes[0]);
+			Float4 cy = Load(lanes[1]);
+			Float4 cz = Load(lanes[2]);
+			Float4 ex = Load(lanes[3]);
+			Float4 ey = Load(lanes[4]);
+			Float4 ez = Load(lanes[5]);
+
+			int used = (1 << count) - 1;
+			int outside = 0;
+
+			for (int j = 0, k = first; j < planeCount; j++, k = k + 1 == planeCount ? 0 : k + 1)
+			{
+				Float4 distance = Add(Add(Mul(Splat(nx[k]), cx), Mul(Splat(ny[k]), cy)), Add(Mul(Splat(nz[k]), cz), Splat(d[k])));
+				distance = Add(distance, Add(Add(Mul(Splat(ax[k]), ex), Mul(Splat(ay[k]), ey)), Mul(Splat(az[k]), ez)));
+
+				outside |= MoveMask(CmpLt(distance, zero));
+				if ((outside & used) == used)
+				{
+					first = k;
+					break;
+				}
+			}
+
+			for (size_t j = 0; j < count; j++)
+				visibleMask[i + j] = (outside & (1 << j)) ? 0 : 1;
+		}
+#else
+		for (size_t i = 0; i < n; i += 4)
+		{
+			size_t count = n - i < 4 ? n - i : 4;
+			fill(i, count, lanes);
+
+			for (size_t j = 0; j < count; j++)
+			{
+				uint8_t visible = 1;
+				for (int l = 0, k = first; l < planeCount; l++, k = k + 1 == planeCount ? 0 : k + 1)
+				{
+					float distance = nx[k] * lanes[0][j] + ny[k] * lanes[1][j] + nz[k] * lanes[2][j] + d[k] +
+						ax[k] * lanes[3][j] + ay[k] * lanes[4][j] + az[k] * lanes[5][j];
+
+					if (distance < 0.0f)
+					{
+						visible = 0;
+						first = k;
+						break;
+					}
+				}
+				visibleMask[i + j] = visible;
+			}
+		}
+#endif
+	}
+
+	const float Frustum::INFINITE_EXTENT = 1e18f;
+
+	void Frustum::PackAABB(const BoxBounds &aabb, float *center, float *extents)
+	{
+		if (aabb.GetInfinite())
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				center[axis] = 0.0f;
+				extents[axis] = INFINITE_EXTENT;
+			}
+		}
+		else
+		{
+			Vector4 c = aabb.GetCenter();
+			Vector4 e = aabb.GetExtents();
+			center[0] = c.x;
+			center[1] = c.y;
+			center[2] = c.z;
+			extents[0] = e.x;
+			extents[1] = e.y;
+			extents[2] = e.z;
+		}
+	}
+
+	void Frustum::CullAABBs(const float *centers, const float *extents, size_t n, uint8_t *visibleMask, unsigned int planeMask) const
+	{
+		CullBoxes(m_Planes, planeMask, n, visibleMask, [&](size_t index, size_t count, float (&lanes)[6][4])
+		{
+			for (size_t i = 0; i < 4; i++)
+			{
+				// pad unused lanes with the last box.
+				size_t offset = (index + (i < count ? i : count - 1)) * 3;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					lanes[axis][i] = centers[offset + axis];
+					lanes[axis + 3][i] = extents[offset + axis];
+				}
+			}
+		});
+	}
+
+	void Frustum::CullAABBs(const float *const centers[3], const float *const extents[3], size_t n, uint8_t *visibleMask, unsigned int planeMask) const
+	{
+		CullBoxes(m_Planes, planeMask, n, visibleMask, [&](size_t index, size_t count, float (&lanes)[6][4])
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				for (size_t i = 0; i < 4; i++)
+				{
+					size_t offset = index + (i < count ? i : count - 1);
+					lanes[axis][i] = centers[axis][offset];
+					lanes[axis + 3][i] = extents[axis][offset];
+				}
+			}
+		});
+	}
+
 	std::array<Vector4, 8> Frustum::GetCurrentCorners() const
 	{
 		return m_CurrentCorners;
 	}
 
+	std::array<Plane, 6> Frustum::GetPlanes() const
+	{
+		return m_Planes;
+	}
+
 	std::array<Vector4, 8> Frustum::GetBaseCorners() const
 	{
 		return m_BaseCorners;
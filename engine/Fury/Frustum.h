@@ -2,6 +2,8 @@
 #define _FURY_FRUSTUM_H_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 #include "Fury/Collidable.h"
 #include "Fury/Plane.h"
@@ -30,6 +32,11 @@ namespace fury
 
 	public:
 
+		static const unsigned int ALL_PLANES = 0x3f;
+
+		// large but finite extent packed for infinite aabbs, so 0 * extent won't produce nan in plane tests.
+		static const float INFINITE_EXTENT;
+
 		Frustum() {}
 
 		Frustum(const Frustum &other);
@@ -52,11 +59,28 @@ namespace fury
 
 		virtual bool IsInsideFast(Vector4 point) const;
 
+		// like IsInside, but only tests planes whose bit is set in planeMask (bit i for plane i).
+		// on return planeMask only keeps planes the aabb straddles, so childs of an octant can skip the rest.
+		Side IsInside(const BoxBounds &aabb, unsigned int &planeMask) const;
+
+		// batched IsInsideFast for n aabbs, centers and extents are packed xyz triples.
+		// visibleMask[i] is set to 1 if box i is visible, 0 otherwise.
+		void CullAABBs(const float *centers, const float *extents, size_t n, uint8_t *visibleMask, unsigned int planeMask = ALL_PLANES) const;
+
+		// same as above, but reads centers and extents from separate x, y, z arrays.
+		void CullAABBs(const float *const centers[3], const float *const extents[3], size_t n, uint8_t *visibleMask, unsigned int planeMask = ALL_PLANES) const;
+
+		// writes the xyz center and extents of aabb in the layout CullAABBs reads.
+		static void PackAABB(const BoxBounds &aabb, float *center, float *extents);
+
 		// ntl, ntr, nbl, nbr, ftl, ftr, fbl, fbr
 		std::array<Vector4, 8> GetCurrentCorners() const;
 
 		std::array<Vector4, 8> GetBaseCorners() const;
 
+		// top, bottom, left, right, near, far
+		std::array<Plane, 6> GetPlanes() const;
+
 		Matrix4 GetTransformMatrix() const;
 
 		BoxBounds GetBoxBounds() const;
@@ -1,13 +1,16 @@
 #ifndef _FURY_FURY_H_
 #define _FURY_FURY_H_
 
+#include "Fury/AlignedAllocator.h"
 #include "Fury/AnimationClip.h"
 #include "Fury/AnimationPlayer.h"
+#include "Fury/AnimationSystem.h"
 #include "Fury/AnimationUtil.h"
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
 #include "Fury/Buffer.h"
 #include "Fury/BufferManager.h"
+#include "Fury/BVHTree.h"
 #include "Fury/Camera.h"
 #include "Fury/Component.h"
 #include "Fury/Color.h"
@@ -18,23 +21,28 @@
 #include "Fury/FileUtil.h"
 #include "Fury/FbxParser.h"
 #include "Fury/Frustum.h"
+#include "Fury/GLState.h"
 #include "Fury/Gui.h"
 #include "Fury/InputUtil.h"
 #include "Fury/Joint.h"
 #include "Fury/Light.h"
+#include "Fury/LinearOcTree.h"
 #include "Fury/Log.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Material.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
 #include "Fury/MeshRender.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/OcclusionCuller.h"
 #include "Fury/OcTree.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/Plane.h"
 #include "Fury/Quaternion.h"
 #include "Fury/Pass.h"
 #include "Fury/Pipeline.h"
+#include "Fury/PoseBuffer.h"
 #include "Fury/PrelightPipeline.h"
 #include "Fury/RenderQuery.h"
 #include "Fury/RenderUtil.h"
@@ -43,11 +51,16 @@
 #include "Fury/Serializable.h"
 #include "Fury/Signal.h"
 #include "Fury/Shader.h"
+#include "Fury/Simd.h"
 #include "Fury/Singleton.h"
+#include "Fury/Skeleton.h"
 #include "Fury/SphereBounds.h"
+#include "Fury/StreamBuffer.h"
 #include "Fury/Texture.h"
 #include "Fury/ThreadUtil.h"
 #include "Fury/Transform.h"
+#include "Fury/TransformManager.h"
+#include "Fury/TransformStore.h"
 #include "Fury/TypeComparable.h"
 #include "Fury/Uniform.h"
 #include "Fury/Vector4.h"
@@ -0,0 +1,249 @@
+#include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
+
+namespace fury
+{
+	unsigned int GLState::m_Program = GLState::UNKNOWN;
+	unsigned int GLState::m_VertexArray = GLState::UNKNOWN;
+	unsigned int GLState::m_FrameBuffer = GLState::UNKNOWN;
+	int GLState::m_Viewport[4] = { -1, -1, -1, -1 };
+	unsigned int GLState::m_ActiveTexture = GLState::UNKNOWN;
+	// arrays start zeroed, that's gl's default: nothing bound and all capabilities disabled.
+	unsigned int GLState::m_Textures[GLState::MAX_TEXTURE_UNITS][GLState::TEXTURE_TARGET_COUNT];
+	unsigned int GLState::m_Capabilities[GLState::CAPABILITY_COUNT];
+	unsigned int GLState::m_DepthFunc = GLState::UNKNOWN;
+	unsigned int GLState::m_BlendSrc = GLState::UNKNOWN;
+	unsigned int GLState::m_BlendDest = GLState::UNKNOWN;
+	unsigned int GLState::m_BlendEquation = GLState::UNKNOWN;
+	unsigned int GLState::m_CullFace = GLState::UNKNOWN;
+	unsigned int GLState::m_IssuedCount = 0;
+	unsigned int GLState::m_SkippedCount = 0;
+
+	void GLState::Invalidate()
+	{
+		m_Program = m_VertexArray = m_FrameBuffer = UNKNOWN;
+		m_Viewport[0] = m_Viewport[1] = m_Viewport[2] = m_Viewport[3] = -1;
+		m_ActiveTexture = UNKNOWN;
+
+		for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++)
+			for (unsigned int j = 0; j < TEXTURE_TARGET_COUNT; j++)
+				m_Textures[i][j] = UNKNOWN;
+
+		for (unsigned int i = 0; i < CAPABILITY_COUNT; i++)
+			m_Capabilities[i] = UNKNOWN;
+
+		m_DepthFunc = m_BlendSrc = m_BlendDest = m_BlendEquation = m_CullFace = UNKNOWN;
+	}
+
+	void GLState::UseProgram(unsigned int program)
+	{
+		if (Update(m_Program, program))
+			glUseProgram(program);
+	}
+
+	void GLState::BindVertexArray(unsigned int vao)
+	{
+		if (Update(m_VertexArray, vao))
+			glBindVertexArray(vao);
+	}
+
+	void GLState::BindFrameBuffer(unsigned int fbo)
+	{
+		if (Update(m_FrameBuffer, fbo))
+			glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	}
+
+	void GLState::Viewport(int x, int y, int width, int height)
+	{
+		if (m_Viewport[0] == x && m_Viewport[1] == y && m_Viewport[2] == width && m_Viewport[3] == height)
+		{
+			m_SkippedCount++;
+			return;
+		}
+
+		m_Viewport[0] = x;
+		m_Viewport[1] = y;
+		m_Viewport[2] = width;
+		m_Viewport[3] = height;
+
+		glViewport(x, y, width, height);
+		m_IssuedCount++;
+	}
+
+	void GLState::ActiveTexture(unsigned int unit)
+	{
+		if (Update(m_ActiveTexture, unit))
+			glActiveTexture(unit);
+	}
+
+	void GLState::BindTexture(unsigned int target, unsigned int texture)
+	{
+		int index = GetTextureTargetIndex(target);
+		unsigned int unit = m_ActiveTexture - GL_TEXTURE0;
+
+		// unknown unit or target, can't tell if it's redundant.
+		if (index < 0 || m_ActiveTexture == UNKNOWN || unit >= MAX_TEXTURE_UNITS)
+		{
+			glBindTexture(target, texture);
+			m_IssuedCount++;
+			return;
+		}
+
+		if (Update(m_Textures[unit][index], texture))
+			glBindTexture(target, texture);
+	}
+
+	void GLState::Enable(unsigned int capability)
+	{
+		SetCapability(capability, true);
+	}
+
+	void GLState::Disable(unsigned int capability)
+	{
+		SetCapability(capability, false);
+	}
+
+	void GLState::DepthFunc(unsigned int func)
+	{
+		if (Update(m_DepthFunc, func))
+			glDepthFunc(func);
+	}
+
+	void GLState::BlendFunc(unsigned int src, unsigned int dest)
+	{
+		if (m_BlendSrc == src && m_BlendDest == dest)
+		{
+			m_SkippedCount++;
+			return;
+		}
+
+		m_BlendSrc = src;
+		m_BlendDest = dest;
+
+		glBlendFunc(src, dest);
+		m_IssuedCount++;
+	}
+
+	void GLState::BlendEquation(unsigned int equation)
+	{
+		if (Update(m_BlendEquation, equation))
+			glBlendEquation(equation);
+	}
+
+	void GLState::CullFace(unsigned int face)
+	{
+		if (Update(m_CullFace, face))
+			glCullFace(face);
+	}
+
+	void GLState::OnDeleteProgram(unsigned int program)
+	{
+		// deleted program stays in use until another one is, but the cache can't follow that.
+		if (m_Program == program)
+			m_Program = UNKNOWN;
+	}
+
+	void GLState::OnDeleteVertexArray(unsigned int vao)
+	{
+		if (m_VertexArray == vao)
+			m_VertexArray = 0;
+	}
+
+	void GLState::OnDeleteFrameBuffer(unsigned int fbo)
+	{
+		if (m_FrameBuffer == fbo)
+			m_FrameBuffer = 0;
+	}
+
+	void GLState::OnDeleteTexture(unsigned int texture)
+	{
+		for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++)
+		{
+			for (unsigned int j = 0; j < TEXTURE_TARGET_COUNT; j++)
+			{
+				if (m_Textures[i][j] == texture)
+					m_Textures[i][j] = 0;
+			}
+		}
+	}
+
+	void GLState::ResetCounters()
+	{
+		m_IssuedCount = 0;
+		m_SkippedCount = 0;
+	}
+
+	unsigned int GLState::GetIssuedCount()
+	{
+		return m_IssuedCount;
+	}
+
+	unsigned int GLState::GetSkippedCount()
+	{
+		return m_SkippedCount;
+	}
+
+	int GLState::GetTextureTargetIndex(unsigned int target)
+	{
+		switch (target)
+		{
+		case GL_TEXTURE_2D:
+			return 0;
+		case GL_TEXTURE_2D_ARRAY:
+			return 1;
+		case GL_TEXTURE_CUBE_MAP:
+			return 2;
+		default:
+			return -1;
+		}
+	}
+
+	int GLState::GetCapabilityIndex(unsigned int capability)
+	{
+		switch (capability)
+		{
+		case GL_DEPTH_TEST:
+			return 0;
+		case GL_BLEND:
+			return 1;
+		case GL_CULL_FACE:
+			return 2;
+		case GL_SCISSOR_TEST:
+			return 3;
+		case GL_POLYGON_OFFSET_FILL:
+			return 4;
+		case GL_FRAMEBUFFER_SRGB:
+			return 5;
+		default:
+			return -1;
+		}
+	}
+
+	void GLState::SetCapability(unsigned int capability, bool enable)
+	{
+		int index = GetCapabilityIndex(capability);
+		if (index < 0 || Update(m_Capabilities[index], enable ? 1 : 0))
+		{
+			if (index < 0)
+				m_IssuedCount++;
+
+			if (enable)
+				glEnable(capability);
+			else
+				glDisable(capability);
+		}
+	}
+
+	bool GLState::Update(unsigned int &cached, unsigned int value)
+	{
+		if (cached == value)
+		{
+			m_SkippedCount++;
+			return false;
+		}
+
+		cached = value;
+		m_IssuedCount++;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef _FURY_GLSTATE_H_
+#define _FURY_GLSTATE_H_
+
+#include "Macros.h"
+
+namespace fury
+{
+	// Shadow copy of the gl states engine touches most, calls that won't change anything are dropped.
+	// All engine gl state changes should go through here, otherwise call Invalidate after changing
+	// states directly, so the cache re-syncs on the next call.
+	class FURY_API GLState final
+	{
+	private:
+
+		static const unsigned int MAX_TEXTURE_UNITS = 32;
+
+		// GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP.
+		static const unsigned int TEXTURE_TARGET_COUNT = 3;
+
+		// GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_POLYGON_OFFSET_FILL, GL_FRAMEBUFFER_SRGB.
+		static const unsigned int CAPABILITY_COUNT = 6;
+
+		// marks a cached value as unknown.
+		static const unsigned int UNKNOWN = 0xFFFFFFFF;
+
+		static unsigned int m_Program;
+
+		static unsigned int m_VertexArray;
+
+		static unsigned int m_FrameBuffer;
+
+		static int m_Viewport[4];
+
+		static unsigned int m_ActiveTexture;
+
+		static unsigned int m_Textures[MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+
+		static unsigned int m_Capabilities[CAPABILITY_COUNT];
+
+		static unsigned int m_DepthFunc;
+
+		static unsigned int m_BlendSrc;
+
+		static unsigned int m_BlendDest;
+
+		static unsigned int m_BlendEquation;
+
+		static unsigned int m_CullFace;
+
+		static unsigned int m_IssuedCount;
+
+		static unsigned int m_SkippedCount;
+
+	public:
+
+		// forget all cached states.
+		static void Invalidate();
+
+		static void UseProgram(unsigned int program);
+
+		static void BindVertexArray(unsigned int vao);
+
+		static void BindFrameBuffer(unsigned int fbo);
+
+		static void Viewport(int x, int y, int width, int height);
+
+		// unit is GL_TEXTURE0 + n.
+		static void ActiveTexture(unsigned int unit);
+
+		// binds to the active texture unit.
+		static void BindTexture(unsigned int target, unsigned int texture);
+
+		static void Enable(unsigned int capability);
+
+		static void Disable(unsigned int capability);
+
+		static void DepthFunc(unsigned int func);
+
+		static void BlendFunc(unsigned int src, unsigned int dest);
+
+		static void BlendEquation(unsigned int equation);
+
+		static void CullFace(unsigned int face);
+
+		// call these before deleting gl objects, so a new object reusing the name won't be skipped.
+
+		static void OnDeleteProgram(unsigned int program);
+
+		static void OnDeleteVertexArray(unsigned int vao);
+
+		static void OnDeleteFrameBuffer(unsigned int fbo);
+
+		static void OnDeleteTexture(unsigned int texture);
+
+		static void ResetCounters();
+
+		// state calls sent to gl since last ResetCounters.
+		static unsigned int GetIssuedCount();
+
+		// state calls dropped since last ResetCounters.
+		static unsigned int GetSkippedCount();
+
+	private:
+
+		static int GetTextureTargetIndex(unsigned int target);
+
+		static int GetCapabilityIndex(unsigned int capability);
+
+		static void SetCapability(unsigned int capability, bool enable);
+
+		// returns true if value changed and the call should be issued.
+		static bool Update(unsigned int &cached, unsigned int value);
+	};
+}
+
+#endif // _FURY_GLSTATE_H_
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "Fury/Gui.h"
 #include "Fury/GLLoader.h"
 #include "Fury/Pipeline.h"
+#include "Fury/GLState.h"
 #include "Fury/RenderUtil.h"
 
 #include <SFML/Window.hpp>
@@ -132,7 +133,8 @@ namespace fury
 			if (m_VBO == 0 || m_EAB == 0 || m_VAO == 0)
 				return false;
 
-			glBindVertexArray(m_VAO);
+			// binds go through GLState so it's cache stays in sync.
+			GLState::BindVertexArray(m_VAO);
 			glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 			glEnableVertexAttribArray(attribLocationPosition);
 			glEnableVertexAttribArray(attribLocationUV);
@@ -150,7 +152,7 @@ namespace fury
 			io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
 			glGenTextures(1, &m_FontTexture);
-			glBindTexture(GL_TEXTURE_2D, m_FontTexture);
+			GLState::BindTexture(GL_TEXTURE_2D, m_FontTexture);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
@@ -158,9 +160,9 @@ namespace fury
 			// Store our identifier
 			io.Fonts->TexID = (void *)(intptr_t)m_FontTexture;
 
-			glBindTexture(GL_TEXTURE_2D, 0);
+			GLState::BindTexture(GL_TEXTURE_2D, 0);
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
-			glBindVertexArray(0);
+			GLState::BindVertexArray(0);
 
 			m_Shader->UnBind();
 
@@ -171,6 +173,7 @@ namespace fury
 		{
 			if (m_VAO != 0)
 			{
+				GLState::OnDeleteVertexArray(m_VAO);
 				glDeleteVertexArrays(1, &m_VAO);
 				m_VAO = 0;
 			}
@@ -185,6 +188,7 @@ namespace fury
 
 			if (m_FontTexture)
 			{
+				GLState::OnDeleteTexture(m_FontTexture);
 				glDeleteTextures(1, &m_FontTexture);
 				ImGui::GetIO().Fonts->TexID = 0;
 				m_FontTexture = 0;
@@ -283,6 +287,9 @@ namespace fury
 			if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
 			if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
 			glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+
+			// states above are restored directly, let the cache re-sync.
+			GLState::Invalidate();
 		}
 
 		void HandleEvent(sf::Event &event)
@@ -432,10 +439,16 @@ namespace fury
 			ImGui::Separator();
 
 			ImGui::Text("DrawCall: %i", RenderUtil::Instance()->GetDrawCall());
+			ImGui::Text("InstancedDrawCall: %i", RenderUtil::Instance()->GetInstancedDrawCall());
 			ImGui::Text("Triangles: %i", RenderUtil::Instance()->GetTriangleCount());
 			ImGui::Text("Mesh: %i", RenderUtil::Instance()->GetMeshCount());
 			ImGui::Text("SkinnedMesh: %i", RenderUtil::Instance()->GetSkinnedMeshCount());
 			ImGui::Text("Light: %i", RenderUtil::Instance()->GetLightCount());
+			ImGui::Text("Shader/Material/Mesh Changes: %i/%i/%i", RenderUtil::Instance()->GetShaderChangeCount(),
+				RenderUtil::Instance()->GetMaterialChangeCount(), RenderUtil::Instance()->GetMeshChangeCount());
+			ImGui::Text("Uniform Block Uploads: %i", RenderUtil::Instance()->GetBlockUploadCount());
+			ImGui::Text("GL State Issued/Skipped: %i/%i", RenderUtil::Instance()->GetIssuedStateCount(),
+				RenderUtil::Instance()->GetSkippedStateCount());
 
 			// switches
 			{
@@ -455,6 +468,22 @@ namespace fury
 				ImGui::Checkbox("Use Cascaded Shadow Map", &use_csm);
 				Pipeline::Active->SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, use_csm);
 
+				static bool use_instancing = true;
+				ImGui::Checkbox("Use Instancing", &use_instancing);
+				Pipeline::Active->SetSwitch(PipelineSwitch::INSTANCING, use_instancing);
+
+				static bool use_mesh_pool = true;
+				ImGui::Checkbox("Use Mesh Pool", &use_mesh_pool);
+				Pipeline::Active->SetSwitch(PipelineSwitch::MESH_POOL, use_mesh_pool);
+
+				static bool use_multi_draw = true;
+				ImGui::Checkbox("Use Multi Draw Indirect", &use_multi_draw);
+				Pipeline::Active->SetSwitch(PipelineSwitch::MULTI_DRAW_INDIRECT, use_multi_draw);
+
+				static bool use_occlusion_culling = false;
+				ImGui::Checkbox("Use Occlusion Culling", &use_occlusion_culling);
+				Pipeline::Active->SetSwitch(PipelineSwitch::OCCLUSION_CULLING, use_occlusion_culling);
+
 				ImGui::Separator();
 
 				ImGui::Checkbox("Show GBuffer Window", &showGBufferWindow);
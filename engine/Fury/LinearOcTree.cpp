@@ -0,0 +1,531 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Frustum.h"
+#include "Fury/LinearOcTree.h"
+#include "Fury/Log.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	static const unsigned int INVALID_INDEX = 0xffffffff;
+
+	// inserts two zero bits between each of the lower 10 bits.
+	static unsigned int SpreadBits(unsigned int value)
+	{
+		value &= 0x3ff;
+		value = (value | (value << 16)) & 0x30000ff;
+		value = (value | (value << 8)) & 0x300f00f;
+		value = (value | (value << 4)) & 0x30c30c3;
+		value = (value | (value << 2)) & 0x9249249;
+		return value;
+	}
+
+	static unsigned int MortonCode(unsigned int x, unsigned int y, unsigned int z)
+	{
+		return SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2);
+	}
+
+	// cell to visit, planeMask is 0 when the cell is known to be inside.
+	struct CellEntry
+	{
+		unsigned int level, x, y, z, planeMask;
+	};
+
+	LinearOcTree::Ptr LinearOcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth)
+	{
+		return std::make_shared<LinearOcTree>(min, max, maxDepth);
+	}
+
+	LinearOcTree::LinearOcTree(Vector4 min, Vector4 max, unsigned int maxDepth) :
+		m_TypeIndex(typeid(LinearOcTree)), m_MaxDepth(0), m_Dirty(false)
+	{
+		Reset(min, max, maxDepth);
+	}
+
+	LinearOcTree::~LinearOcTree()
+	{
+		Clear();
+		FURYD << "LinearOcTree::~LinearOcTree";
+	}
+
+	std::type_index LinearOcTree::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	void LinearOcTree::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->m_SceneManager == this)
+		{
+			UpdateSceneNode(sceneNode);
+			return;
+		}
+
+		if (sceneNode->GetSceneManager() != nullptr)
+			sceneNode->RemoveFromOcTree(false);
+
+		unsigned int proxy;
+		if (m_FreeProxies.size() > 0)
+		{
+			proxy = m_FreeProxies.back();
+			m_FreeProxies.pop_back();
+		}
+		else
+		{
+			proxy = m_ProxyNodes.size();
+			m_ProxyNodes.push_back(INVALID_INDEX);
+		}
+
+		unsigned int index = m_SceneNodes.size();
+		m_ProxyNodes[proxy] = index;
+
+		BoxBounds aabb = sceneNode->GetWorldAABB();
+		unsigned int cell = GetCellIndex(aabb);
+
+		m_SceneNodes.push_back(sceneNode);
+		m_NodeProxies.push_back(proxy);
+		m_NodeCells.push_back(cell);
+		m_NodeUnsorted.push_back(1);
+		m_Centers.resize(m_Centers.size() + 3);
+		m_Extents.resize(m_Extents.size() + 3);
+		SetBounds(index, aabb);
+		AddCellCount(cell, 1);
+
+		sceneNode->m_SceneManager = this;
+		sceneNode->m_SceneManagerProxy = proxy;
+
+		m_Dirty = true;
+	}
+
+	void LinearOcTree::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void LinearOcTree::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->m_SceneManager != this)
+			return;
+
+		// sceneNode may refer to the slot we overwrite.
+		SceneNode::Ptr node = sceneNode;
+
+		unsigned int proxy = node->m_SceneManagerProxy;
+		unsigned int index = m_ProxyNodes[proxy];
+		unsigned int last = m_SceneNodes.size() - 1;
+
+		AddCellCount(m_NodeCells[index], -1);
+
+		// move the last scene node into the removed slot, that breaks it's order.
+		if (index != last)
+		{
+			m_SceneNodes[index] = std::move(m_SceneNodes[last]);
+			m_NodeCells[index] = m_NodeCells[last];
+			m_NodeProxies[index] = m_NodeProxies[last];
+			m_NodeUnsorted[index] = 1;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				m_Centers[index * 3 + axis] = m_Centers[last * 3 + axis];
+				m_Extents[index * 3 + axis] = m_Extents[last * 3 + axis];
+			}
+			m_ProxyNodes[m_NodeProxies[index]] = index;
+		}
+
+		m_SceneNodes.pop_back();
+		m_NodeCells.pop_back();
+		m_NodeProxies.pop_back();
+		m_NodeUnsorted.pop_back();
+		m_Centers.resize(last * 3);
+		m_Extents.resize(last * 3);
+
+		m_ProxyNodes[proxy] = INVALID_INDEX;
+		m_FreeProxies.push_back(proxy);
+
+		node->m_SceneManager = nullptr;
+		node->m_SceneManagerProxy = INVALID_INDEX;
+
+		m_Dirty = true;
+	}
+
+	void LinearOcTree::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->m_SceneManager != this)
+		{
+			AddSceneNode(sceneNode);
+			return;
+		}
+
+		unsigned int index = m_ProxyNodes[sceneNode->m_SceneManagerProxy];
+
+		BoxBounds aabb = sceneNode->GetWorldAABB();
+		SetBounds(index, aabb);
+
+		// only a cell change breaks the sorted order.
+		unsigned int cell = GetCellIndex(aabb);
+		if (cell != m_NodeCells[index])
+		{
+			AddCellCount(m_NodeCells[index], -1);
+			AddCellCount(cell, 1);
+			m_NodeCells[index] = cell;
+			m_NodeUnsorted[index] = 1;
+			m_Dirty = true;
+		}
+	}
+
+	void LinearOcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		Sort();
+
+		if (auto frustum = dynamic_cast<const Frustum*>(&collider))
+		{
+			WalkFrustum(*frustum, filterFunc);
+			return;
+		}
+
+		std::array<CellEntry, 7 * MAX_DEPTH + 1> stack;
+		size_t top = 0;
+		stack[top++] = { 0, 0, 0, 0, 1 };
+
+		while (top > 0)
+		{
+			CellEntry entry = stack[--top];
+			unsigned int code = MortonCode(entry.x, entry.y, entry.z);
+			unsigned int cell = m_LevelOffsets[entry.level] + code;
+
+			// root also holds nodes outside the tree's bounds, so it's never culled.
+			bool inside = entry.planeMask == 0;
+			if (!inside && entry.level > 0)
+			{
+				Side side = collider.IsInside(GetCellBounds(entry.level, entry.x, entry.y, entry.z));
+				if (side == Side::OUT)
+					continue;
+
+				inside = side == Side::IN;
+			}
+
+			unsigned int begin = m_CellBegins[cell];
+			unsigned int end = begin + m_CellCounts[cell];
+
+			for (unsigned int i = begin; i < end; i++)
+			{
+				if (inside)
+				{
+					filterFunc(m_SceneNodes[i]);
+				}
+				else
+				{
+					Vector4 center(m_Centers[i * 3], m_Centers[i * 3 + 1], m_Centers[i * 3 + 2]);
+					Vector4 extents(m_Extents[i * 3], m_Extents[i * 3 + 1], m_Extents[i * 3 + 2]);
+					if (collider.IsInsideFast(BoxBounds(center - extents, center + extents)))
+						filterFunc(m_SceneNodes[i]);
+				}
+			}
+
+			if (entry.level == m_MaxDepth)
+				continue;
+
+			unsigned int childOffset = m_LevelOffsets[entry.level + 1] + code * 8;
+			for (unsigned int i = 0; i < 8; i++)
+			{
+				if (m_CellTotals[childOffset + i] > 0)
+				{
+					stack[top++] = { entry.level + 1, entry.x * 2 + (i & 1), entry.y * 2 + ((i >> 1) & 1),
+						entry.z * 2 + (i >> 2), inside ? 0u : 1u };
+				}
+			}
+		}
+	}
+
+	void LinearOcTree::WalkFrustum(const Frustum &frustum, const FilterFunc &filterFunc) const
+	{
+		std::array<CellEntry, 7 * MAX_DEPTH + 1> stack;
+		size_t top = 0;
+		stack[top++] = { 0, 0, 0, 0, Frustum::ALL_PLANES };
+
+		std::vector<uint8_t> visibleMask;
+
+		while (top > 0)
+		{
+			CellEntry entry = stack[--top];
+			unsigned int code = MortonCode(entry.x, entry.y, entry.z);
+			unsigned int cell = m_LevelOffsets[entry.level] + code;
+
+			// childs only test planes their parent straddles.
+			unsigned int planeMask = entry.planeMask;
+			if (planeMask != 0 && entry.level > 0 &&
+				frustum.IsInside(GetCellBounds(entry.level, entry.x, entry.y, entry.z), planeMask) == Side::OUT)
+				continue;
+
+			unsigned int begin = m_CellBegins[cell];
+			unsigned int count = m_CellCounts[cell];
+
+			if (planeMask == 0)
+			{
+				for (unsigned int i = 0; i < count; i++)
+					filterFunc(m_SceneNodes[begin + i]);
+			}
+			else if (count > 0)
+			{
+				visibleMask.resize(count);
+				frustum.CullAABBs(&m_Centers[begin * 3], &m_Extents[begin * 3], count, visibleMask.data(), planeMask);
+
+				for (unsigned int i = 0; i < count; i++)
+				{
+					if (visibleMask[i])
+						filterFunc(m_SceneNodes[begin + i]);
+				}
+			}
+
+			if (entry.level == m_MaxDepth)
+				continue;
+
+			unsigned int childOffset = m_LevelOffsets[entry.level + 1] + code * 8;
+			for (unsigned int i = 0; i < 8; i++)
+			{
+				if (m_CellTotals[childOffset + i] > 0)
+				{
+					stack[top++] = { entry.level + 1, entry.x * 2 + (i & 1), entry.y * 2 + ((i >> 1) & 1),
+						entry.z * 2 + (i >> 2), planeMask };
+				}
+			}
+		}
+	}
+
+	void LinearOcTree::Reset(Vector4 min, Vector4 max, unsigned int maxDepth)
+	{
+		Clear();
+
+		if (maxDepth > MAX_DEPTH)
+		{
+			FURYW << "LinearOcTree depth " << maxDepth << " clamped to " << MAX_DEPTH << "!";
+			maxDepth = MAX_DEPTH;
+		}
+
+		m_MaxDepth = maxDepth;
+		m_Min = { min.x, min.y, min.z };
+		m_Max = { max.x, max.y, max.z };
+
+		float resolution = (float)(1 << maxDepth);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float size = m_Max[axis] - m_Min[axis];
+			m_InvLeafSize[axis] = size > 0.0f ? resolution / size : 0.0f;
+		}
+
+		unsigned int cellCount = 0;
+		m_LevelOffsets.clear();
+		for (unsigned int level = 0; level <= maxDepth; level++)
+		{
+			m_LevelOffsets.push_back(cellCount);
+			cellCount += 1 << (3 * level);
+		}
+
+		m_CellBegins.assign(cellCount, 0);
+		m_CellCounts.assign(cellCount, 0);
+		m_CellTotals.assign(cellCount, 0);
+	}
+
+	void LinearOcTree::Clear()
+	{
+		for (auto &sceneNode : m_SceneNodes)
+		{
+			sceneNode->m_SceneManager = nullptr;
+			sceneNode->m_SceneManagerProxy = INVALID_INDEX;
+		}
+
+		m_SceneNodes.clear();
+		m_NodeCells.clear();
+		m_NodeProxies.clear();
+		m_NodeUnsorted.clear();
+		m_Centers.clear();
+		m_Extents.clear();
+		m_ProxyNodes.clear();
+		m_FreeProxies.clear();
+
+		std::fill(m_CellCounts.begin(), m_CellCounts.end(), 0);
+		std::fill(m_CellTotals.begin(), m_CellTotals.end(), 0);
+		m_Dirty = false;
+	}
+
+	size_t LinearOcTree::GetSceneNodeCount() const
+	{
+		return m_SceneNodes.size();
+	}
+
+	unsigned int LinearOcTree::GetCellCount() const
+	{
+		return m_CellTotals.size();
+	}
+
+	unsigned int LinearOcTree::GetCellIndex(const BoxBounds &aabb) const
+	{
+		if (aabb.GetInfinite())
+			return 0;
+
+		Vector4 min = aabb.GetMin();
+		Vector4 max = aabb.GetMax();
+		float boxMin[3] = { min.x, min.y, min.z };
+		float boxMax[3] = { max.x, max.y, max.z };
+
+		unsigned int resolution = 1 << m_MaxDepth;
+		unsigned int low[3], high[3];
+		float size[3];
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (boxMin[axis] < m_Min[axis] || boxMax[axis] > m_Max[axis])
+				return 0;
+
+			// in units of the deepest cells.
+			low[axis] = std::min((unsigned int)((boxMin[axis] - m_Min[axis]) * m_InvLeafSize[axis]), resolution - 1);
+			high[axis] = std::min((unsigned int)((boxMax[axis] - m_Min[axis]) * m_InvLeafSize[axis]), resolution - 1);
+			size[axis] = (boxMax[axis] - boxMin[axis]) * m_InvLeafSize[axis];
+		}
+
+		for (unsigned int level = m_MaxDepth; level > 0; level--)
+		{
+			unsigned int shift = m_MaxDepth - level;
+
+			// like OcTree, a cell only takes nodes no larger than half of it.
+			float halfCellSize = (float)(1 << shift) * 0.5f;
+
+			bool fit = true;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if ((low[axis] >> shift) != (high[axis] >> shift) || size[axis] > halfCellSize)
+				{
+					fit = false;
+					break;
+				}
+			}
+
+			if (fit)
+				return m_LevelOffsets[level] + MortonCode(low[0] >> shift, low[1] >> shift, low[2] >> shift);
+		}
+
+		return 0;
+	}
+
+	BoxBounds LinearOcTree::GetCellBounds(unsigned int level, unsigned int x, unsigned int y, unsigned int z) const
+	{
+		float scale = 1.0f / (float)(1 << level);
+		float size[3];
+		for (int axis = 0; axis < 3; axis++)
+			size[axis] = (m_Max[axis] - m_Min[axis]) * scale;
+
+		Vector4 min(m_Min[0] + x * size[0], m_Min[1] + y * size[1], m_Min[2] + z * size[2]);
+		return BoxBounds(min, min + Vector4(size[0], size[1], size[2]));
+	}
+
+	void LinearOcTree::SetBounds(unsigned int index, const BoxBounds &aabb)
+	{
+		Frustum::PackAABB(aabb, &m_Centers[index * 3], &m_Extents[index * 3]);
+	}
+
+	void LinearOcTree::AddCellCount(unsigned int cell, int delta)
+	{
+		m_CellCounts[cell] += delta;
+
+		unsigned int level = m_MaxDepth;
+		while (cell < m_LevelOffsets[level])
+			level--;
+
+		unsigned int code = cell - m_LevelOffsets[level];
+		m_CellTotals[cell] += delta;
+
+		while (level > 0)
+		{
+			level--;
+			code >>= 3;
+			m_CellTotals[m_LevelOffsets[level] + code] += delta;
+		}
+	}
+
+	void LinearOcTree::Sort() const
+	{
+		std::lock_guard<std::mutex> lock(m_SortMutex);
+
+		if (!m_Dirty)
+			return;
+
+		size_t count = m_SceneNodes.size();
+
+		// sorted scene nodes keep their order, only the unsorted ones are sorted by cell, then both are merged.
+		std::vector<unsigned int> sorted, unsorted;
+		sorted.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			if (m_NodeUnsorted[i])
+				unsorted.push_back(i);
+			else
+				sorted.push_back(i);
+		}
+
+		auto byCell = [this](unsigned int a, unsigned int b)
+		{
+			return m_NodeCells[a] < m_NodeCells[b];
+		};
+
+		std::stable_sort(unsorted.begin(), unsorted.end(), byCell);
+
+		std::vector<unsigned int> order(count);
+		std::merge(sorted.begin(), sorted.end(), unsorted.begin(), unsorted.end(), order.begin(), byCell);
+
+		for (auto i : unsorted)
+			m_NodeUnsorted[i] = 0;
+
+		// scene nodes before the first and after the last moved slot stay where they are.
+		size_t first = 0, last = count;
+		while (first < last && order[first] == first)
+			first++;
+		while (last > first && order[last - 1] == last - 1)
+			last--;
+
+		size_t span = last - first;
+
+		SceneNodes sceneNodes(span);
+		std::vector<unsigned int> nodeCells(span), nodeProxies(span);
+		std::vector<float> centers(span * 3), extents(span * 3);
+
+		for (size_t i = 0; i < span; i++)
+		{
+			unsigned int from = order[first + i];
+			sceneNodes[i] = std::move(m_SceneNodes[from]);
+			nodeCells[i] = m_NodeCells[from];
+			nodeProxies[i] = m_NodeProxies[from];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				centers[i * 3 + axis] = m_Centers[from * 3 + axis];
+				extents[i * 3 + axis] = m_Extents[from * 3 + axis];
+			}
+		}
+
+		for (size_t i = 0; i < span; i++)
+		{
+			size_t to = first + i;
+			m_SceneNodes[to] = std::move(sceneNodes[i]);
+			m_NodeCells[to] = nodeCells[i];
+			m_NodeProxies[to] = nodeProxies[i];
+			m_ProxyNodes[nodeProxies[i]] = to;
+		}
+
+		std::copy(centers.begin(), centers.end(), m_Centers.begin() + first * 3);
+		std::copy(extents.begin(), extents.end(), m_Extents.begin() + first * 3);
+
+		// counts are kept up to date, only cells holding nodes need their begin.
+		// the run right after the span may have lost it's head to it.
+		size_t end = std::min(last + 1, count);
+		for (size_t i = first; i < end; i++)
+		{
+			if (i == 0 || m_NodeCells[i] != m_NodeCells[i - 1])
+				m_CellBegins[m_NodeCells[i]] = i;
+		}
+
+		m_Dirty = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef _FURY_LINEAR_OCTREE_H_
+#define _FURY_LINEAR_OCTREE_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+#include "Fury/SceneManager.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	class Frustum;
+
+	// Pointer free octree, an alternative to OcTree.
+	// All cells of all levels live in one array, cells of a level are ordered by morton code,
+	// so childs of cell (level, code) are (level + 1, code * 8 + i) and no links are stored.
+	// Scene nodes are kept in packed arrays sorted by cell, with their world aabb as center/extents triples.
+	// Moving a node inside it's cell only rewrites it's bounds. Cell counts follow cell changes right away,
+	// the nodes that changed cell are sorted and merged into the others lazily before the next query.
+	class FURY_API LinearOcTree : public SceneManager, public std::enable_shared_from_this<LinearOcTree>
+	{
+	public:
+
+		typedef std::shared_ptr<LinearOcTree> Ptr;
+
+		// cells are allocated for every level, so depth is limited.
+		static const unsigned int MAX_DEPTH = 7;
+
+		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth);
+
+	protected:
+
+		std::type_index m_TypeIndex;
+
+		std::array<float, 3> m_Min;
+
+		std::array<float, 3> m_Max;
+
+		// 1 / size of deepest cells.
+		std::array<float, 3> m_InvLeafSize;
+
+		unsigned int m_MaxDepth;
+
+		// first cell of each level.
+		std::vector<unsigned int> m_LevelOffsets;
+
+		// scene node count of each cell.
+		std::vector<unsigned int> m_CellCounts;
+
+		// scene node count of each cell, including it's descendants.
+		std::vector<unsigned int> m_CellTotals;
+
+		// scene node data below is reordered by cell lazily in const queries, so it's mutable.
+
+		// scene nodes of cell i are [m_CellBegins[i], m_CellBegins[i] + m_CellCounts[i]) after sorting,
+		// only written for cells holding nodes.
+		mutable std::vector<unsigned int> m_CellBegins;
+
+		mutable SceneNodes m_SceneNodes;
+
+		mutable std::vector<unsigned int> m_NodeCells;
+
+		mutable std::vector<unsigned int> m_NodeProxies;
+
+		// 1 if the scene node was added, changed cell or was moved by a removal since the last sort.
+		mutable std::vector<uint8_t> m_NodeUnsorted;
+
+		// xyz triples of each scene node's world aabb.
+		mutable std::vector<float> m_Centers;
+
+		mutable std::vector<float> m_Extents;
+
+		// proxy -> index of scene node
+		mutable std::vector<unsigned int> m_ProxyNodes;
+
+		std::vector<unsigned int> m_FreeProxies;
+
+		mutable bool m_Dirty;
+
+		mutable std::mutex m_SortMutex;
+
+	public:
+
+		LinearOcTree(Vector4 min, Vector4 max, unsigned int maxDepth);
+
+		~LinearOcTree();
+
+		virtual std::type_index GetTypeIndex() const;
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const;
+
+		virtual void Reset(Vector4 min, Vector4 max, unsigned int maxDepth);
+
+		virtual void Clear();
+
+		size_t GetSceneNodeCount() const;
+
+		unsigned int GetCellCount() const;
+
+	protected:
+
+		// finds the deepest cell that fits aabb, nodes outside the tree's bounds belong to root.
+		unsigned int GetCellIndex(const BoxBounds &aabb) const;
+
+		BoxBounds GetCellBounds(unsigned int level, unsigned int x, unsigned int y, unsigned int z) const;
+
+		void SetBounds(unsigned int index, const BoxBounds &aabb);
+
+		// adds delta to cell's count and to the totals of it and it's ancestors.
+		void AddCellCount(unsigned int cell, int delta);
+
+		// sorts unsorted scene nodes by cell and merges them with the others, if there are any.
+		void Sort() const;
+
+		void WalkFrustum(const Frustum &frustum, const FilterFunc &filterFunc) const;
+	};
+}
+
+#endif // _FURY_LINEAR_OCTREE_H_
\ No newline at end of file
@@ -38,4 +38,22 @@ do {} while (false)
 
 #define FURY_MIPMAP_LEVEL 5
 
+// simd backend is selected at compile time, define FURY_SIMD_DISABLE to force scalar math.
+#if !defined(FURY_SIMD_DISABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define FURY_SIMD_SSE
+#elif !defined(FURY_SIMD_DISABLE) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define FURY_SIMD_NEON
+#endif
+
+// 32bit msvc can't pass aligned types by value, so only align on other targets.
+#if (defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)) && !(defined(_MSC_VER) && !defined(_WIN64))
+	#ifdef _MSC_VER
+		#define FURY_SIMD_ALIGN __declspec(align(16))
+	#else
+		#define FURY_SIMD_ALIGN alignas(16)
+	#endif
+#else
+	#define FURY_SIMD_ALIGN
+#endif
+
 #endif // _FURY_MACROS_H_
\ No newline at end of file
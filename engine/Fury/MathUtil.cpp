@@ -1,4 +1,5 @@
 #include <cmath>
+#include <cstring>
 
 #include "Fury/MathUtil.h"
 #include "Fury/SceneNode.h"
@@ -144,4 +145,81 @@ namespace fury
 
 		return false;
 	}
+
+	uint16_t MathUtil::FloatToHalf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		uint32_t sign = (bits >> 16) & 0x8000;
+		uint32_t mantissa = bits & 0x7fffff;
+		int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+
+		// inf and nan.
+		if (((bits >> 23) & 0xff) == 0xff)
+			return (uint16_t)(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+
+		if (exponent >= 31)
+			return (uint16_t)(sign | 0x7c00);
+
+		// denormal, or too small for half.
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return (uint16_t)sign;
+
+			mantissa |= 0x800000;
+			unsigned int shift = 14 - exponent;
+			uint32_t half = mantissa >> shift;
+			if ((mantissa >> (shift - 1)) & 1)
+				half++;
+
+			return (uint16_t)(sign | half);
+		}
+
+		// rounding may carry into exponent, which is still the right result.
+		uint32_t half = sign | (exponent << 10) | (mantissa >> 13);
+		if (mantissa & 0x1000)
+			half++;
+
+		return (uint16_t)half;
+	}
+
+	float MathUtil::HalfToFloat(uint16_t value)
+	{
+		uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+		uint32_t exponent = (value >> 10) & 0x1f;
+		uint32_t mantissa = value & 0x3ff;
+		uint32_t bits;
+
+		if (exponent == 0)
+		{
+			float result = std::ldexp((float)mantissa, -24);
+			return sign != 0 ? -result : result;
+		}
+		else if (exponent == 31)
+		{
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		}
+		else
+		{
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		}
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	uint32_t MathUtil::PackSnorm1010102(float x, float y, float z, float w)
+	{
+		auto pack = [](float value, float scale, uint32_t mask) -> uint32_t
+		{
+			value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+			return (uint32_t)(int32_t)std::round(value * scale) & mask;
+		};
+
+		return pack(x, 511.0f, 0x3ff) | (pack(y, 511.0f, 0x3ff) << 10) |
+			(pack(z, 511.0f, 0x3ff) << 20) | (pack(w, 1.0f, 0x3) << 30);
+	}
 }
\ No newline at end of file
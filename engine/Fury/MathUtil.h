@@ -1,6 +1,7 @@
 #ifndef _FURY_MATHUTIL_H_
 #define _FURY_MATHUTIL_H_
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -47,6 +48,14 @@ namespace fury
 
 		static bool PointInCone(Vector4 coneCenter, Vector4 coneDir, float height, float theta, Vector4 point);
 
+		// ieee half float, rounded to nearest.
+		static uint16_t FloatToHalf(float value);
+
+		static float HalfToFloat(uint16_t value);
+
+		// signed normalized GL_INT_2_10_10_10_REV, x in the lowest bits.
+		static uint32_t PackSnorm1010102(float x, float y, float z, float w = 0.0f);
+
 	};
 }
 
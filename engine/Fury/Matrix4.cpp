@@ -5,6 +5,7 @@
 #include "Fury/Matrix4.h"
 #include "Fury/Plane.h"
 #include "Fury/Quaternion.h"
+#include "Fury/Simd.h"
 
 namespace fury
 {
@@ -13,6 +14,107 @@ namespace fury
 	std::string Matrix4::INVERT_VIEW_MATRIX = "invert_view_matrix";
 
 	std::string Matrix4::WORLD_MATRIX = "world_matrix";
+
+	std::string Matrix4::INSTANCE_MATRIX = "instance_matrix";
+
+	const size_t Matrix4::PROJECTION_MATRIX_HASH = std::hash<std::string>()(PROJECTION_MATRIX);
+
+	const size_t Matrix4::INVERT_VIEW_MATRIX_HASH = std::hash<std::string>()(INVERT_VIEW_MATRIX);
+
+	const size_t Matrix4::WORLD_MATRIX_HASH = std::hash<std::string>()(WORLD_MATRIX);
+
+	// simd kernels keep the scalar operation order and use no fused multiply-add,
+	// so both paths produce identical results.
+
+	void Matrix4::TransformPoints(const Matrix4 &matrix, const float *input, float *output, size_t count)
+	{
+		const float *m = matrix.Raw;
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		simd::Float4 c0 = simd::Load(m), c1 = simd::Load(m + 4), c2 = simd::Load(m + 8), c3 = simd::Load(m + 12);
+		float result[4];
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			simd::Float4 r = simd::Mul(c0, simd::Splat(input[i]));
+			r = simd::Add(r, simd::Mul(c1, simd::Splat(input[i + 1])));
+			r = simd::Add(r, simd::Mul(c2, simd::Splat(input[i + 2])));
+			r = simd::Add(r, c3);
+			simd::Store(result, r);
+			output[i] = result[0];
+			output[i + 1] = result[1];
+			output[i + 2] = result[2];
+		}
+#else
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			float x = input[i], y = input[i + 1], z = input[i + 2];
+			output[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+			output[i + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+			output[i + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+		}
+#endif
+	}
+
+	void Matrix4::TransformVectors(const Matrix4 &matrix, const float *input, float *output, size_t count)
+	{
+		const float *m = matrix.Raw;
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		simd::Float4 c0 = simd::Load(m), c1 = simd::Load(m + 4), c2 = simd::Load(m + 8);
+		float result[4];
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			simd::Float4 r = simd::Mul(c0, simd::Splat(input[i]));
+			r = simd::Add(r, simd::Mul(c1, simd::Splat(input[i + 1])));
+			r = simd::Add(r, simd::Mul(c2, simd::Splat(input[i + 2])));
+			simd::Store(result, r);
+			output[i] = result[0];
+			output[i + 1] = result[1];
+			output[i + 2] = result[2];
+		}
+#else
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			float x = input[i], y = input[i + 1], z = input[i + 2];
+			output[i] = x * m[0] + y * m[4] + z * m[8];
+			output[i + 1] = x * m[1] + y * m[5] + z * m[9];
+			output[i + 2] = x * m[2] + y * m[6] + z * m[10];
+		}
+#endif
+	}
+
+	void Matrix4::TransformAABBs(const Matrix4 &matrix, const float *centers, const float *extents,
+		float *outCenters, float *outExtents, size_t count)
+	{
+		// new extents are the old extents projected on the absolute matrix axes (Arvo's method).
+		TransformPoints(matrix, centers, outCenters, count);
+
+		const float *m = matrix.Raw;
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		simd::Float4 a0 = simd::Abs(simd::Load(m)), a1 = simd::Abs(simd::Load(m + 4)), a2 = simd::Abs(simd::Load(m + 8));
+		float result[4];
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			simd::Float4 r = simd::Mul(a0, simd::Splat(extents[i]));
+			r = simd::Add(r, simd::Mul(a1, simd::Splat(extents[i + 1])));
+			r = simd::Add(r, simd::Mul(a2, simd::Splat(extents[i + 2])));
+			simd::Store(result, r);
+			outExtents[i] = result[0];
+			outExtents[i + 1] = result[1];
+			outExtents[i + 2] = result[2];
+		}
+#else
+		float a[12];
+		for (int i = 0; i < 12; i++)
+			a[i] = std::abs(m[i]);
+
+		for (size_t i = 0; i < count * 3; i += 3)
+		{
+			float x = extents[i], y = extents[i + 1], z = extents[i + 2];
+			outExtents[i] = x * a[0] + y * a[4] + z * a[8];
+			outExtents[i + 1] = x * a[1] + y * a[5] + z * a[9];
+			outExtents[i + 2] = x * a[2] + y * a[6] + z * a[10];
+		}
+#endif
+	}
 	
 	Matrix4::Matrix4()
 	{
@@ -185,14 +287,25 @@ namespace fury
 		return Matrix4(data);
 	}
 
-	Vector4 Matrix4::Multiply(Vector4 data) const
+	Vector4 Matrix4::Multiply(const Vector4 &data) const
 	{
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		simd::Float4 r = simd::Mul(simd::Load(Raw), simd::Splat(data.x));
+		r = simd::Add(r, simd::Mul(simd::Load(Raw + 4), simd::Splat(data.y)));
+		r = simd::Add(r, simd::Mul(simd::Load(Raw + 8), simd::Splat(data.z)));
+		r = simd::Add(r, simd::Mul(simd::Load(Raw + 12), simd::Splat(data.w)));
+
+		Vector4 output;
+		simd::Store(&output.x, r);
+		return output;
+#else
 		return Vector4(
 			data.x * Raw[0] + data.y * Raw[4] + data.z * Raw[8] + data.w * Raw[12],
 			data.x * Raw[1] + data.y * Raw[5] + data.z * Raw[9] + data.w * Raw[13],
 			data.x * Raw[2] + data.y * Raw[6] + data.z * Raw[10] + data.w * Raw[14],
 			data.x * Raw[3] + data.y * Raw[7] + data.z * Raw[11] + data.w * Raw[15]
 		);
+#endif
 	}
 
 	Quaternion Matrix4::Multiply(Quaternion data) const
@@ -208,39 +321,14 @@ namespace fury
 
 	BoxBounds Matrix4::Multiply(const BoxBounds &aabb) const
 	{
-		Vector4 max = aabb.GetMax();
-		Vector4 min = aabb.GetMin();
-
-		Vector4 vertices[] = {
-			Multiply(Vector4(min, 1.0f)),
-			Multiply(Vector4(max.x, min.y, min.z, 1.0f)),
-			Multiply(Vector4(min.x, max.y, min.z, 1.0f)),
-			Multiply(Vector4(max.x, max.y, min.z, 1.0f)),
-			Multiply(Vector4(min.x, min.y, max.z, 1.0f)),
-			Multiply(Vector4(max.x, min.y, max.z, 1.0f)),
-			Multiply(Vector4(min.x, max.y, max.z, 1.0f)),
-			Multiply(Vector4(max, 1.0f))
-		};
-
-		max = min = vertices[0];
+		if (aabb.GetInfinite())
+			return aabb;
 
-		for (Vector4 &vt : vertices)
-		{
-			if (vt.x > max.x)
-				max.x = vt.x;
-			if (vt.x < min.x)
-				min.x = vt.x;
-			if (vt.y > max.y)
-				max.y = vt.y;
-			if (vt.y < min.y)
-				min.y = vt.y;
-			if (vt.z > max.z)
-				max.z = vt.z;
-			if (vt.z < min.z)
-				min.z = vt.z;
-		}
+		Vector4 center = aabb.GetCenter();
+		Vector4 extents = aabb.GetExtents();
+		TransformAABBs(*this, &center.x, &extents.x, &center.x, &extents.x, 1);
 
-		return BoxBounds(min, max);
+		return BoxBounds(center - extents, center + extents);
 	}
 
 	Plane Matrix4::Multiply(const Plane &data) const
@@ -254,7 +342,46 @@ namespace fury
 	Matrix4 Matrix4::Inverse() const
 	{
 		Matrix4 output;
-		
+
+#if defined(FURY_SIMD_SSE)
+		// rows of the 3x3 inverse are cross products of the columns.
+		auto Cross = [](__m128 a, __m128 b) -> __m128
+		{
+			__m128 ayzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 azxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+			__m128 byzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 bzxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+			return _mm_sub_ps(_mm_mul_ps(ayzx, bzxy), _mm_mul_ps(azxy, byzx));
+		};
+
+		__m128 c0 = _mm_loadu_ps(Raw), c1 = _mm_loadu_ps(Raw + 4), c2 = _mm_loadu_ps(Raw + 8);
+		__m128 r0 = Cross(c1, c2), r1 = Cross(c2, c0), r2 = Cross(c0, c1), r3 = _mm_setzero_ps();
+
+		float row[4];
+		_mm_storeu_ps(row, r0);
+		float det = Raw[0] * row[0] + Raw[1] * row[1] + Raw[2] * row[2];
+		if (det != 0)
+		{
+			__m128 det2 = _mm_set1_ps(1.0f / det);
+			r0 = _mm_mul_ps(r0, det2);
+			r1 = _mm_mul_ps(r1, det2);
+			r2 = _mm_mul_ps(r2, det2);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			__m128 t = _mm_mul_ps(r0, _mm_set1_ps(Raw[12]));
+			t = _mm_add_ps(t, _mm_mul_ps(r1, _mm_set1_ps(Raw[13])));
+			t = _mm_add_ps(t, _mm_mul_ps(r2, _mm_set1_ps(Raw[14])));
+			// flip sign bits, 0 - t would turn scalar path's -0 into +0.
+			t = _mm_xor_ps(t, _mm_set1_ps(-0.0f));
+
+			_mm_storeu_ps(output.Raw, r0);
+			_mm_storeu_ps(output.Raw + 4, r1);
+			_mm_storeu_ps(output.Raw + 8, r2);
+			_mm_storeu_ps(output.Raw + 12, t);
+			output.Raw[3] = output.Raw[7] = output.Raw[11] = 0.0f;
+			output.Raw[15] = 1.0f;
+		}
+#else
 		float det = Raw[0] * (Raw[5] * Raw[10] - Raw[6] * Raw[9])
 					+ Raw[1] * (Raw[6] * Raw[8] - Raw[4] * Raw[10])
 					+ Raw[2] * (Raw[4] * Raw[9] - Raw[5] * Raw[8]);
@@ -278,7 +405,8 @@ namespace fury
 			output.Raw[14] = -(Raw[12] * output.Raw[2] + Raw[13] * output.Raw[6] + Raw[14] * output.Raw[10]);
 			output.Raw[15] = 1.0f;
 		}
-		
+#endif
+
 		return output;
 	}
 
@@ -317,7 +445,18 @@ namespace fury
 	Matrix4 Matrix4::operator * (const Matrix4 &other) const
 	{
 		Matrix4 output;
-		
+
+#if defined(FURY_SIMD_SSE) || defined(FURY_SIMD_NEON)
+		simd::Float4 c0 = simd::Load(Raw), c1 = simd::Load(Raw + 4), c2 = simd::Load(Raw + 8), c3 = simd::Load(Raw + 12);
+		for (int i = 0; i < 16; i += 4)
+		{
+			simd::Float4 r = simd::Mul(c0, simd::Splat(other.Raw[i]));
+			r = simd::Add(r, simd::Mul(c1, simd::Splat(other.Raw[i + 1])));
+			r = simd::Add(r, simd::Mul(c2, simd::Splat(other.Raw[i + 2])));
+			r = simd::Add(r, simd::Mul(c3, simd::Splat(other.Raw[i + 3])));
+			simd::Store(output.Raw + i, r);
+		}
+#else
 		output.Raw[0] = Raw[0] * other.Raw[0] + Raw[4] * other.Raw[1] + Raw[8]	* other.Raw[2] + Raw[12] * other.Raw[3];
 		output.Raw[1] = Raw[1] * other.Raw[0] + Raw[5] * other.Raw[1] + Raw[9]	* other.Raw[2] + Raw[13] * other.Raw[3];
 		output.Raw[2] = Raw[2] * other.Raw[0] + Raw[6] * other.Raw[1] + Raw[10] * other.Raw[2] + Raw[14] * other.Raw[3];
@@ -337,7 +476,8 @@ namespace fury
 		output.Raw[13] = Raw[1] * other.Raw[12] + Raw[5] * other.Raw[13] + Raw[9] * other.Raw[14] + Raw[13] * other.Raw[15];
 		output.Raw[14] = Raw[2] * other.Raw[12] + Raw[6] * other.Raw[13] + Raw[10] * other.Raw[14] + Raw[14] * other.Raw[15];
 		output.Raw[15] = Raw[3] * other.Raw[12] + Raw[7] * other.Raw[13] + Raw[11] * other.Raw[14] + Raw[15] * other.Raw[15];
-		
+#endif
+
 		return output;
 	}
 }
\ No newline at end of file
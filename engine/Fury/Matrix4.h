@@ -1,6 +1,7 @@
 #ifndef _FURY_MATRIX4_H_
 #define _FURY_MATRIX4_H_
 
+#include <cstddef>
 #include <string>
 #include <initializer_list>
 
@@ -33,7 +34,27 @@ namespace fury
 
 		static std::string WORLD_MATRIX;
 
-		float Raw[16];
+		// per instance world matrix attribute of instanced shaders.
+		static std::string INSTANCE_MATRIX;
+
+		// std::hash of the uniform names above, for Shader's lookups by hash.
+		static const size_t PROJECTION_MATRIX_HASH;
+
+		static const size_t INVERT_VIEW_MATRIX_HASH;
+
+		static const size_t WORLD_MATRIX_HASH;
+
+		// batched transforms over tightly packed xyz triples, input and output can be the same array.
+		static void TransformPoints(const Matrix4 &matrix, const float *input, float *output, size_t count);
+
+		// same as TransformPoints, but ignores translation.
+		static void TransformVectors(const Matrix4 &matrix, const float *input, float *output, size_t count);
+
+		// transforms aabbs stored as center and extents xyz triples.
+		static void TransformAABBs(const Matrix4 &matrix, const float *centers, const float *extents,
+			float *outCenters, float *outExtents, size_t count);
+
+		FURY_SIMD_ALIGN float Raw[16];
 
 		Matrix4();
 
@@ -75,7 +96,7 @@ namespace fury
 
 		Matrix4 Transpose() const;
 
-		Vector4 Multiply(Vector4 data) const;
+		Vector4 Multiply(const Vector4 &data) const;
 
 		Quaternion Multiply(Quaternion data) const;
 
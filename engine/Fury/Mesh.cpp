@@ -1,9 +1,16 @@
+#include <algorithm>
+#include <cstring>
 #include <stack>
 
+#include "Fury/BufferManager.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
+#include "Fury/MathUtil.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
 #include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
 #include "Fury/Joint.h"
 
 namespace fury
@@ -36,6 +43,7 @@ namespace fury
 
 		if (m_VAO != 0)
 		{
+			GLState::OnDeleteVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -54,6 +62,7 @@ namespace fury
 
 		if (m_VAO != 0)
 		{
+			GLState::OnDeleteVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -66,6 +75,11 @@ namespace fury
 		Indices.Data.clear();
 	}
 
+	unsigned int SubMesh::GetPoolFirstIndex() const
+	{
+		return m_PoolFirstIndex;
+	}
+
 	std::type_index SubMesh::GetTypeIndex() const
 	{
 		return m_TypeIndex;
@@ -79,6 +93,7 @@ namespace fury
 	}
 
 	Mesh::Mesh(const std::string &name) : Entity(name), m_VAO(0),
+		m_Vertices("vertex_data", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		Indices("vertex_index", GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW),
 		Positions("vertex_position", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		Normals("vertex_normal", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
@@ -129,6 +144,10 @@ namespace fury
 
 		LoadMemberValue(wrapper, "cast_shadows", m_CastShadows);
 
+		std::string str;
+		if (LoadMemberValue(wrapper, "vertex_layout", str))
+			SetVertexLayout(EnumUtil::VertexLayoutFromString(str));
+
 		// model aabb
 		LoadMemberValue(wrapper, "aabb", m_AABB);
 
@@ -163,6 +182,12 @@ namespace fury
 		SaveKey(wrapper, "cast_shadows");
 		SaveValue(wrapper, m_CastShadows);
 
+		if (m_VertexLayout != VertexLayout::SEPARATE)
+		{
+			SaveKey(wrapper, "vertex_layout");
+			SaveValue(wrapper, EnumUtil::VertexLayoutToString(m_VertexLayout));
+		}
+
 		SaveKey(wrapper, "positions");
 		SaveArray(wrapper, Positions.Data);
 
@@ -253,18 +278,33 @@ namespace fury
 
 	void Mesh::UpdateBuffer()
 	{
-		Positions.UpdateBuffer();
-		Normals.UpdateBuffer();
-		Tangents.UpdateBuffer();
-		UVs.UpdateBuffer();
-		Weights.UpdateBuffer();
-		IDs.UpdateBuffer();
+		// pooled copy is stale now, MeshPool::Add copies the new data on next use.
+		if (m_PoolPage != -1 && MeshPool::HasInstance())
+			MeshPool::Instance()->Remove(this);
+
+		bool packed = GetVertexPacked();
+		if (packed)
+		{
+			UpdatePackedVertices();
+		}
+		else
+		{
+			m_Vertices.DeleteBuffer();
+
+			Positions.UpdateBuffer();
+			Normals.UpdateBuffer();
+			Tangents.UpdateBuffer();
+			UVs.UpdateBuffer();
+			Weights.UpdateBuffer();
+			IDs.UpdateBuffer();
+		}
 		Indices.UpdateBuffer();
 
-		m_Dirty = Indices.GetDirty() || Positions.GetDirty();
+		m_Dirty = Indices.GetDirty() || (packed ? m_Vertices.GetDirty() : Positions.GetDirty());
 
 		if (m_VAO != 0)
 		{
+			GLState::OnDeleteVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -281,17 +321,270 @@ namespace fury
 				if (subMesh != nullptr)
 					subMesh->UpdateBuffer();
 		}
+
+		UpdateMemory();
+	}
+
+	void Mesh::UpdateDirtyRanges()
+	{
+		if (m_PoolPage != -1 && MeshPool::HasInstance() && HasDirtyRanges())
+			MeshPool::Instance()->Remove(this);
+
+		if (GetVertexPacked())
+		{
+			// packed vertices are rebuilt as a whole.
+			if (Positions.HasDirtyRanges() || Normals.HasDirtyRanges() || Tangents.HasDirtyRanges() ||
+				UVs.HasDirtyRanges() || Weights.HasDirtyRanges() || IDs.HasDirtyRanges())
+				UpdatePackedVertices();
+		}
+		else if (Positions.HasDirtyRanges())
+			Positions.UpdateBuffer();
+
+		if (Normals.HasDirtyRanges())
+			Normals.UpdateBuffer();
+
+		if (Tangents.HasDirtyRanges())
+			Tangents.UpdateBuffer();
+
+		if (UVs.HasDirtyRanges())
+			UVs.UpdateBuffer();
+
+		if (Weights.HasDirtyRanges())
+			Weights.UpdateBuffer();
+
+		if (IDs.HasDirtyRanges())
+			IDs.UpdateBuffer();
+
+		// element buffer binding is vao state, unbind so the bound vao keeps it's indices.
+		if (Indices.HasDirtyRanges())
+		{
+			GLState::BindVertexArray(0);
+			Indices.UpdateBuffer();
+		}
+	}
+
+	bool Mesh::HasDirtyRanges() const
+	{
+		if (Positions.HasDirtyRanges() || Normals.HasDirtyRanges() || Tangents.HasDirtyRanges() || UVs.HasDirtyRanges() || 
+			Weights.HasDirtyRanges() || IDs.HasDirtyRanges() || Indices.HasDirtyRanges())
+			return true;
+
+		for (auto subMesh : m_SubMeshes)
+			if (subMesh != nullptr && (subMesh->GetDirty() || subMesh->Indices.HasDirtyRanges()))
+				return true;
+
+		return false;
+	}
+
+	void Mesh::SetVertexLayout(VertexLayout layout)
+	{
+		if (m_VertexLayout != layout)
+		{
+			m_VertexLayout = layout;
+			m_Dirty = true;
+		}
+	}
+
+	VertexLayout Mesh::GetVertexLayout() const
+	{
+		return m_VertexLayout;
+	}
+
+	bool Mesh::GetVertexPacked() const
+	{
+		return m_VertexLayout != VertexLayout::SEPARATE && !Positions.GetStreaming();
+	}
+
+	Mesh::VertexFormat Mesh::GetVertexFormat(VertexLayout layout) const
+	{
+		VertexFormat format = { 0, -1, -1, -1, -1, -1, -1 };
+
+		unsigned int vertexCount = Positions.Data.size() / 3;
+		if (vertexCount == 0)
+			return format;
+
+		bool quantized = layout == VertexLayout::QUANTIZED;
+		bool skinned = IsSkinnedMesh() && IDs.Data.size() >= vertexCount * 4 && Weights.Data.size() >= vertexCount * 3;
+
+		auto append = [&](int &offset, bool present, unsigned int size)
+		{
+			if (present)
+			{
+				offset = format.stride;
+				format.stride += size;
+			}
+		};
+
+		append(format.position, true, 3 * sizeof(float));
+		append(format.normal, Normals.Data.size() >= vertexCount * 3, quantized ? 4 : 3 * sizeof(float));
+		append(format.tangent, Tangents.Data.size() >= vertexCount * 3, quantized ? 4 : 3 * sizeof(float));
+		append(format.uv, UVs.Data.size() >= vertexCount * 2, quantized ? 2 * sizeof(uint16_t) : 2 * sizeof(float));
+		append(format.ids, skinned, quantized ? 4 : 4 * sizeof(unsigned int));
+		append(format.weights, skinned, quantized ? 4 : 3 * sizeof(float));
+
+		return format;
+	}
+
+	unsigned int Mesh::GetMemory(VertexLayout layout) const
+	{
+		unsigned int indexCount = Indices.Data.size();
+		for (auto subMesh : m_SubMeshes)
+			if (subMesh != nullptr)
+				indexCount += subMesh->Indices.Data.size();
+
+		return (Positions.Data.size() / 3) * GetVertexFormat(layout).stride + indexCount * sizeof(unsigned int);
+	}
+
+	void Mesh::UpdatePackedVertices()
+	{
+		// attributes only keep their cpu data.
+		Positions.DeleteBuffer();
+		Normals.DeleteBuffer();
+		Tangents.DeleteBuffer();
+		UVs.DeleteBuffer();
+		Weights.DeleteBuffer();
+		IDs.DeleteBuffer();
+
+		PackVertices(GetVertexFormat(m_VertexLayout), m_VertexLayout == VertexLayout::QUANTIZED);
+
+		m_Vertices.SetDirty();
+		m_Vertices.UpdateBuffer();
+
+		std::vector<unsigned char>().swap(m_Vertices.Data);
+	}
+
+	void Mesh::PackVertices(const VertexFormat &format, bool quantized)
+	{
+		unsigned int vertexCount = Positions.Data.size() / 3;
+		m_Vertices.Data.assign(vertexCount * format.stride, 0);
+
+		for (unsigned int i = 0; i < vertexCount; i++)
+		{
+			unsigned char *vertex = &m_Vertices.Data[i * format.stride];
+			unsigned int i2 = i * 2, i3 = i * 3, i4 = i * 4;
+
+			std::memcpy(vertex + format.position, &Positions.Data[i3], 3 * sizeof(float));
+
+			if (format.normal != -1)
+			{
+				if (quantized)
+				{
+					uint32_t packed = MathUtil::PackSnorm1010102(Normals.Data[i3], Normals.Data[i3 + 1], Normals.Data[i3 + 2]);
+					std::memcpy(vertex + format.normal, &packed, sizeof(packed));
+				}
+				else
+				{
+					std::memcpy(vertex + format.normal, &Normals.Data[i3], 3 * sizeof(float));
+				}
+			}
+
+			if (format.tangent != -1)
+			{
+				if (quantized)
+				{
+					uint32_t packed = MathUtil::PackSnorm1010102(Tangents.Data[i3], Tangents.Data[i3 + 1], Tangents.Data[i3 + 2]);
+					std::memcpy(vertex + format.tangent, &packed, sizeof(packed));
+				}
+				else
+				{
+					std::memcpy(vertex + format.tangent, &Tangents.Data[i3], 3 * sizeof(float));
+				}
+			}
+
+			if (format.uv != -1)
+			{
+				if (quantized)
+				{
+					uint16_t packed[] = { MathUtil::FloatToHalf(UVs.Data[i2]), MathUtil::FloatToHalf(UVs.Data[i2 + 1]) };
+					std::memcpy(vertex + format.uv, packed, sizeof(packed));
+				}
+				else
+				{
+					std::memcpy(vertex + format.uv, &UVs.Data[i2], 2 * sizeof(float));
+				}
+			}
+
+			if (format.ids != -1)
+			{
+				if (quantized)
+				{
+					for (unsigned int j = 0; j < 4; j++)
+						vertex[format.ids + j] = (unsigned char)std::min(IDs.Data[i4 + j], 255u);
+				}
+				else
+				{
+					std::memcpy(vertex + format.ids, &IDs.Data[i4], 4 * sizeof(unsigned int));
+				}
+			}
+
+			if (format.weights != -1)
+			{
+				if (quantized)
+				{
+					// shader derives the 4th weight, so the byte is left 0.
+					for (unsigned int j = 0; j < 3; j++)
+					{
+						float weight = std::max(0.0f, std::min(1.0f, Weights.Data[i3 + j]));
+						vertex[format.weights + j] = (unsigned char)(weight * 255.0f + 0.5f);
+					}
+				}
+				else
+				{
+					std::memcpy(vertex + format.weights, &Weights.Data[i3], 3 * sizeof(float));
+				}
+			}
+		}
+	}
+
+	void Mesh::UpdateMemory()
+	{
+		if (!BufferManager::HasInstance())
+			return;
+
+		BufferManager::Instance()->DecreaseMemory(m_Memory);
+
+		// streamed data is counted by it's StreamBuffer.
+		m_Memory = 0;
+		if (!m_Dirty && !Positions.GetStreaming())
+			m_Memory = GetMemory(GetVertexPacked() ? m_VertexLayout : VertexLayout::SEPARATE);
+
+		BufferManager::Instance()->IncreaseMemory(m_Memory);
+	}
+
+	int Mesh::GetPoolPage() const
+	{
+		return m_PoolPage;
+	}
+
+	int Mesh::GetPoolBaseVertex() const
+	{
+		return m_PoolBaseVertex;
+	}
+
+	unsigned int Mesh::GetPoolFirstIndex() const
+	{
+		return m_PoolFirstIndex;
 	}
 
 	void Mesh::DeleteBuffer()
 	{
 		m_Dirty = true;
 
+		if (m_PoolPage != -1 && MeshPool::HasInstance())
+			MeshPool::Instance()->Remove(this);
+
 		if (m_VAO != 0)
 		{
+			GLState::OnDeleteVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
+
+		if (m_Memory != 0 && BufferManager::HasInstance())
+			BufferManager::Instance()->DecreaseMemory(m_Memory);
+		m_Memory = 0;
+
+		m_Vertices.DeleteBuffer();
 		Positions.DeleteBuffer();
 		Normals.DeleteBuffer();
 		Tangents.DeleteBuffer();
@@ -348,13 +641,20 @@ namespace fury
 		}
 		else
 		{
-			unsigned int triangleCount = Positions.Data.size() / 3;
-			for (unsigned int i = 0; i < triangleCount; i++)
+			auto Encapsulate = [this](size_t begin, size_t end, BoxBounds aabb)
 			{
-				unsigned int index = i * 3;
-				m_AABB.Encapsulate(Vector4(Positions.Data[index], Positions.Data[index + 1], 
-					Positions.Data[index + 2], 1.0f));
-			}
+				for (size_t i = begin; i < end; i++)
+				{
+					size_t index = i * 3;
+					aabb.Encapsulate(Vector4(Positions.Data[index], Positions.Data[index + 1], 
+						Positions.Data[index + 2], 1.0f));
+				}
+				return aabb;
+			};
+
+			size_t vertexCount = Positions.Data.size() / 3;
+			m_AABB = ThreadUtil::ParallelReduce(0, vertexCount, 4096, m_AABB, Encapsulate, 
+				[](BoxBounds a, const BoxBounds &b) { a.Encapsulate(b); return a; });
 		}
 	}
 
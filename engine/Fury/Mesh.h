@@ -8,6 +8,7 @@
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
 #include "Fury/Buffer.h"
+#include "Fury/EnumUtil.h"
 
 namespace fury
 {
@@ -17,6 +18,8 @@ namespace fury
 
 		friend class Shader;
 
+		friend class MeshPool;
+
 		typedef std::shared_ptr<SubMesh> Ptr;
 
 		static Ptr Create();
@@ -27,6 +30,8 @@ namespace fury
 
 		unsigned int m_VAO;
 
+		unsigned int m_PoolFirstIndex = 0;
+
 	public:
 
 		ArrayBufferui Indices;
@@ -43,6 +48,9 @@ namespace fury
 		// call this to free the memory allocated for vertex data.
 		void DeleteRawData();
 
+		// first index in MeshPool's index buffer, if the mesh is pooled.
+		unsigned int GetPoolFirstIndex() const;
+
 		virtual std::type_index GetTypeIndex() const override;
 	};
 
@@ -57,20 +65,57 @@ namespace fury
 
 		friend class FbxParser;
 
+		friend class MeshPool;
+
 		typedef std::shared_ptr<Mesh> Ptr;
 
 		static Ptr Create(const std::string &name);
 
+		// byte offsets of attributes in one interleaved vertex, -1 if mesh has no such data.
+		struct VertexFormat
+		{
+			unsigned int stride;
+
+			int position;
+
+			int normal;
+
+			int tangent;
+
+			int uv;
+
+			int ids;
+
+			int weights;
+		};
+
 	protected:
 
 		unsigned int m_VAO;
 
+		VertexLayout m_VertexLayout = VertexLayout::SEPARATE;
+
+		// interleaved vertices for packed layouts, only kept in cpu memory during upload.
+		ArrayBufferub m_Vertices;
+
+		// gpu bytes reported to BufferManager.
+		unsigned int m_Memory = 0;
+
+		// MeshPool page, -1 if mesh isn't pooled.
+		int m_PoolPage = -1;
+
+		int m_PoolBaseVertex = 0;
+
+		unsigned int m_PoolFirstIndex = 0;
+
 		BoxBounds m_AABB;
 
 		std::vector<SubMesh::Ptr> m_SubMeshes;
 
+		// bind pose and offset matrices, shared by every node using this mesh. animated poses live in Skeleton.
 		std::unordered_map<std::string, std::shared_ptr<Joint>> m_JointMap;
 
+		// skinning joints, vertex joint ids index this.
 		std::vector<std::shared_ptr<Joint>> m_Joints;
 
 		std::shared_ptr<Joint> m_RootJoint;
@@ -120,6 +165,36 @@ namespace fury
 
 		virtual void UpdateBuffer() override;
 
+		// uploads ranges marked with ArrayBuffer::MarkDirty, keeps the vao.
+		void UpdateDirtyRanges();
+
+		// true if attributes or indices have ranges waiting for UpdateDirtyRanges, or a submesh is dirty.
+		bool HasDirtyRanges() const;
+
+		int GetPoolPage() const;
+
+		// base vertex and first index in MeshPool's buffers, if the mesh is pooled.
+		int GetPoolBaseVertex() const;
+
+		unsigned int GetPoolFirstIndex() const;
+
+		// INTERLEAVED puts float attributes in one buffer. QUANTIZED also stores uvs as half floats, normals and
+		// tangents as 10_10_10_2 snorm, bone ids as bytes and weights as unorm bytes, positions stay float.
+		// Positions, Normals etc. keep their float data, packing happens on UpdateBuffer.
+		// meshes with streamed positions always upload SEPARATE.
+		void SetVertexLayout(VertexLayout layout);
+
+		VertexLayout GetVertexLayout() const;
+
+		// true if vertices are uploaded as one interleaved buffer.
+		bool GetVertexPacked() const;
+
+		// SEPARATE has the same sizes as INTERLEAVED, in one buffer per attribute.
+		VertexFormat GetVertexFormat(VertexLayout layout) const;
+
+		// gpu bytes of vertex and index data when uploaded with layout.
+		unsigned int GetMemory(VertexLayout layout) const;
+
 		virtual void DeleteBuffer() override;
 
 		void CalculateAABB(const Vector4& min, const Vector4& max);
@@ -131,6 +206,15 @@ namespace fury
 		bool GetCastShadows() const;
 
 		void SetCastShadows(bool state);
+
+	protected:
+
+		// packs attributes into m_Vertices and uploads it, attributes drop their own buffers.
+		void UpdatePackedVertices();
+
+		void PackVertices(const VertexFormat &format, bool quantized);
+
+		void UpdateMemory();
 	};
 }
 
@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Fury/BufferManager.h"
+#include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
+#include "Fury/Log.h"
+#include "Fury/MathUtil.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
+
+namespace fury
+{
+	// every attribute has a slot, FillMissingAttributes writes the ones a mesh doesn't have.
+	static Mesh::VertexFormat GetPageFormat(bool quantized)
+	{
+		if (quantized)
+			return { 24, 0, 12, 16, 20, -1, -1 };
+		else
+			return { 44, 0, 12, 24, 36, -1, -1 };
+	}
+
+	// page arrays are always enabled, so slots of attributes missing in packed get the generic
+	// attribute default (0, 0, 0, 1), the value an unpooled mesh reads with that array disabled.
+	static void FillMissingAttributes(std::vector<unsigned char> &vertices, const Mesh::VertexFormat &page,
+		const Mesh::VertexFormat &packed, bool quantized)
+	{
+		const float zeros[3] = { 0.0f, 0.0f, 0.0f };
+
+		// float vec3 and half vec2 get w = 1 from gl, packed snorm stores it.
+		uint32_t direction = MathUtil::PackSnorm1010102(0.0f, 0.0f, 0.0f, 1.0f);
+		uint16_t uv[2] = { MathUtil::FloatToHalf(0.0f), MathUtil::FloatToHalf(0.0f) };
+
+		const void *directionData = quantized ? (const void*)&direction : (const void*)zeros;
+		size_t directionSize = quantized ? sizeof(direction) : sizeof(zeros);
+		const void *uvData = quantized ? (const void*)uv : (const void*)zeros;
+		size_t uvSize = quantized ? sizeof(uv) : 2 * sizeof(float);
+
+		for (size_t offset = 0; offset < vertices.size(); offset += page.stride)
+		{
+			unsigned char *vertex = &vertices[offset];
+			if (packed.normal == -1)
+				std::memcpy(vertex + page.normal, directionData, directionSize);
+			if (packed.tangent == -1)
+				std::memcpy(vertex + page.tangent, directionData, directionSize);
+			if (packed.uv == -1)
+				std::memcpy(vertex + page.uv, uvData, uvSize);
+		}
+	}
+
+	MeshPool::MeshPool(unsigned int pageVertexCount)
+		: m_PageVertexCount(pageVertexCount)
+	{
+
+	}
+
+	MeshPool::~MeshPool()
+	{
+		Clear();
+	}
+
+	bool MeshPool::Add(const std::shared_ptr<Mesh> &mesh)
+	{
+		Mesh *ptr = mesh.get();
+		if (ptr->m_PoolPage != -1)
+			return true;
+
+		if (ptr->IsSkinnedMesh() || ptr->Positions.GetStreaming() || ptr->Positions.Data.size() < 3)
+			return false;
+
+		unsigned int vertexCount = ptr->Positions.Data.size() / 3;
+		unsigned int indexCount = ptr->Indices.Data.size();
+		for (unsigned int i = 0; i < ptr->GetSubMeshCount(); i++)
+			indexCount += ptr->GetSubMeshAt(i)->Indices.Data.size();
+
+		if (indexCount == 0)
+			return false;
+
+		// quantized meshes stay packed, so they only share pages with each other.
+		bool quantized = ptr->m_VertexLayout == VertexLayout::QUANTIZED;
+
+		// find a page with room for both vertices and indices.
+		Allocation allocation;
+		allocation.vertices.count = vertexCount;
+		allocation.indices.count = indexCount;
+
+		bool found = false;
+		for (unsigned int i = 0; i < m_Pages.size() && !found; i++)
+		{
+			Page &page = m_Pages[i];
+			if (page.quantized != quantized || !Allocate(page.freeVertices, vertexCount, allocation.vertices.offset))
+				continue;
+
+			if (!Allocate(page.freeIndices, indexCount, allocation.indices.offset))
+			{
+				Free(page.freeVertices, allocation.vertices.offset, vertexCount);
+				continue;
+			}
+
+			allocation.page = i;
+			found = true;
+		}
+
+		if (!found)
+		{
+			// small scenes don't pay for a full page.
+			unsigned int pageVertices = MIN_PAGE_VERTICES;
+			for (const auto &page : m_Pages)
+				if (page.quantized == quantized)
+					pageVertices = page.vertexCapacity * 2;
+			pageVertices = std::min(pageVertices, m_PageVertexCount);
+
+			allocation.page = CreatePage(std::max(vertexCount, pageVertices), std::max(indexCount, pageVertices * PAGE_INDEX_RATIO), quantized);
+			Page &page = m_Pages[allocation.page];
+			Allocate(page.freeVertices, vertexCount, allocation.vertices.offset);
+			Allocate(page.freeIndices, indexCount, allocation.indices.offset);
+		}
+
+		// interleave in page's format, with mesh's packing.
+		Mesh::VertexFormat pageFormat = GetPageFormat(quantized);
+		Mesh::VertexFormat format = pageFormat;
+		Mesh::VertexFormat meshFormat = ptr->GetVertexFormat(quantized ? VertexLayout::QUANTIZED : VertexLayout::INTERLEAVED);
+		if (meshFormat.normal == -1)
+			format.normal = -1;
+		if (meshFormat.tangent == -1)
+			format.tangent = -1;
+		if (meshFormat.uv == -1)
+			format.uv = -1;
+
+		ptr->PackVertices(format, quantized);
+		FillMissingAttributes(ptr->m_Vertices.Data, pageFormat, format, quantized);
+
+		std::vector<unsigned int> indices;
+		indices.reserve(indexCount);
+		indices.insert(indices.end(), ptr->Indices.Data.begin(), ptr->Indices.Data.end());
+
+		ptr->m_PoolFirstIndex = allocation.indices.offset;
+		for (unsigned int i = 0; i < ptr->GetSubMeshCount(); i++)
+		{
+			auto subMesh = ptr->GetSubMeshAt(i);
+			subMesh->m_PoolFirstIndex = allocation.indices.offset + indices.size();
+			indices.insert(indices.end(), subMesh->Indices.Data.begin(), subMesh->Indices.Data.end());
+		}
+
+		const Page &page = m_Pages[allocation.page];
+
+		// upload through copy target, element buffer binding is vao state.
+		glBindBuffer(GL_COPY_WRITE_BUFFER, page.vbo);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.vertices.offset * page.stride,
+			ptr->m_Vertices.Data.size(), ptr->m_Vertices.Data.data());
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, page.ibo);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.indices.offset * sizeof(unsigned int),
+			indices.size() * sizeof(unsigned int), &indices[0]);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		std::vector<unsigned char>().swap(ptr->m_Vertices.Data);
+
+		ptr->m_PoolPage = allocation.page;
+		ptr->m_PoolBaseVertex = allocation.vertices.offset;
+
+		m_Allocations[ptr] = allocation;
+		return true;
+	}
+
+	void MeshPool::Remove(Mesh *mesh)
+	{
+		auto it = m_Allocations.find(mesh);
+		if (it == m_Allocations.end())
+			return;
+
+		const Allocation &allocation = it->second;
+		Page &page = m_Pages[allocation.page];
+		Free(page.freeVertices, allocation.vertices.offset, allocation.vertices.count);
+		Free(page.freeIndices, allocation.indices.offset, allocation.indices.count);
+
+		mesh->m_PoolPage = -1;
+		m_Allocations.erase(it);
+	}
+
+	void MeshPool::Clear()
+	{
+		for (auto &pair : m_Allocations)
+			pair.first->m_PoolPage = -1;
+
+		m_Allocations.clear();
+
+		for (auto &page : m_Pages)
+			DeletePage(page);
+
+		m_Pages.clear();
+	}
+
+	unsigned int MeshPool::GetVertexArray(unsigned int page) const
+	{
+		return page < m_Pages.size() ? m_Pages[page].vao : 0;
+	}
+
+	unsigned int MeshPool::GetPageCount() const
+	{
+		return m_Pages.size();
+	}
+
+	unsigned int MeshPool::GetMeshCount() const
+	{
+		return m_Allocations.size();
+	}
+
+	bool MeshPool::Allocate(std::vector<Range> &freeList, unsigned int count, unsigned int &offset)
+	{
+		for (auto it = freeList.begin(); it != freeList.end(); ++it)
+		{
+			if (it->count < count)
+				continue;
+
+			offset = it->offset;
+			it->offset += count;
+			it->count -= count;
+
+			if (it->count == 0)
+				freeList.erase(it);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void MeshPool::Free(std::vector<Range> &freeList, unsigned int offset, unsigned int count)
+	{
+		auto it = std::lower_bound(freeList.begin(), freeList.end(), offset,
+			[](const Range &range, unsigned int value) { return range.offset < value; });
+
+		it = freeList.insert(it, { offset, count });
+
+		// merge with next, then with previous.
+		auto next = it + 1;
+		if (next != freeList.end() && it->offset + it->count == next->offset)
+		{
+			it->count += next->count;
+			it = freeList.erase(next) - 1;
+		}
+
+		if (it != freeList.begin())
+		{
+			auto prev = it - 1;
+			if (prev->offset + prev->count == it->offset)
+			{
+				prev->count += it->count;
+				freeList.erase(it);
+			}
+		}
+	}
+
+	unsigned int MeshPool::CreatePage(unsigned int vertexCount, unsigned int indexCount, bool quantized)
+	{
+		Mesh::VertexFormat format = GetPageFormat(quantized);
+
+		Page page;
+		page.quantized = quantized;
+		page.stride = format.stride;
+		page.vertexCapacity = vertexCount;
+		page.indexCapacity = indexCount;
+		page.freeVertices.push_back({ 0, vertexCount });
+		page.freeIndices.push_back({ 0, indexCount });
+
+		glGenVertexArrays(1, &page.vao);
+		glGenBuffers(1, &page.vbo);
+		glGenBuffers(1, &page.ibo);
+
+		GLState::BindVertexArray(page.vao);
+
+		glBindBuffer(GL_ARRAY_BUFFER, page.vbo);
+		glBufferData(GL_ARRAY_BUFFER, vertexCount * page.stride, nullptr, GL_STATIC_DRAW);
+
+		// same attribute formats as Shader::BindPackedVertices.
+		glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, format.stride, (const void*)(size_t)format.position);
+		if (quantized)
+		{
+			glVertexAttribPointer(NORMAL_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, format.stride, (const void*)(size_t)format.normal);
+			glVertexAttribPointer(TANGENT_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, format.stride, (const void*)(size_t)format.tangent);
+			glVertexAttribPointer(UV_LOCATION, 2, GL_HALF_FLOAT, GL_FALSE, format.stride, (const void*)(size_t)format.uv);
+		}
+		else
+		{
+			glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, format.stride, (const void*)(size_t)format.normal);
+			glVertexAttribPointer(TANGENT_LOCATION, 3, GL_FLOAT, GL_FALSE, format.stride, (const void*)(size_t)format.tangent);
+			glVertexAttribPointer(UV_LOCATION, 2, GL_FLOAT, GL_FALSE, format.stride, (const void*)(size_t)format.uv);
+		}
+
+		const unsigned int locations[] = { POSITION_LOCATION, NORMAL_LOCATION, TANGENT_LOCATION, UV_LOCATION };
+		for (auto location : locations)
+			glEnableVertexAttribArray(location);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.ibo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+		GLState::BindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		BufferManager::Instance()->IncreaseMemory(vertexCount * page.stride + indexCount * sizeof(unsigned int));
+
+		FURYD << "MeshPool page " << m_Pages.size() << " [" << vertexCount << (quantized ? " quantized" : "") << " vertices, " << indexCount << " indices]";
+
+		m_Pages.push_back(page);
+		return m_Pages.size() - 1;
+	}
+
+	void MeshPool::DeletePage(Page &page)
+	{
+		if (page.vao != 0)
+		{
+			GLState::OnDeleteVertexArray(page.vao);
+			glDeleteVertexArrays(1, &page.vao);
+		}
+
+		if (page.vbo != 0)
+			glDeleteBuffers(1, &page.vbo);
+
+		if (page.ibo != 0)
+			glDeleteBuffers(1, &page.ibo);
+
+		if (BufferManager::HasInstance())
+			BufferManager::Instance()->DecreaseMemory(page.vertexCapacity * page.stride + page.indexCapacity * sizeof(unsigned int));
+
+		page.vao = page.vbo = page.ibo = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef _FURY_MESH_POOL_H_
+#define _FURY_MESH_POOL_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class Mesh;
+
+	// Suballocates static meshes from a few large interleaved vertex and index buffers (pages).
+	// Meshes in the same page share one vao, and are drawn with glDrawElementsBaseVertex.
+	// Vertices are position, normal, tangent and uv, as floats or, for VertexLayout::QUANTIZED meshes,
+	// in their own pages with Mesh's quantized formats. attribute locations are the ones
+	// Shader binds mesh attributes to. Mesh::UpdateBuffer and UpdateDirtyRanges remove an edited mesh, Add copies it again.
+	class FURY_API MeshPool final : public Singleton<MeshPool, unsigned int>
+	{
+	public:
+
+		typedef std::shared_ptr<MeshPool> Ptr;
+
+		// attribute locations of mesh data, Shader binds them before linking.
+		static const unsigned int POSITION_LOCATION = 0;
+
+		static const unsigned int NORMAL_LOCATION = 1;
+
+		static const unsigned int TANGENT_LOCATION = 2;
+
+		static const unsigned int UV_LOCATION = 3;
+
+		static const unsigned int BONE_ID_LOCATION = 4;
+
+		static const unsigned int BONE_WEIGHT_LOCATION = 5;
+
+		// vertices of the first page, later pages double up to the max page size.
+		static const unsigned int MIN_PAGE_VERTICES = 1 << 16;
+
+		// indices per page vertex.
+		static const unsigned int PAGE_INDEX_RATIO = 3;
+
+	protected:
+
+		struct Range
+		{
+			unsigned int offset;
+
+			unsigned int count;
+		};
+
+		struct Page
+		{
+			unsigned int vao;
+
+			unsigned int vbo;
+
+			unsigned int ibo;
+
+			// holds VertexLayout::QUANTIZED meshes.
+			bool quantized;
+
+			// bytes per vertex.
+			unsigned int stride;
+
+			unsigned int vertexCapacity;
+
+			unsigned int indexCapacity;
+
+			// free ranges sorted by offset.
+			std::vector<Range> freeVertices;
+
+			std::vector<Range> freeIndices;
+		};
+
+		// indices of mesh and it's submeshes are allocated as one range, in that order.
+		struct Allocation
+		{
+			unsigned int page;
+
+			Range vertices;
+
+			Range indices;
+		};
+
+		std::vector<Page> m_Pages;
+
+		std::unordered_map<Mesh*, Allocation> m_Allocations;
+
+		// max vertices of a page, unless a single mesh needs more.
+		unsigned int m_PageVertexCount;
+
+	public:
+
+		MeshPool(unsigned int pageVertexCount = 1 << 20);
+
+		~MeshPool();
+
+		// copies mesh and it's submeshes into a page, returns false if mesh can't be pooled.
+		// skinned and streamed meshes aren't pooled.
+		bool Add(const std::shared_ptr<Mesh> &mesh);
+
+		void Remove(Mesh *mesh);
+
+		// releases all pages, pooled meshes fall back to their own buffers.
+		void Clear();
+
+		unsigned int GetVertexArray(unsigned int page) const;
+
+		unsigned int GetPageCount() const;
+
+		unsigned int GetMeshCount() const;
+
+	protected:
+
+		// first fit, returns false if no free range is large enough.
+		static bool Allocate(std::vector<Range> &freeList, unsigned int count, unsigned int &offset);
+
+		// returns range to freeList, merging it with adjacent ranges.
+		static void Free(std::vector<Range> &freeList, unsigned int offset, unsigned int count);
+
+		unsigned int CreatePage(unsigned int vertexCount, unsigned int indexCount, bool quantized);
+
+		void DeletePage(Page &page);
+	};
+}
+
+#endif // _FURY_MESH_POOL_H_
\ No newline at end of file
@@ -10,7 +10,9 @@
 #include "Fury/MathUtil.h"
 #include "Fury/Log.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/ThreadUtil.h"
 
 namespace fury
 {
@@ -426,40 +428,41 @@ namespace fury
 		bool hasNormal = mesh->Normals.Data.size() > 0;
 		bool hasTangent = mesh->Tangents.Data.size() > 0;
 
-		for (unsigned int i = 0; i < count; i++)
+		ThreadUtil::ParallelFor(0, count, 1024, [&](size_t chunkBegin, size_t chunkEnd)
 		{
-			unsigned int j = i * 3;
-
-			Vector4 pos(mesh->Positions.Data[j], mesh->Positions.Data[j + 1], mesh->Positions.Data[j + 2], 1);
+			size_t offset = chunkBegin * 3;
+			size_t chunkSize = chunkEnd - chunkBegin;
 
-			pos = matrix.Multiply(pos);
-			mesh->Positions.Data[j] = pos.x;
-			mesh->Positions.Data[j + 1] = pos.y;
-			mesh->Positions.Data[j + 2] = pos.z;
+			float *positions = &mesh->Positions.Data[offset];
+			Matrix4::TransformPoints(matrix, positions, positions, chunkSize);
 
-			if (hasNormal)
+			auto TransformDirections = [&](std::vector<float> &data)
 			{
-				Vector4 normal(mesh->Normals.Data[j], mesh->Normals.Data[j + 1], mesh->Normals.Data[j + 2], 0);
+				float *directions = &data[offset];
+				Matrix4::TransformVectors(matrix, directions, directions, chunkSize);
 
-				normal = matrix.Multiply(normal).Normalized();
-				mesh->Normals.Data[j] = normal.x;
-				mesh->Normals.Data[j + 1] = normal.y;
-				mesh->Normals.Data[j + 2] = normal.z;
-			}
+				for (size_t j = 0; j < chunkSize * 3; j += 3)
+				{
+					Vector4 direction = Vector4(directions[j], directions[j + 1], directions[j + 2]).Normalized();
+					directions[j] = direction.x;
+					directions[j + 1] = direction.y;
+					directions[j + 2] = direction.z;
+				}
+			};
 
-			if (hasTangent)
-			{
-				Vector4 tangent(mesh->Tangents.Data[j], mesh->Tangents.Data[j + 1], mesh->Tangents.Data[j + 2], 0);
+			if (hasNormal)
+				TransformDirections(mesh->Normals.Data);
 
-				tangent = matrix.Multiply(tangent).Normalized();
-				mesh->Tangents.Data[j] = tangent.x;
-				mesh->Tangents.Data[j + 1] = tangent.y;
-				mesh->Tangents.Data[j + 2] = tangent.z;
-			}
-		}
+			if (hasTangent)
+				TransformDirections(mesh->Tangents.Data);
+		});
 
 		if (updateBuffer)
 		{
+			// attributes upload on their own, drop the stale pooled copy.
+			if (mesh->GetPoolPage() != -1 && MeshPool::HasInstance())
+				MeshPool::Instance()->Remove(mesh.get());
+
 			mesh->Positions.SetDirty();
 			mesh->Positions.UpdateBuffer();
 
@@ -835,40 +838,49 @@ namespace fury
 			mesh->Normals.Data[j + 2] += normal.z;
 		};
 
-		for (unsigned int i = 0; i < numTriangles; i++)
+		// face normals are computed in parallel, accumulation is done serially to avoid write conflicts.
+		std::vector<Vector4> faceNormals(numTriangles);
+		ThreadUtil::ParallelFor(0, numTriangles, 1024, [&](size_t chunkBegin, size_t chunkEnd)
 		{
-			unsigned int j = i * 3;
-			unsigned int ia = mesh->Indices.Data[j];
-			unsigned int ib = mesh->Indices.Data[j + 1];
-			unsigned int ic = mesh->Indices.Data[j + 2];
+			for (size_t i = chunkBegin; i < chunkEnd; i++)
+			{
+				size_t j = i * 3;
 
-			Vector4 a = GetPositionAt(ia);
-			Vector4 b = GetPositionAt(ib);
-			Vector4 c = GetPositionAt(ic);
+				Vector4 a = GetPositionAt(mesh->Indices.Data[j]);
+				Vector4 b = GetPositionAt(mesh->Indices.Data[j + 1]);
+				Vector4 c = GetPositionAt(mesh->Indices.Data[j + 2]);
 
-			Vector4 e0 = b - a;
-			Vector4 e1 = c - b;
-			Vector4 normal = e0.CrossProduct(e1);
+				Vector4 e0 = b - a;
+				Vector4 e1 = c - b;
+				faceNormals[i] = e0.CrossProduct(e1);
+			}
+		});
 
-			SetNormalAt(ia, normal);
-			SetNormalAt(ib, normal);
-			SetNormalAt(ic, normal);
+		for (unsigned int i = 0; i < numTriangles; i++)
+		{
+			unsigned int j = i * 3;
+			SetNormalAt(mesh->Indices.Data[j], faceNormals[i]);
+			SetNormalAt(mesh->Indices.Data[j + 1], faceNormals[i]);
+			SetNormalAt(mesh->Indices.Data[j + 2], faceNormals[i]);
 		}
 
-		for (unsigned int i = 0; i < numVertices; i++)
+		ThreadUtil::ParallelFor(0, numVertices, 1024, [&](size_t chunkBegin, size_t chunkEnd)
 		{
-			unsigned int j = i * 3;
+			for (size_t i = chunkBegin; i < chunkEnd; i++)
+			{
+				size_t j = i * 3;
 
-			float &x = mesh->Normals.Data[j];
-			float &y = mesh->Normals.Data[j + 1];
-			float &z = mesh->Normals.Data[j + 2];
+				float &x = mesh->Normals.Data[j];
+				float &y = mesh->Normals.Data[j + 1];
+				float &z = mesh->Normals.Data[j + 2];
 
-			Vector4 normal = Vector4(x, y, z).Normalized();
+				Vector4 normal = Vector4(x, y, z).Normalized();
 
-			x = normal.x;
-			y = normal.y;
-			z = normal.z;
-		}
+				x = normal.x;
+				y = normal.y;
+				z = normal.z;
+			}
+		});
 	}
 
 	void MeshUtil::CalculateTangent(const std::shared_ptr<Mesh> &mesh) 
@@ -954,4 +966,22 @@ namespace fury
 			z = tangent.z;
 		}
 	}
+
+	void MeshUtil::ConvertVertexLayout(const std::shared_ptr<Mesh> &mesh, VertexLayout layout)
+	{
+		const auto &ids = mesh->IDs.Data;
+		if (layout == VertexLayout::QUANTIZED && ids.size() > 0 && *std::max_element(ids.begin(), ids.end()) > 255)
+		{
+			FURYW << mesh->GetName() << "'s bone ids don't fit in a byte, using interleaved layout!";
+			layout = VertexLayout::INTERLEAVED;
+		}
+
+		unsigned int before = mesh->GetMemory(mesh->GetVertexPacked() ? mesh->GetVertexLayout() : VertexLayout::SEPARATE);
+
+		mesh->SetVertexLayout(layout);
+
+		unsigned int after = mesh->GetMemory(mesh->GetVertexPacked() ? layout : VertexLayout::SEPARATE);
+
+		FURYD << mesh->GetName() << " " << EnumUtil::VertexLayoutToString(layout) << " vertices: " << before << " -> " << after << " bytes";
+	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "Macros.h"
+#include "Fury/EnumUtil.h"
 #include "Fury/Matrix4.h"
 
 namespace fury
@@ -65,6 +66,10 @@ namespace fury
 		// TODO: test
 		// you should calculate normal first, then calculate tangent.
 		static void CalculateTangent(const std::shared_ptr<Mesh> &mesh);
+
+		// sets mesh's gpu vertex layout and logs it's memory before and after.
+		// QUANTIZED falls back to INTERLEAVED if a bone id won't fit in a byte.
+		static void ConvertVertexLayout(const std::shared_ptr<Mesh> &mesh, VertexLayout layout);
 	};
 }
 
@@ -1,26 +1,33 @@
+#include <cstdint>
 #include <deque>
 
+#include "Fury/BoxBounds.h"
 #include "Fury/Frustum.h"
-#include "Fury/Light.h"
-#include "Fury/Material.h"
-#include "Fury/Mesh.h"
-#include "Fury/MeshRender.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/OcTree.h"
 #include "Fury/RenderQuery.h"
 #include "Fury/SceneNode.h"
 #include "Fury/SphereBounds.h"
+#include "Fury/ThreadUtil.h"
+#include "Fury/TransformStore.h"
 #include "Fury/Log.h"
 
 namespace fury
 {
-	OcTree::Ptr OcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth)
+	// levels above this are culled by the calling thread, each subtree below is walked by one job.
+	static const unsigned int PARALLEL_DEPTH = 2;
+
+	// smaller trees are walked serially.
+	static const unsigned int PARALLEL_COUNT = 1024;
+
+	OcTree::Ptr OcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness)
 	{
-		return std::make_shared<OcTree>(min, max, maxDepth);
+		return std::make_shared<OcTree>(min, max, maxDepth, looseness);
 	}
 
-	OcTree::OcTree(Vector4 min, Vector4 max, unsigned int maxDepth) :
-		m_TypeIndex(typeid(OcTree)), m_MaxDepth(maxDepth)
+	OcTree::OcTree(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness) :
+		m_TypeIndex(typeid(OcTree)), m_MaxDepth(maxDepth), m_Looseness(looseness < 1.0f ? 1.0f : looseness),
+		m_ParallelTraversal(true)
 	{
 		m_Root = OcTreeNode::Create(*this, nullptr, min, max);
 	}
@@ -56,8 +63,32 @@ namespace fury
 
 	void OcTree::UpdateSceneNode(const SceneNode::Ptr &sceneNode)
 	{
-		sceneNode->RemoveFromOcTree(false);
-		AddSceneNode(sceneNode);
+		OcTreeNode::Ptr treeNode = sceneNode->GetOcTreeNode();
+		if (treeNode == nullptr || &treeNode->GetManager() != this)
+		{
+			sceneNode->RemoveFromOcTree(false);
+			AddSceneNode(sceneNode);
+			return;
+		}
+
+		BoxBounds nodeBounds = sceneNode->GetWorldAABB();
+
+		// in loose mode, scene nodes stay until they leave the loose bounds.
+		if (m_Looseness > 1.0f && treeNode->IsLooseFit(nodeBounds))
+			return;
+
+		// search down from the nearest ancestor that still fits, root takes everything else.
+		OcTreeNode::Ptr ancestor = treeNode;
+		while (ancestor->m_Parent != nullptr && !ancestor->IsLooseFit(nodeBounds))
+			ancestor = ancestor->m_Parent;
+
+		OcTreeNode::Ptr fitNode = GetFitNode(sceneNode, ancestor, ancestor->GetDepth());
+		if (fitNode == treeNode)
+			return;
+
+		// counts from the ancestor up don't change.
+		treeNode->RemoveSceneNode(sceneNode, ancestor.get());
+		fitNode->AddSceneNode(sceneNode, ancestor.get());
 	}
 
 	void OcTree::GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear) const
@@ -65,28 +96,30 @@ namespace fury
 		if (clear)
 			renderQuery->Clear();
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		std::vector<TraversalSegment> segments;
+		if (!GetParallelSegments(collider, segments))
 		{
-			if (sceneNode->GetComponent<Light>() != nullptr)
-				renderQuery->AddLight(sceneNode);
-			
-			if (auto render = sceneNode->GetComponent<MeshRender>())
+			SceneManager::GetRenderQuery(collider, renderQuery, false);
+			return;
+		}
+
+		// each chunk of segments fills it's own query, appending them in segment order gives the serial result.
+		std::vector<RenderQuery::Ptr> queries(segments.size());
+		ThreadUtil::ParallelFor(0, segments.size(), 1, [&](size_t begin, size_t end)
+		{
+			RenderQuery::Ptr query = RenderQuery::Create();
+			WalkSegments(collider, segments, begin, end, [&](const SceneNode::Ptr &sceneNode)
 			{
-				if (render->GetRenderable())
-					renderQuery->AddRenderable(sceneNode);
-			}
+				AddToRenderQuery(*query, sceneNode);
+			});
+			queries[begin] = query;
 		});
-	}
-
-	void OcTree::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear) const
-	{
-		if (clear)
-			sceneNodes.clear();
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode) 
+		for (auto &query : queries)
 		{
-			sceneNodes.push_back(sceneNode);
-		});
+			if (query != nullptr)
+				renderQuery->Append(*query);
+		}
 	}
 
 	void OcTree::GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear) const
@@ -94,12 +127,8 @@ namespace fury
 		if (clear)
 			renderables.clear();
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable())
-				renderables.push_back(sceneNode);
-		});
+		if (!GatherParallel(collider, IsRenderable, renderables))
+			SceneManager::GetVisibleRenderables(collider, renderables, false);
 	}
 
 	void OcTree::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
@@ -107,52 +136,25 @@ namespace fury
 		if (clear)
 			renderables.clear();
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows())
-				renderables.push_back(sceneNode);
-		});
-	}
-
-	void OcTree::GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear) const
-	{
-		if (clear)
-			lights.clear();
-
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			if (sceneNode->GetComponent<Light>() != nullptr)
-				lights.push_back(sceneNode);
-
-		});
+		if (!GatherParallel(collider, IsShadowCaster, renderables))
+			SceneManager::GetVisibleShadowCasters(collider, renderables, false);
 	}
 
-	void OcTree::GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear) const
+	void OcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
 	{
-		if (clear)
-		{
-			renderables.clear();
-			lights.clear();
-		}
-
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable())
-				renderables.push_back(sceneNode);
-			else if (sceneNode->GetComponent<Light>() != nullptr)
-				lights.push_back(sceneNode);
-
-		});
+		// frustums cull each cell's scene nodes in batches.
+		if (auto frustum = dynamic_cast<const Frustum*>(&collider))
+			WalkFrustum(*frustum, m_Root, Frustum::ALL_PLANES, true, filterFunc);
+		else
+			WalkCollider(collider, m_Root, false, true, filterFunc);
 	}
 
-	void OcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	void OcTree::WalkCollider(const Collidable &collider, const OcTreeNode::Ptr &startNode, bool startTested, bool recursive, const FilterFunc &filterFunc) const
 	{
 		using TreeNodePair = std::pair<bool, OcTreeNode::Ptr>;
 
 		std::deque<TreeNodePair> possiblePairs;
-		possiblePairs.push_back(std::make_pair(false, m_Root));
+		possiblePairs.push_back(std::make_pair(startTested, startNode));
 
 		while (!possiblePairs.empty())
 		{
@@ -166,7 +168,7 @@ namespace fury
 
 			if (treeNode->GetTotalSceneNodeCount() > 0)
 			{
-				Side result = tested ? Side::IN : collider.IsInside(treeNode->GetAABB());
+				Side result = tested ? Side::IN : collider.IsInside(treeNode->GetLooseAABB());
 
 				if (result != Side::OUT)
 				{
@@ -182,6 +184,9 @@ namespace fury
 							filterFunc(sceneNode);
 					}
 
+					if (!recursive)
+						continue;
+
 					// add currentTreeNode's childs to possiblePairs vector.
 					for (int i = 0; i < 8; i++)
 					{
@@ -194,6 +199,158 @@ namespace fury
 		}
 	}
 
+	void OcTree::WalkFrustum(const Frustum &frustum, const OcTreeNode::Ptr &startNode, unsigned int startMask, bool recursive, const FilterFunc &filterFunc) const
+	{
+		// planes the tree node still straddles, childs only test these.
+		using TreeNodePair = std::pair<unsigned int, OcTreeNode::Ptr>;
+
+		std::deque<TreeNodePair> possiblePairs;
+		possiblePairs.push_back(std::make_pair(startMask, startNode));
+
+		std::vector<float> centers, extents;
+		std::vector<uint8_t> visibleMask;
+
+		while (!possiblePairs.empty())
+		{
+			TreeNodePair currentPair = possiblePairs.back();
+			possiblePairs.pop_back();
+
+			unsigned int planeMask = currentPair.first;
+			OcTreeNode::Ptr treeNode = currentPair.second;
+
+			if (treeNode->GetTotalSceneNodeCount() == 0)
+				continue;
+
+			if (planeMask != 0 && frustum.IsInside(treeNode->GetLooseAABB(), planeMask) == Side::OUT)
+				continue;
+
+			unsigned int sceneNodeCount = treeNode->GetSceneNodeCount();
+			if (planeMask == 0)
+			{
+				for (unsigned int i = 0; i < sceneNodeCount; i++)
+					filterFunc(treeNode->GetSceneNodeAt(i));
+			}
+			else if (sceneNodeCount > 0)
+			{
+				centers.resize(sceneNodeCount * 3);
+				extents.resize(sceneNodeCount * 3);
+				visibleMask.resize(sceneNodeCount);
+
+				for (unsigned int i = 0; i < sceneNodeCount; i++)
+					Frustum::PackAABB(treeNode->GetSceneNodeAt(i)->GetWorldAABB(), &centers[i * 3], &extents[i * 3]);
+
+				frustum.CullAABBs(centers.data(), extents.data(), sceneNodeCount, visibleMask.data(), planeMask);
+
+				for (unsigned int i = 0; i < sceneNodeCount; i++)
+				{
+					if (visibleMask[i])
+						filterFunc(treeNode->GetSceneNodeAt(i));
+				}
+			}
+
+			if (!recursive)
+				continue;
+
+			for (int i = 0; i < 8; i++)
+			{
+				OcTreeNode::Ptr childNode = treeNode->GetChildAt(i);
+				if (childNode != nullptr && childNode->GetTotalSceneNodeCount() > 0)
+					possiblePairs.push_back(std::make_pair(planeMask, childNode));
+			}
+		}
+	}
+
+	bool OcTree::GetParallelSegments(const Collidable &collider, std::vector<TraversalSegment> &segments) const
+	{
+		if (!m_ParallelTraversal || !ThreadUtil::HasInstance() || ThreadUtil::Instance()->GetWorkerCount() == 0)
+			return false;
+
+		// the base queries stream the store instead of walking the tree.
+		if (TransformStore::HasInstance() && dynamic_cast<const Frustum*>(&collider) != nullptr)
+			return false;
+
+		if (m_Root->GetTotalSceneNodeCount() < PARALLEL_COUNT)
+			return false;
+
+		AddSegments(collider, dynamic_cast<const Frustum*>(&collider), m_Root, Frustum::ALL_PLANES, 0, segments);
+		return true;
+	}
+
+	void OcTree::AddSegments(const Collidable &collider, const Frustum *frustum, const OcTreeNode::Ptr &treeNode,
+		unsigned int planeMask, unsigned int depth, std::vector<TraversalSegment> &segments) const
+	{
+		if (treeNode->GetTotalSceneNodeCount() == 0)
+			return;
+
+		// deeper levels are walked by one job.
+		if (depth == PARALLEL_DEPTH)
+		{
+			segments.push_back({ treeNode, planeMask, true });
+			return;
+		}
+
+		// for other colliders, 0 means the tree node is inside and any other mask means untested.
+		if (planeMask != 0)
+		{
+			Side result = frustum != nullptr ? frustum->IsInside(treeNode->GetLooseAABB(), planeMask) : collider.IsInside(treeNode->GetLooseAABB());
+			if (result == Side::OUT)
+				return;
+
+			if (result == Side::IN)
+				planeMask = 0;
+		}
+
+		if (treeNode->GetSceneNodeCount() > 0)
+			segments.push_back({ treeNode, planeMask, false });
+
+		// serial traversal pops childs from a stack, so they are visited in reverse.
+		for (int i = 7; i >= 0; i--)
+		{
+			OcTreeNode::Ptr childNode = treeNode->GetChildAt(i);
+			if (childNode != nullptr)
+				AddSegments(collider, frustum, childNode, planeMask, depth + 1, segments);
+		}
+	}
+
+	void OcTree::WalkSegments(const Collidable &collider, const std::vector<TraversalSegment> &segments,
+		size_t begin, size_t end, const FilterFunc &filterFunc) const
+	{
+		auto frustum = dynamic_cast<const Frustum*>(&collider);
+
+		for (size_t i = begin; i < end; i++)
+		{
+			const TraversalSegment &segment = segments[i];
+			if (frustum != nullptr)
+				WalkFrustum(*frustum, segment.treeNode, segment.planeMask, segment.recursive, filterFunc);
+			else
+				WalkCollider(collider, segment.treeNode, segment.planeMask == 0, segment.recursive, filterFunc);
+		}
+	}
+
+	bool OcTree::GatherParallel(const Collidable &collider, const std::function<bool(const std::shared_ptr<SceneNode>&)> &predicate, SceneNodes &sceneNodes) const
+	{
+		std::vector<TraversalSegment> segments;
+		if (!GetParallelSegments(collider, segments))
+			return false;
+
+		// one result per chunk, stored at the chunk's first segment.
+		std::vector<SceneNodes> results(segments.size());
+		ThreadUtil::ParallelFor(0, segments.size(), 1, [&](size_t begin, size_t end)
+		{
+			SceneNodes &result = results[begin];
+			WalkSegments(collider, segments, begin, end, [&](const SceneNode::Ptr &sceneNode)
+			{
+				if (predicate(sceneNode))
+					result.push_back(sceneNode);
+			});
+		});
+
+		for (auto &result : results)
+			sceneNodes.insert(sceneNodes.end(), result.begin(), result.end());
+
+		return true;
+	}
+
 	void OcTree::Reset(Vector4 min, Vector4 max, unsigned int maxDepth)
 	{
 		m_Root.reset();
@@ -205,20 +362,42 @@ namespace fury
 		m_Root->Clear();
 	}
 
+	float OcTree::GetLooseness() const
+	{
+		return m_Looseness;
+	}
+
+	void OcTree::SetParallelTraversal(bool enabled)
+	{
+		m_ParallelTraversal = enabled;
+	}
+
+	bool OcTree::GetParallelTraversal() const
+	{
+		return m_ParallelTraversal;
+	}
+
 	void OcTree::AddSceneNode(const SceneNode::Ptr &sceneNode, const OcTreeNode::Ptr &treeNode, unsigned int depth)
 	{
-		BoxBounds treeBounds = treeNode->GetAABB();
+		GetFitNode(sceneNode, treeNode, depth)->AddSceneNode(sceneNode);
+	}
+
+	OcTreeNode::Ptr OcTree::GetFitNode(const SceneNode::Ptr &sceneNode, const OcTreeNode::Ptr &treeNode, unsigned int depth)
+	{
 		BoxBounds nodeBounds = sceneNode->GetWorldAABB();
 
-		if ((depth < m_MaxDepth) && treeNode->IsTwiceSize(nodeBounds))
-		{
-			OcTreeNode::Ptr fitNode = treeNode->GetFitNode(nodeBounds);
-			AddSceneNode(sceneNode, fitNode, ++depth);
-		}
-		else
+		OcTreeNode::Ptr fitNode = treeNode;
+		while ((depth < m_MaxDepth) && fitNode->IsTwiceSize(nodeBounds))
 		{
-			treeNode->AddSceneNode(sceneNode);
+			OcTreeNode::Ptr childNode = fitNode->GetFitNode(nodeBounds);
+			if (childNode == fitNode)
+				break;
+
+			fitNode = childNode;
+			depth++;
 		}
+
+		return fitNode;
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
 #include <typeindex>
 
 #include "Fury/Color.h"
@@ -11,31 +12,53 @@
 
 namespace fury
 {
+	class Frustum;
+
 	class OcTreeNode;
 
 	// OcTree holds a shared_ptr to attached scenenodes.
 	// When you need to destory a scenenode.
 	// Call node.RemoveFromOcTree(true) + node.RemoveFromParent() + node.reset().
 	// You'll destory this node and all it's childs.
+	// With looseness > 1 the tree is loose: tree nodes accept scene nodes inside their bounds scaled by looseness,
+	// so moving scene nodes stay in their tree node longer and only move up to the nearest ancestor that fits.
+	// When ThreadUtil is initialized, GetRenderQuery, GetVisibleRenderables and GetVisibleShadowCasters split the top
+	// levels of large trees into jobs, results are merged in serial traversal order so they don't change between runs.
+	// With TransformStore enabled, frustum queries use SceneManager's streaming cull instead of the tree.
 	class FURY_API OcTree : public SceneManager, public std::enable_shared_from_this<OcTree>
 	{
 	public:
 
 		typedef std::shared_ptr<OcTree> Ptr;
 
-		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 6);
+		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 6, float looseness = 1.0f);
 
 	protected:
 
+		struct TraversalSegment
+		{
+			std::shared_ptr<OcTreeNode> treeNode;
+
+			// planes the tree node still straddles, 0 if it's fully inside.
+			unsigned int planeMask;
+
+			// walk the whole subtree, or the tree node's own scene nodes only.
+			bool recursive;
+		};
+
 		std::type_index m_TypeIndex;
 
 		std::shared_ptr<OcTreeNode> m_Root;
 
 		unsigned int m_MaxDepth;
 
+		float m_Looseness;
+
+		bool m_ParallelTraversal;
+
 	public:
 
-		OcTree(Vector4 min, Vector4 max, unsigned int maxDepth);
+		OcTree(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness = 1.0f);
 
 		~OcTree();
 
@@ -51,26 +74,48 @@ namespace fury
 
 		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const;
 
-		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear = true) const;
-
 		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
 
 		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
 
-		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const;
-
-		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const;
-
 		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const;
 
 		virtual void Reset(Vector4 min, Vector4 max, unsigned int maxDepth);
 
 		virtual void Clear();
 
+		float GetLooseness() const;
+
+		void SetParallelTraversal(bool enabled);
+
+		bool GetParallelTraversal() const;
+
 	protected:
 
 		void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode, const std::shared_ptr<OcTreeNode> &treeNode, unsigned int depth);
 
+		// the tree node sceneNode belongs to, searching down from treeNode.
+		std::shared_ptr<OcTreeNode> GetFitNode(const std::shared_ptr<SceneNode> &sceneNode, const std::shared_ptr<OcTreeNode> &treeNode, unsigned int depth);
+
+		void WalkCollider(const Collidable &collider, const std::shared_ptr<OcTreeNode> &startNode, bool startTested, bool recursive, const FilterFunc &filterFunc) const;
+
+		// frustum version of WalkScene, tree nodes pass the planes they straddle to their childs,
+		// scene nodes of each tree node are culled in one batch.
+		void WalkFrustum(const Frustum &frustum, const std::shared_ptr<OcTreeNode> &startNode, unsigned int startMask, bool recursive, const FilterFunc &filterFunc) const;
+
+		// culls the top levels of the tree and lists what's left in serial traversal order.
+		// returns false if the tree should be walked serially.
+		bool GetParallelSegments(const Collidable &collider, std::vector<TraversalSegment> &segments) const;
+
+		void AddSegments(const Collidable &collider, const Frustum *frustum, const std::shared_ptr<OcTreeNode> &treeNode,
+			unsigned int planeMask, unsigned int depth, std::vector<TraversalSegment> &segments) const;
+
+		void WalkSegments(const Collidable &collider, const std::vector<TraversalSegment> &segments,
+			size_t begin, size_t end, const FilterFunc &filterFunc) const;
+
+		// appends visible scene nodes passing predicate, returns false if the tree should be walked serially.
+		bool GatherParallel(const Collidable &collider, const std::function<bool(const std::shared_ptr<SceneNode>&)> &predicate, SceneNodes &sceneNodes) const;
+
 	};
 }
 
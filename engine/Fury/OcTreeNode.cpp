@@ -17,7 +17,11 @@ namespace fury
 		m_TypeIndex(typeid(OcTreeNode)), m_Manager(manager), m_Parent(parent), 
 		m_AABB(min, max), m_IsLeaf(false), m_TotalSceneNodeCount(0)
 	{
+		m_Depth = parent == nullptr ? 0 : parent->m_Depth + 1;
 
+		Vector4 center = m_AABB.GetCenter();
+		Vector4 looseExtents = m_AABB.GetExtents() * manager.GetLooseness();
+		m_LooseAABB.SetMinMax(center - looseExtents, center + looseExtents);
 	}
 
 	OcTreeNode::~OcTreeNode()
@@ -34,6 +38,30 @@ namespace fury
 	{
 		return m_AABB;
 	}
+
+	BoxBounds OcTreeNode::GetLooseAABB() const
+	{
+		return m_LooseAABB;
+	}
+
+	unsigned int OcTreeNode::GetDepth() const
+	{
+		return m_Depth;
+	}
+
+	bool OcTreeNode::IsLooseFit(const BoxBounds &other) const
+	{
+		if (other.GetInfinite())
+			return false;
+
+		Vector4 looseMin = m_LooseAABB.GetMin();
+		Vector4 looseMax = m_LooseAABB.GetMax();
+		Vector4 otherMin = other.GetMin();
+		Vector4 otherMax = other.GetMax();
+
+		return otherMin.x >= looseMin.x && otherMin.y >= looseMin.y && otherMin.z >= looseMin.z &&
+			otherMax.x <= looseMax.x && otherMax.y <= looseMax.y && otherMax.z <= looseMax.z;
+	}
 	
 	bool OcTreeNode::IsTwiceSize(BoxBounds other) const
 	{
@@ -56,11 +84,21 @@ namespace fury
 		Vector4 otherMin = other.GetMin();
 		Vector4 otherMax = other.GetMax();
 
+		// loose trees pick the child by center, then check it's loose bounds.
+		bool loose = m_Manager.GetLooseness() > 1.0f;
+
 		// test if boungbox is within this treeNode.
 
-		if (otherMin.x <= treeMin.x || otherMin.y <= treeMin.y || otherMin.z <= treeMin.z ||
+		if (loose)
+		{
+			if (!IsLooseFit(other))
+				return shared_from_this();
+		}
+		else if (otherMin.x <= treeMin.x || otherMin.y <= treeMin.y || otherMin.z <= treeMin.z ||
 			otherMax.x >= treeMax.x || otherMax.y >= treeMax.y || otherMax.z >= treeMax.z)
+		{
 			return shared_from_this();
+		}
 
 		// test with split planes to find the correct child to fit in.
 
@@ -70,21 +108,23 @@ namespace fury
 			Plane(treeCenter, treeCenter + Vector4::ZAxis, treeCenter + Vector4::YAxis)
 		};
 
+		Vector4 otherCenter = other.GetCenter();
+
 		bool collideResult[3];
 
 		// index = first + second * 2 + third * 4
 		int childIndex = 0;
 		for (int i = 0; i < 3; i++)
 		{
-			Side side = splitPlanes[i].IsInside(other);
+			Side side = loose ? splitPlanes[i].IsInside(otherCenter) : splitPlanes[i].IsInside(other);
 
-			if (side == Side::STRADDLE)
+			if (side == Side::STRADDLE && !loose)
 			{
 				return shared_from_this();
 			}
 			else
 			{
-				collideResult[i] = side == Side::IN;
+				collideResult[i] = side != Side::OUT;
 				childIndex += (collideResult[i] ? 1 : 0) * (int)pow(2, i);
 			}
 		}
@@ -101,9 +141,23 @@ namespace fury
 				1.0f
 			);
 
+			// don't create a child that can't hold other.
+			if (loose)
+			{
+				Vector4 childCenter = aabbMax - treeExtents * 0.5f;
+				Vector4 looseExtents = treeExtents * (0.5f * m_Manager.GetLooseness());
+				BoxBounds looseBounds(childCenter - looseExtents, childCenter + looseExtents);
+				if (!(otherMin >= looseBounds.GetMin() && otherMax <= looseBounds.GetMax()))
+					return shared_from_this();
+			}
+
 			m_Childs[childIndex] = child = OcTreeNode::Create(
 				m_Manager, shared_from_this(), aabbMax - treeExtents, aabbMax);
 		}
+		else if (loose && !child->IsLooseFit(other))
+		{
+			return shared_from_this();
+		}
 
 		return child;
 	}
@@ -155,14 +209,14 @@ namespace fury
 		}	
 	}
 
-	void OcTreeNode::AddSceneNode(const std::shared_ptr<SceneNode> &node)
+	void OcTreeNode::AddSceneNode(const std::shared_ptr<SceneNode> &node, const OcTreeNode *ancestor)
 	{
 		m_SceneNodes.push_back(node);
 		node->SetOcTreeNode(shared_from_this());
-		IncreaseSceneNodeCount();
+		IncreaseSceneNodeCount(ancestor);
 	}
 
-	void OcTreeNode::RemoveSceneNode(const std::shared_ptr<SceneNode> &node)
+	void OcTreeNode::RemoveSceneNode(const std::shared_ptr<SceneNode> &node, const OcTreeNode *ancestor)
 	{
 		auto it = m_SceneNodes.begin();
 		while (it != m_SceneNodes.end())
@@ -176,21 +230,19 @@ namespace fury
 		{
 			m_SceneNodes.erase(it);
 			node->SetOcTreeNode(nullptr);
-			DecreaseSceneNodeCount();
+			DecreaseSceneNodeCount(ancestor);
 		}
 	}
 
-	void OcTreeNode::IncreaseSceneNodeCount()
+	void OcTreeNode::IncreaseSceneNodeCount(const OcTreeNode *ancestor)
 	{
-		m_TotalSceneNodeCount++;
-		if (m_Parent != nullptr)
-			m_Parent->IncreaseSceneNodeCount();
+		for (OcTreeNode *treeNode = this; treeNode != ancestor && treeNode != nullptr; treeNode = treeNode->m_Parent.get())
+			treeNode->m_TotalSceneNodeCount++;
 	}
 
-	void OcTreeNode::DecreaseSceneNodeCount()
+	void OcTreeNode::DecreaseSceneNodeCount(const OcTreeNode *ancestor)
 	{
-		m_TotalSceneNodeCount--;
-		if (m_Parent != nullptr)
-			m_Parent->DecreaseSceneNodeCount();
+		for (OcTreeNode *treeNode = this; treeNode != ancestor && treeNode != nullptr; treeNode = treeNode->m_Parent.get())
+			treeNode->m_TotalSceneNodeCount--;
 	}
 }
\ No newline at end of file
@@ -35,6 +35,9 @@ namespace fury
 
 		BoxBounds m_AABB;
 
+		// m_AABB scaled by the manager's looseness, scene nodes in this tree node are inside it.
+		BoxBounds m_LooseAABB;
+
 		OcTree& m_Manager;
 
 		OcTreeNode::Ptr m_Childs[8];
@@ -45,6 +48,8 @@ namespace fury
 
 		bool m_IsLeaf;
 
+		unsigned int m_Depth;
+
 		unsigned int m_TotalSceneNodeCount;
 
 	public:
@@ -58,6 +63,14 @@ namespace fury
 
 		BoxBounds GetAABB() const;
 
+		BoxBounds GetLooseAABB() const;
+
+		// 0 for root.
+		unsigned int GetDepth() const;
+
+		// true if other is inside loose bounds.
+		bool IsLooseFit(const BoxBounds &other) const;
+
 		OcTree &GetManager() const;
 
 		bool IsTwiceSize(BoxBounds other) const;
@@ -76,15 +89,17 @@ namespace fury
 
 		void Clear();
 
-		void AddSceneNode(const std::shared_ptr<SceneNode> &node);
+		// scene node counts are updated up to, but not including, ancestor. nullptr updates all.
+
+		void AddSceneNode(const std::shared_ptr<SceneNode> &node, const OcTreeNode *ancestor = nullptr);
 
-		void RemoveSceneNode(const std::shared_ptr<SceneNode> &node);
+		void RemoveSceneNode(const std::shared_ptr<SceneNode> &node, const OcTreeNode *ancestor = nullptr);
 
 	protected:
 
-		void IncreaseSceneNodeCount();
+		void IncreaseSceneNodeCount(const OcTreeNode *ancestor);
 
-		void DecreaseSceneNodeCount();
+		void DecreaseSceneNodeCount(const OcTreeNode *ancestor);
 
 	};
 }
@@ -0,0 +1,529 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BufferManager.h"
+#include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
+#include "Fury/Log.h"
+#include "Fury/OcclusionCuller.h"
+#include "Fury/StreamBuffer.h"
+#include "Fury/Texture.h"
+
+namespace fury
+{
+	// level 0 copies depth, the others are 2x2 max of the previous level, last row and column also take the odd edge.
+	static const char *PYRAMID_SHADER =
+		"#version 430\n"
+		"layout(local_size_x = 8, local_size_y = 8) in;\n"
+		"uniform sampler2D depth_texture;\n"
+		"uniform int first_level;\n"
+		"layout(r32f, binding = 0) readonly uniform image2D source;\n"
+		"layout(r32f, binding = 1) writeonly uniform image2D destination;\n"
+		"void main() {\n"
+		"	ivec2 p = ivec2(gl_GlobalInvocationID.xy);\n"
+		"	ivec2 size = imageSize(destination);\n"
+		"	if (p.x >= size.x || p.y >= size.y) return;\n"
+		"	if (first_level != 0) {\n"
+		"		imageStore(destination, p, vec4(texelFetch(depth_texture, p, 0).r));\n"
+		"		return;\n"
+		"	}\n"
+		"	ivec2 sourceSize = imageSize(source);\n"
+		"	ivec2 lo = p * 2;\n"
+		"	ivec2 hi = min(lo + 1, sourceSize - 1);\n"
+		"	if (p.x == size.x - 1) hi.x = sourceSize.x - 1;\n"
+		"	if (p.y == size.y - 1) hi.y = sourceSize.y - 1;\n"
+		"	float depth = 0.0;\n"
+		"	for (int y = lo.y; y <= hi.y; y++)\n"
+		"		for (int x = lo.x; x <= hi.x; x++)\n"
+		"			depth = max(depth, imageLoad(source, ivec2(x, y)).r);\n"
+		"	imageStore(destination, p, vec4(depth));\n"
+		"}\n";
+
+	// one instance per invocation, visible ones take a slot of their command.
+	static const char *CULL_SHADER =
+		"#version 430\n"
+		"layout(local_size_x = 64) in;\n"
+		"struct Command { uint count; uint instanceCount; uint firstIndex; int baseVertex; uint baseInstance; };\n"
+		"layout(std430, binding = 0) readonly buffer Instances { mat4 instances[]; };\n"
+		"layout(std430, binding = 1) readonly buffer Bounds { vec4 bounds[]; };\n"
+		"layout(std430, binding = 2) buffer Commands { Command commands[]; };\n"
+		"layout(std430, binding = 3) writeonly buffer Culled { mat4 culled[]; };\n"
+		"uniform sampler2D pyramid;\n"
+		"uniform mat4 pyramid_view_proj;\n"
+		"uniform mat4 view_proj;\n"
+		"uniform int instance_count;\n"
+		"uniform int level_count;\n"
+		"bool IsVisible(vec3 bmin, vec3 bmax) {\n"
+		"	uint frustumMask = 63u;\n"
+		"	bool behind = false;\n"
+		"	vec3 ndcMin = vec3(1e30);\n"
+		"	vec3 ndcMax = vec3(-1e30);\n"
+		"	for (int i = 0; i < 8; i++) {\n"
+		"		vec4 corner = vec4((i & 1) != 0 ? bmax.x : bmin.x, (i & 2) != 0 ? bmax.y : bmin.y, (i & 4) != 0 ? bmax.z : bmin.z, 1.0);\n"
+		"		vec4 c = view_proj * corner;\n"
+		"		uint mask = 0u;\n"
+		"		if (c.x < -c.w) mask |= 1u;\n"
+		"		if (c.x > c.w) mask |= 2u;\n"
+		"		if (c.y < -c.w) mask |= 4u;\n"
+		"		if (c.y > c.w) mask |= 8u;\n"
+		"		if (c.z < -c.w) mask |= 16u;\n"
+		"		if (c.z > c.w) mask |= 32u;\n"
+		"		frustumMask &= mask;\n"
+		"		c = pyramid_view_proj * corner;\n"
+		"		if (c.w <= 0.0) { behind = true; continue; }\n"
+		"		vec3 ndc = c.xyz / c.w;\n"
+		"		ndcMin = min(ndcMin, ndc);\n"
+		"		ndcMax = max(ndcMax, ndc);\n"
+		"	}\n"
+		"	if (frustumMask != 0u) return false;\n"
+		"	if (behind || level_count == 0) return true;\n"
+		"	ivec2 size = textureSize(pyramid, 0);\n"
+		"	vec2 uvMin = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0);\n"
+		"	vec2 uvMax = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0);\n"
+		"	ivec2 lo = min(ivec2(uvMin * vec2(size)), size - 1);\n"
+		"	ivec2 hi = min(ivec2(uvMax * vec2(size)), size - 1);\n"
+		"	int level = 0;\n"
+		"	while (level < level_count - 1 && max((hi.x >> level) - (lo.x >> level), (hi.y >> level) - (lo.y >> level)) > 1) level++;\n"
+		"	ivec2 levelSize = textureSize(pyramid, level);\n"
+		"	ivec2 a = min(lo >> level, levelSize - 1);\n"
+		"	ivec2 b = min(hi >> level, levelSize - 1);\n"
+		"	float depth = 0.0;\n"
+		"	for (int y = a.y; y <= b.y; y++)\n"
+		"		for (int x = a.x; x <= b.x; x++)\n"
+		"			depth = max(depth, texelFetch(pyramid, ivec2(x, y), level).r);\n"
+		"	return ndcMin.z * 0.5 + 0.5 <= depth;\n"
+		"}\n"
+		"void main() {\n"
+		"	int index = int(gl_GlobalInvocationID.x);\n"
+		"	if (index >= instance_count) return;\n"
+		"	vec4 bmin = bounds[index * 2];\n"
+		"	vec4 bmax = bounds[index * 2 + 1];\n"
+		"	if (!IsVisible(bmin.xyz, bmax.xyz)) return;\n"
+		"	uint command = floatBitsToUint(bmin.w);\n"
+		"	uint slot = atomicAdd(commands[command].instanceCount, 1u);\n"
+		"	culled[commands[command].baseInstance + slot] = instances[floatBitsToUint(bmax.w)];\n"
+		"}\n";
+
+	OcclusionCuller::Ptr OcclusionCuller::Create()
+	{
+		return std::make_shared<OcclusionCuller>();
+	}
+
+	bool OcclusionCuller::IsSupported()
+	{
+		return glDispatchCompute != nullptr && glMemoryBarrier != nullptr &&
+			glBindImageTexture != nullptr && glMultiDrawElementsIndirect != nullptr;
+	}
+
+	void OcclusionCuller::BuildPyramid(const float *depth, int width, int height, std::vector<Level> &pyramid)
+	{
+		pyramid.clear();
+		if (depth == nullptr || width <= 0 || height <= 0)
+			return;
+
+		Level first = { width, height, std::vector<float>(depth, depth + width * height) };
+		pyramid.push_back(first);
+
+		while (pyramid.back().width > 1 || pyramid.back().height > 1)
+		{
+			const Level &source = pyramid.back();
+
+			Level level;
+			level.width = std::max(1, source.width / 2);
+			level.height = std::max(1, source.height / 2);
+			level.depths.resize(level.width * level.height);
+
+			for (int y = 0; y < level.height; y++)
+			{
+				int loY = y * 2;
+				int hiY = y == level.height - 1 ? source.height - 1 : std::min(loY + 1, source.height - 1);
+
+				for (int x = 0; x < level.width; x++)
+				{
+					int loX = x * 2;
+					int hiX = x == level.width - 1 ? source.width - 1 : std::min(loX + 1, source.width - 1);
+
+					float value = 0.0f;
+					for (int sy = loY; sy <= hiY; sy++)
+						for (int sx = loX; sx <= hiX; sx++)
+							value = std::max(value, source.depths[sy * source.width + sx]);
+
+					level.depths[y * level.width + x] = value;
+				}
+			}
+
+			pyramid.push_back(std::move(level));
+		}
+	}
+
+	bool OcclusionCuller::IsVisible(const std::vector<Level> &pyramid, const Matrix4 &pyramidViewProj,
+		const Matrix4 &viewProj, const BoxBounds &aabb)
+	{
+		Vector4 bmin = aabb.GetMin();
+		Vector4 bmax = aabb.GetMax();
+
+		unsigned int frustumMask = 63;
+		bool behind = false;
+		float ndcMin[3] = { 1e30f, 1e30f, 1e30f };
+		float ndcMax[3] = { -1e30f, -1e30f, -1e30f };
+
+		for (int i = 0; i < 8; i++)
+		{
+			Vector4 corner((i & 1) ? bmax.x : bmin.x, (i & 2) ? bmax.y : bmin.y, (i & 4) ? bmax.z : bmin.z, 1.0f);
+
+			Vector4 c = viewProj.Multiply(corner);
+			unsigned int mask = 0;
+			if (c.x < -c.w) mask |= 1;
+			if (c.x > c.w) mask |= 2;
+			if (c.y < -c.w) mask |= 4;
+			if (c.y > c.w) mask |= 8;
+			if (c.z < -c.w) mask |= 16;
+			if (c.z > c.w) mask |= 32;
+			frustumMask &= mask;
+
+			c = pyramidViewProj.Multiply(corner);
+			if (c.w <= 0.0f)
+			{
+				behind = true;
+				continue;
+			}
+
+			float ndc[3] = { c.x / c.w, c.y / c.w, c.z / c.w };
+			for (int k = 0; k < 3; k++)
+			{
+				ndcMin[k] = std::min(ndcMin[k], ndc[k]);
+				ndcMax[k] = std::max(ndcMax[k], ndc[k]);
+			}
+		}
+
+		// all corners outside one plane.
+		if (frustumMask != 0)
+			return false;
+
+		// crossing the near plane, can't bound it on screen.
+		if (behind || pyramid.empty())
+			return true;
+
+		const Level &first = pyramid.front();
+		int size[2] = { first.width, first.height };
+		int lo[2], hi[2];
+		for (int k = 0; k < 2; k++)
+		{
+			float uvMin = std::min(std::max(ndcMin[k] * 0.5f + 0.5f, 0.0f), 1.0f);
+			float uvMax = std::min(std::max(ndcMax[k] * 0.5f + 0.5f, 0.0f), 1.0f);
+			lo[k] = std::min((int)(uvMin * size[k]), size[k] - 1);
+			hi[k] = std::min((int)(uvMax * size[k]), size[k] - 1);
+		}
+
+		// smallest level where the rect covers at most 2x2 texels.
+		int level = 0;
+		int levelCount = pyramid.size();
+		while (level < levelCount - 1 && std::max((hi[0] >> level) - (lo[0] >> level), (hi[1] >> level) - (lo[1] >> level)) > 1)
+			level++;
+
+		const Level &target = pyramid[level];
+		int ax = std::min(lo[0] >> level, target.width - 1);
+		int ay = std::min(lo[1] >> level, target.height - 1);
+		int bx = std::min(hi[0] >> level, target.width - 1);
+		int by = std::min(hi[1] >> level, target.height - 1);
+
+		float depth = 0.0f;
+		for (int y = ay; y <= by; y++)
+			for (int x = ax; x <= bx; x++)
+				depth = std::max(depth, target.depths[y * target.width + x]);
+
+		return ndcMin[2] * 0.5f + 0.5f <= depth;
+	}
+
+	void OcclusionCuller::Cull(const std::vector<Level> &pyramid, const Matrix4 &pyramidViewProj, const Matrix4 &viewProj,
+		const std::vector<float> &instances, const std::vector<float> &bounds,
+		std::vector<DrawElementsIndirectCommand> &commands, std::vector<float> &culled)
+	{
+		culled.assign(instances.size(), 0.0f);
+		for (auto &command : commands)
+			command.instanceCount = 0;
+
+		for (size_t i = 0; i + 8 <= bounds.size(); i += 8)
+		{
+			const float *raw = &bounds[i];
+			BoxBounds aabb(Vector4(raw[0], raw[1], raw[2], 1.0f), Vector4(raw[4], raw[5], raw[6], 1.0f));
+			if (!IsVisible(pyramid, pyramidViewProj, viewProj, aabb))
+				continue;
+
+			unsigned int command, matrix;
+			std::memcpy(&command, &raw[3], sizeof(unsigned int));
+			std::memcpy(&matrix, &raw[7], sizeof(unsigned int));
+
+			auto &cmd = commands[command];
+			unsigned int slot = cmd.baseInstance + cmd.instanceCount++;
+			std::copy(&instances[matrix * 16], &instances[matrix * 16] + 16, &culled[slot * 16]);
+		}
+	}
+
+	OcclusionCuller::OcclusionCuller()
+	{
+		m_Stream = StreamBuffer::Create("OcclusionCullerStream", GL_SHADER_STORAGE_BUFFER, 256 * 1024);
+	}
+
+	OcclusionCuller::~OcclusionCuller()
+	{
+		DeleteBuffer();
+	}
+
+	void OcclusionCuller::BuildPyramid(const std::shared_ptr<Texture> &depthTexture, const Matrix4 &viewProj)
+	{
+		if (!IsSupported() || depthTexture == nullptr || depthTexture->GetID() == 0 || !CreatePrograms())
+			return;
+
+		int width = depthTexture->GetWidth();
+		int height = depthTexture->GetHeight();
+
+		if (m_Pyramid == 0 || width != m_PyramidWidth || height != m_PyramidHeight)
+		{
+			if (m_Pyramid != 0)
+			{
+				GLState::OnDeleteTexture(m_Pyramid);
+				glDeleteTextures(1, &m_Pyramid);
+				BufferManager::Instance()->DecreaseMemory(m_PyramidWidth * m_PyramidHeight * 4 * 4 / 3);
+			}
+
+			m_PyramidWidth = width;
+			m_PyramidHeight = height;
+			m_PyramidLevels = (int)std::floor(std::log2((float)std::max(width, height))) + 1;
+
+			glGenTextures(1, &m_Pyramid);
+			GLState::ActiveTexture(GL_TEXTURE0);
+			GLState::BindTexture(GL_TEXTURE_2D, m_Pyramid);
+			glTexStorage2D(GL_TEXTURE_2D, m_PyramidLevels, GL_R32F, width, height);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			GLState::BindTexture(GL_TEXTURE_2D, 0);
+
+			BufferManager::Instance()->IncreaseMemory(width * height * 4 * 4 / 3);
+		}
+
+		GLState::UseProgram(m_PyramidProgram);
+		glUniform1i(glGetUniformLocation(m_PyramidProgram, "depth_texture"), 0);
+		int firstLevel = glGetUniformLocation(m_PyramidProgram, "first_level");
+
+		GLState::ActiveTexture(GL_TEXTURE0);
+		GLState::BindTexture(GL_TEXTURE_2D, depthTexture->GetID());
+
+		for (int level = 0; level < m_PyramidLevels; level++)
+		{
+			int levelWidth = std::max(1, width >> level);
+			int levelHeight = std::max(1, height >> level);
+
+			glUniform1i(firstLevel, level == 0 ? 1 : 0);
+			glBindImageTexture(0, m_Pyramid, std::max(level - 1, 0), GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			glBindImageTexture(1, m_Pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			glDispatchCompute((levelWidth + 7) / 8, (levelHeight + 7) / 8, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		GLState::BindTexture(GL_TEXTURE_2D, 0);
+
+		m_PyramidViewProj = viewProj;
+	}
+
+	bool OcclusionCuller::Cull(const Matrix4 &viewProj, const std::vector<float> &instances, const std::vector<float> &bounds,
+		const std::vector<DrawElementsIndirectCommand> &commands)
+	{
+		if (!IsSupported() || instances.empty() || bounds.empty() || commands.empty() || !CreatePrograms())
+			return false;
+
+		// cull shader counts instances again.
+		std::vector<DrawElementsIndirectCommand> zeroed(commands);
+		for (auto &command : zeroed)
+			command.instanceCount = 0;
+
+		// inputs go to the ring instead of orphaning, a growing ring keeps earlier buffers alive for this frame.
+		unsigned int buffer;
+		Upload(0, &instances[0], instances.size() * sizeof(float), buffer);
+		Upload(1, &bounds[0], bounds.size() * sizeof(float), buffer);
+		m_CommandOffset = Upload(2, &zeroed[0], zeroed.size() * sizeof(DrawElementsIndirectCommand), m_CommandBuffer);
+
+		// only the cull shader writes culled matrices, so earlier draws reading them are ordered by gl.
+		size_t culledSize = instances.size() * sizeof(float);
+		if (m_CulledBuffer == 0 || culledSize > m_CulledSize)
+		{
+			if (m_CulledBuffer == 0)
+				glGenBuffers(1, &m_CulledBuffer);
+
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_CulledBuffer);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, culledSize, nullptr, GL_DYNAMIC_COPY);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+			BufferManager::Instance()->DecreaseMemory(m_CulledSize);
+			BufferManager::Instance()->IncreaseMemory(culledSize);
+			m_CulledSize = culledSize;
+		}
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_CulledBuffer);
+
+		int instanceCount = bounds.size() / 8;
+
+		GLState::UseProgram(m_CullProgram);
+		glUniformMatrix4fv(glGetUniformLocation(m_CullProgram, "pyramid_view_proj"), 1, false, m_PyramidViewProj.Raw);
+		glUniformMatrix4fv(glGetUniformLocation(m_CullProgram, "view_proj"), 1, false, viewProj.Raw);
+		glUniform1i(glGetUniformLocation(m_CullProgram, "instance_count"), instanceCount);
+		glUniform1i(glGetUniformLocation(m_CullProgram, "level_count"), m_Pyramid != 0 ? m_PyramidLevels : 0);
+		glUniform1i(glGetUniformLocation(m_CullProgram, "pyramid"), 0);
+
+		GLState::ActiveTexture(GL_TEXTURE0);
+		GLState::BindTexture(GL_TEXTURE_2D, m_Pyramid);
+
+		glDispatchCompute((instanceCount + 63) / 64, 1, 1);
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+		for (unsigned int i = 0; i < 4; i++)
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, 0);
+
+		GLState::BindTexture(GL_TEXTURE_2D, 0);
+
+		return true;
+	}
+
+	unsigned int OcclusionCuller::GetCommandBuffer() const
+	{
+		return m_CommandBuffer;
+	}
+
+	size_t OcclusionCuller::GetCommandOffset() const
+	{
+		return m_CommandOffset;
+	}
+
+	unsigned int OcclusionCuller::GetInstanceBuffer() const
+	{
+		return m_CulledBuffer;
+	}
+
+	bool OcclusionCuller::HasPyramid() const
+	{
+		return m_Pyramid != 0;
+	}
+
+	void OcclusionCuller::ReadPyramid(std::vector<Level> &pyramid) const
+	{
+		pyramid.clear();
+		if (m_Pyramid == 0)
+			return;
+
+		GLState::ActiveTexture(GL_TEXTURE0);
+		GLState::BindTexture(GL_TEXTURE_2D, m_Pyramid);
+
+		for (int i = 0; i < m_PyramidLevels; i++)
+		{
+			Level level;
+			level.width = std::max(1, m_PyramidWidth >> i);
+			level.height = std::max(1, m_PyramidHeight >> i);
+			level.depths.resize(level.width * level.height);
+			glGetTexImage(GL_TEXTURE_2D, i, GL_RED, GL_FLOAT, &level.depths[0]);
+			pyramid.push_back(std::move(level));
+		}
+
+		GLState::BindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OcclusionCuller::DeleteBuffer()
+	{
+		m_Stream->DeleteBuffer();
+		m_CommandBuffer = 0;
+		m_CommandOffset = 0;
+
+		if (m_CulledBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_CulledBuffer);
+			if (BufferManager::HasInstance())
+				BufferManager::Instance()->DecreaseMemory(m_CulledSize);
+			m_CulledBuffer = 0;
+			m_CulledSize = 0;
+		}
+
+		if (m_Pyramid != 0)
+		{
+			GLState::OnDeleteTexture(m_Pyramid);
+			glDeleteTextures(1, &m_Pyramid);
+			if (BufferManager::HasInstance())
+				BufferManager::Instance()->DecreaseMemory(m_PyramidWidth * m_PyramidHeight * 4 * 4 / 3);
+			m_Pyramid = 0;
+		}
+
+		if (m_PyramidProgram != 0)
+		{
+			GLState::OnDeleteProgram(m_PyramidProgram);
+			glDeleteProgram(m_PyramidProgram);
+			m_PyramidProgram = 0;
+		}
+
+		if (m_CullProgram != 0)
+		{
+			GLState::OnDeleteProgram(m_CullProgram);
+			glDeleteProgram(m_CullProgram);
+			m_CullProgram = 0;
+		}
+	}
+
+	bool OcclusionCuller::CreatePrograms()
+	{
+		if (m_PyramidProgram != 0 && m_CullProgram != 0)
+			return true;
+
+		const char *sources[2] = { PYRAMID_SHADER, CULL_SHADER };
+		unsigned int *programs[2] = { &m_PyramidProgram, &m_CullProgram };
+
+		char logbuffer[1024];
+		int logbufferLen;
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (*programs[i] != 0)
+				continue;
+
+			unsigned int shader = glCreateShader(GL_COMPUTE_SHADER);
+			glShaderSource(shader, 1, &sources[i], nullptr);
+			glCompileShader(shader);
+
+			GLint status;
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+			if (status != GL_TRUE)
+			{
+				glGetShaderInfoLog(shader, sizeof(logbuffer), &logbufferLen, logbuffer);
+				FURYE << "OcclusionCuller's compute shader compile failed!";
+				FURYE << std::string(logbuffer, logbufferLen);
+				glDeleteShader(shader);
+				return false;
+			}
+
+			unsigned int program = glCreateProgram();
+			glAttachShader(program, shader);
+			glLinkProgram(program);
+			glDeleteShader(shader);
+
+			glGetProgramiv(program, GL_LINK_STATUS, &status);
+			if (status != GL_TRUE)
+			{
+				glGetProgramInfoLog(program, sizeof(logbuffer), &logbufferLen, logbuffer);
+				FURYE << "OcclusionCuller's compute program link failed!";
+				FURYE << std::string(logbuffer, logbufferLen);
+				glDeleteProgram(program);
+				return false;
+			}
+
+			*programs[i] = program;
+		}
+
+		return true;
+	}
+
+	size_t OcclusionCuller::Upload(unsigned int binding, const void *data, size_t size, unsigned int &buffer)
+	{
+		size_t offset = m_Stream->Upload(data, size, sizeof(float) * 4);
+		buffer = m_Stream->GetID();
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer, offset, size);
+		return offset;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef _FURY_OCCLUSION_CULLER_H_
+#define _FURY_OCCLUSION_CULLER_H_
+
+#include <memory>
+#include <vector>
+
+#include "Fury/Matrix4.h"
+#include "Fury/RenderQuery.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	class StreamBuffer;
+
+	class Texture;
+
+	// Culls instances of indirect draws on gpu, against the frustum and a hierarchical-z pyramid built
+	// from last frame's depth. Visible world matrices are compacted per command and the commands'
+	// instance counts are written by the cull shader, so the draws never come back to cpu.
+	// Needs compute shaders (GL 4.3), IsSupported tells. Static functions are the cpu reference
+	// of both shaders, they produce the same pyramid and commands for headless validation.
+	class FURY_API OcclusionCuller
+	{
+	public:
+
+		typedef std::shared_ptr<OcclusionCuller> Ptr;
+
+		// one mip of the pyramid, each texel is the farthest depth of the texels it covers.
+		struct Level
+		{
+			int width;
+
+			int height;
+
+			std::vector<float> depths;
+		};
+
+		static Ptr Create();
+
+		static bool IsSupported();
+
+		// max reduction of a width x height depth buffer, odd edges fold into the last texel.
+		static void BuildPyramid(const float *depth, int width, int height, std::vector<Level> &pyramid);
+
+		// false if aabb is outside viewProj's frustum, or behind the depth pyramidViewProj rendered into pyramid.
+		// empty pyramid only tests frustum.
+		static bool IsVisible(const std::vector<Level> &pyramid, const Matrix4 &pyramidViewProj,
+			const Matrix4 &viewProj, const BoxBounds &aabb);
+
+		// same as the cull shader. instances are world matrices, bounds are two vec4 per instance:
+		// min.xyz with command index bits in w, max.xyz with matrix index bits in w.
+		// commands' instance counts are recounted, visible matrices go to culled at baseInstance + n.
+		static void Cull(const std::vector<Level> &pyramid, const Matrix4 &pyramidViewProj, const Matrix4 &viewProj,
+			const std::vector<float> &instances, const std::vector<float> &bounds,
+			std::vector<DrawElementsIndirectCommand> &commands, std::vector<float> &culled);
+
+	protected:
+
+		unsigned int m_PyramidProgram = 0;
+
+		unsigned int m_CullProgram = 0;
+
+		unsigned int m_Pyramid = 0;
+
+		int m_PyramidWidth = 0;
+
+		int m_PyramidHeight = 0;
+
+		int m_PyramidLevels = 0;
+
+		// view projection the pyramid's depth was rendered with.
+		Matrix4 m_PyramidViewProj;
+
+		// instances, bounds and zeroed commands of each Cull, in this frame's region of the ring.
+		std::shared_ptr<StreamBuffer> m_Stream;
+
+		// commands counted by the cull shader, in m_Stream's buffer.
+		unsigned int m_CommandBuffer = 0;
+
+		size_t m_CommandOffset = 0;
+
+		// visible matrices written by the cull shader, only reallocated to grow.
+		unsigned int m_CulledBuffer = 0;
+
+		size_t m_CulledSize = 0;
+
+	public:
+
+		OcclusionCuller();
+
+		virtual ~OcclusionCuller();
+
+		// builds the pyramid from depthTexture, call after the pass writing it.
+		void BuildPyramid(const std::shared_ptr<Texture> &depthTexture, const Matrix4 &viewProj);
+
+		// uploads and culls against viewProj and the pyramid, then GetCommandBuffer and GetInstanceBuffer hold the draws.
+		// commands' baseInstance must be absolute matrix indices. false if nothing was culled, draw the originals.
+		bool Cull(const Matrix4 &viewProj, const std::vector<float> &instances, const std::vector<float> &bounds,
+			const std::vector<DrawElementsIndirectCommand> &commands);
+
+		unsigned int GetCommandBuffer() const;
+
+		// byte offset of the first command in GetCommandBuffer.
+		size_t GetCommandOffset() const;
+
+		unsigned int GetInstanceBuffer() const;
+
+		bool HasPyramid() const;
+
+		// reads the gpu pyramid back, for comparing with the cpu reference.
+		void ReadPyramid(std::vector<Level> &pyramid) const;
+
+		void DeleteBuffer();
+
+	protected:
+
+		bool CreatePrograms();
+
+		// streams data and binds it to shader storage binding, returns it's offset in buffer.
+		size_t Upload(unsigned int binding, const void *data, size_t size, unsigned int &buffer);
+	};
+}
+
+#endif // _FURY_OCCLUSION_CULLER_H_
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "Fury/FileUtil.h"
 #include "Fury/Frustum.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
 #include "Fury/Material.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Mesh.h"
@@ -265,10 +266,18 @@ namespace fury
 	{
 		collisions.erase(collisions.begin(), collisions.end());
 
-		for (auto possible : possibles)
+		// test in parallel, then gather serially to keep the original order.
+		std::vector<char> results(possibles.size(), 0);
+		ThreadUtil::ParallelFor(0, possibles.size(), 256, [&](size_t chunkBegin, size_t chunkEnd)
 		{
-			if (collider.IsInsideFast(possible->GetWorldAABB()))
-				collisions.push_back(possible);
+			for (size_t i = chunkBegin; i < chunkEnd; i++)
+				results[i] = collider.IsInsideFast(possibles[i]->GetWorldAABB()) ? 1 : 0;
+		});
+
+		for (size_t i = 0; i < possibles.size(); i++)
+		{
+			if (results[i])
+				collisions.push_back(possibles[i]);
 		}
 	}
 
@@ -408,15 +417,15 @@ namespace fury
 
 			m_SharedPass->Bind();
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
+			GLState::Enable(GL_POLYGON_OFFSET_FILL);
 			glPolygonOffset(1.0f, 1024.0f);
 
 			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX_HASH, &lightMatrix.Raw[0]);
 
 			for (int i = 0; i < numSplit; i++)
 			{
-				depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrices[i].Raw[0]);
+				depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX_HASH, &projMatrices[i].Raw[0]);
 
 				m_SharedPass->SetArrayTextureLayer(i);
 
@@ -427,7 +436,7 @@ namespace fury
 					auto casterMesh = casterRender->GetMesh();
 
 					depth_shader->BindMesh(casterMesh);
-					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, &caster->GetWorldMatrix().Raw[0]);
 
 					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
 					RenderUtil::Instance()->IncreaseDrawCall();
@@ -436,7 +445,7 @@ namespace fury
 				}
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
+			GLState::Disable(GL_POLYGON_OFFSET_FILL);
 			depth_shader->UnBind();
 
 			m_SharedPass->UnBind();
@@ -493,12 +502,12 @@ namespace fury
 
 			m_SharedPass->Bind();
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
+			GLState::Enable(GL_POLYGON_OFFSET_FILL);
 			glPolygonOffset(1.0f, 1024.0f);
 
 			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX_HASH, &lightMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX_HASH, &projMatrix.Raw[0]);
 
 			for (auto &caster : casters)
 			{
@@ -506,7 +515,7 @@ namespace fury
 				auto casterMesh = casterRender->GetMesh();
 
 				depth_shader->BindMesh(casterMesh);
-				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, &caster->GetWorldMatrix().Raw[0]);
 
 				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
 				RenderUtil::Instance()->IncreaseDrawCall();
@@ -514,7 +523,7 @@ namespace fury
 				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
+			GLState::Disable(GL_POLYGON_OFFSET_FILL);
 			depth_shader->UnBind();
 
 			m_SharedPass->UnBind();
@@ -574,7 +583,7 @@ namespace fury
 			glPolygonOffset(factor, units);*/
 
 			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX_HASH, &projMatrix.Raw[0]);
 			depth_shader->BindFloat("light_far", radius);
 			depth_shader->BindFloat("light_pos", lightPos.x, lightPos.y, lightPos.z);
 
@@ -592,8 +601,8 @@ namespace fury
 					auto ivm = dirMatrices[i];
 
 					depth_shader->BindMesh(casterMesh);
-					depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &ivm.Raw[0]);
-					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+					depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX_HASH, &ivm.Raw[0]);
+					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, &caster->GetWorldMatrix().Raw[0]);
 
 					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
 					RenderUtil::Instance()->IncreaseDrawCall();
@@ -656,12 +665,12 @@ namespace fury
 
 			m_SharedPass->Bind();
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
+			GLState::Enable(GL_POLYGON_OFFSET_FILL);
 			glPolygonOffset(1.0f, 1024.0f);
 
 			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX_HASH, &lightMatrix.Raw[0]);
+			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX_HASH, &projMatrix.Raw[0]);
 
 			for (auto &caster : casters)
 			{
@@ -669,7 +678,7 @@ namespace fury
 				auto casterMesh = casterRender->GetMesh();
 
 				depth_shader->BindMesh(casterMesh);
-				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, &caster->GetWorldMatrix().Raw[0]);
 
 				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
 				RenderUtil::Instance()->IncreaseDrawCall();
@@ -677,7 +686,7 @@ namespace fury
 				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
+			GLState::Disable(GL_POLYGON_OFFSET_FILL);
 			depth_shader->UnBind();
 
 			m_SharedPass->UnBind();
@@ -692,10 +701,10 @@ namespace fury
 
 		glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_CULL_FACE);
-		glCullFace(GL_BACK);
-		glDisable(GL_BLEND);
+		GLState::Enable(GL_DEPTH_TEST);
+		GLState::Enable(GL_CULL_FACE);
+		GLState::CullFace(GL_BACK);
+		GLState::Disable(GL_BLEND);
 
 		auto meshBoundsOn = IsSwitchOn(PipelineSwitch::MESH_BOUNDS);
 		auto customBoundsOn = IsSwitchOn(PipelineSwitch::CUSTOM_BOUNDS);
@@ -743,6 +752,6 @@ namespace fury
 
 		renderUtil->EndDrawMeshes();
 
-		glDisable(GL_DEPTH_TEST);
+		GLState::Disable(GL_DEPTH_TEST);
 	}
 }
\ No newline at end of file
@@ -42,6 +42,10 @@ namespace fury
 		MESH_BOUNDS, 
 		LIGHT_BOUNDS, 
 		CUSTOM_BOUNDS, 
+		INSTANCING, 
+		MESH_POOL, 
+		MULTI_DRAW_INDIRECT, 
+		OCCLUSION_CULLING, 
 		LENGTH
 	};
 
@@ -0,0 +1,46 @@
+#include <algorithm>
+
+#include "Fury/PoseBuffer.h"
+
+namespace fury
+{
+	PoseBuffer PoseArena::Allocate(unsigned int count)
+	{
+		PoseBuffer buffer;
+		if (count == 0)
+			return buffer;
+
+		while (m_Block < m_Blocks.size() && m_Blocks[m_Block].size() - m_Offset < count)
+		{
+			m_Block++;
+			m_Offset = 0;
+		}
+
+		if (m_Block == m_Blocks.size())
+		{
+			m_Blocks.push_back(AlignedVector<Skeleton::JointPose>(std::max(count, BLOCK_SIZE)));
+			m_Offset = 0;
+		}
+
+		buffer.poses = &m_Blocks[m_Block][m_Offset];
+		buffer.count = count;
+		m_Offset += count;
+
+		return buffer;
+	}
+
+	void PoseArena::Reset()
+	{
+		m_Block = 0;
+		m_Offset = 0;
+	}
+
+	size_t PoseArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (const auto &block : m_Blocks)
+			capacity += block.size();
+
+		return capacity;
+	}
+}
\ No newline at end of file
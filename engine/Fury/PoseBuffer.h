@@ -0,0 +1,53 @@
+#ifndef _FURY_POSE_BUFFER_H_
+#define _FURY_POSE_BUFFER_H_
+
+#include <deque>
+
+#include "Fury/AlignedAllocator.h"
+#include "Fury/Skeleton.h"
+
+namespace fury
+{
+	// local pose of every joint of a skeleton, indexed like Skeleton's flat joints.
+	// doesn't own its poses, buffers from a PoseArena are valid until the arena's Reset.
+	struct FURY_API PoseBuffer
+	{
+	public:
+
+		Skeleton::JointPose *poses = nullptr;
+
+		unsigned int count = 0;
+	};
+
+	// Per frame linear allocator for temporary PoseBuffers.
+	// Reset rewinds it but keeps its blocks, so blending the same layers every frame allocates nothing.
+	// Not thread safe, each AnimationPlayer owns one.
+	class FURY_API PoseArena
+	{
+	public:
+
+		// poses per block, larger requests get a block of their own size.
+		static const unsigned int BLOCK_SIZE = 256;
+
+	protected:
+
+		// blocks never grow and a deque doesn't move them, so handed out buffers stay put.
+		std::deque<AlignedVector<Skeleton::JointPose>> m_Blocks;
+
+		unsigned int m_Block = 0;
+
+		unsigned int m_Offset = 0;
+
+	public:
+
+		// poses are left as they were, fill them before reading.
+		PoseBuffer Allocate(unsigned int count);
+
+		void Reset();
+
+		// poses held by all blocks.
+		size_t GetCapacity() const;
+	};
+}
+
+#endif // _FURY_POSE_BUFFER_H_
\ No newline at end of file
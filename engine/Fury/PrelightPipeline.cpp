@@ -1,5 +1,6 @@
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <unordered_map>
 
 #include "Fury/Camera.h"
@@ -7,13 +8,16 @@
 #include "Fury/EnumUtil.h"
 #include "Fury/Frustum.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
 #include "Fury/Gui.h"
 #include "Fury/Light.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Material.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
 #include "Fury/MeshRender.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/OcclusionCuller.h"
 #include "Fury/Pass.h"
 #include "Fury/PrelightPipeline.h"
 #include "Fury/RenderQuery.h"
@@ -21,11 +25,20 @@
 #include "Fury/SceneManager.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Shader.h"
+#include "Fury/Skeleton.h"
 #include "Fury/SphereBounds.h"
+#include "Fury/StreamBuffer.h"
 #include "Fury/Texture.h"
 
 namespace fury
 {
+	// shadow uniforms bound for every draw of a light, hashed once.
+	static const size_t SHADOW_BUFFER = std::hash<std::string>()("shadow_buffer");
+
+	static const size_t SHADOW_MATRIX = std::hash<std::string>()("shadow_matrix");
+
+	static const size_t SHADOW_FAR = std::hash<std::string>()("shadow_far");
+
 	PrelightPipeline::Ptr PrelightPipeline::Create(const std::string &name)
 	{
 		return std::make_shared<PrelightPipeline>(name);
@@ -36,6 +49,13 @@ namespace fury
 	{
 		m_TypeIndex = typeid(PrelightPipeline);
 		SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, true);
+		SetSwitch(PipelineSwitch::INSTANCING, true);
+		SetSwitch(PipelineSwitch::MESH_POOL, true);
+		SetSwitch(PipelineSwitch::MULTI_DRAW_INDIRECT, true);
+
+		m_InstanceStream = StreamBuffer::Create(name + "_Instances", GL_ARRAY_BUFFER, 256 * 1024);
+		m_IndirectStream = StreamBuffer::Create(name + "_Indirect", GL_DRAW_INDIRECT_BUFFER, 64 * 1024);
+		m_OcclusionCuller = OcclusionCuller::Create();
 	}
 
 	bool PrelightPipeline::Load(const void* wrapper, bool object)
@@ -85,10 +105,12 @@ namespace fury
 		// find visible nodes
 		RenderQuery::Ptr query = RenderQuery::Create();
 		sceneManager->GetRenderQuery(m_CurrentCamera->GetComponent<Camera>()->GetFrustum(), query);
-		query->Sort(m_CurrentCamera->GetWorldPosition());
+		query->ComputeDepths(m_CurrentCamera->GetWorldPosition());
 
 		// draw passes
 
+		std::vector<RenderItem> items;
+
 		Texture::Ptr finalBuffer = nullptr;
 		unsigned int passCount = m_SortedPasses.size();
 		for (unsigned int i = 0; i < passCount; i++)
@@ -105,19 +127,23 @@ namespace fury
 
 			// enable gamma correction on last pass
 			if (i == passCount - 1)
-				glEnable(GL_FRAMEBUFFER_SRGB);
+				GLState::Enable(GL_FRAMEBUFFER_SRGB);
 
 			if (drawMode == DrawMode::OPAQUE)
 			{
 				pass->Bind();
-				for (const auto &unit : query->opaqueUnits)
-					DrawUnit(pass, unit);
+				m_CurrentShader = nullptr;
+
+				SortUnits(pass, query->opaqueUnits, query->opaqueDepths, false, items);
+				DrawUnits(pass, query->opaqueUnits, items);
 			}
 			else if (drawMode == DrawMode::TRANSPARENT)
 			{
 				pass->Bind();
-				for (const auto &unit : query->transparentUnits)
-					DrawUnit(pass, unit);
+				m_CurrentShader = nullptr;
+
+				SortUnits(pass, query->transparentUnits, query->transparentDepths, true, items);
+				DrawUnits(pass, query->transparentUnits, items);
 			}
 			else if (drawMode == DrawMode::QUAD)
 			{
@@ -144,8 +170,24 @@ namespace fury
 
 			pass->UnBind();
 
+			// next frame culls against this depth.
+			if (drawMode == DrawMode::OPAQUE && IsSwitchOn(PipelineSwitch::OCCLUSION_CULLING) && OcclusionCuller::IsSupported())
+			{
+				for (unsigned int j = 0; j < pass->GetTextureCount(false); j++)
+				{
+					auto texture = pass->GetTextureAt(j, false);
+					auto format = texture->GetFormat();
+					if (format >= TextureFormat::DEPTH16 && format <= TextureFormat::DEPTH24_STENCIL8)
+					{
+						auto camera = m_CurrentCamera->GetComponent<Camera>();
+						m_OcclusionCuller->BuildPyramid(texture, camera->GetProjectionMatrix() * m_CurrentCamera->GetInvertWorldMatrix());
+						break;
+					}
+				}
+			}
+
 			if (i == passCount - 1)
-				glDisable(GL_FRAMEBUFFER_SRGB);
+				GLState::Disable(GL_FRAMEBUFFER_SRGB);
 
 			if (m_CurrentShader != nullptr)
 				m_CurrentShader->UnBind();
@@ -169,63 +211,358 @@ namespace fury
 		m_CurrentMesh = nullptr;
 	}
 
-	void PrelightPipeline::DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit)
+	Shader::Ptr PrelightPipeline::GetUnitShader(const std::shared_ptr<Pass> &pass, const RenderUnit &unit) const
 	{
-		auto node = unit.node;
-		auto mesh = unit.mesh;
-		auto material = unit.material;
-
-		auto shader = material->GetShaderForPass(pass->GetRenderIndex());
+		auto shader = unit.material->GetShaderForPass(pass->GetRenderIndex());
 
 		if (shader == nullptr)
-			shader = pass->GetShader(mesh->IsSkinnedMesh() ? ShaderType::SKINNED_MESH : ShaderType::STATIC_MESH,
-			material->GetTextureFlags());
+			shader = pass->GetShader(unit.mesh->IsSkinnedMesh() ? ShaderType::SKINNED_MESH : ShaderType::STATIC_MESH,
+			unit.material->GetTextureFlags());
 
-		if (shader == nullptr)
+		return shader;
+	}
+
+	void PrelightPipeline::SortUnits(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units,
+		const std::vector<uint16_t> &depths, bool transparent, std::vector<RenderItem> &items) const
+	{
+		unsigned int passIndex = pass->GetRenderIndex();
+
+		items.resize(units.size());
+		for (unsigned int i = 0; i < units.size(); i++)
 		{
-			FURYW << "Failed to draw " << node->GetName() << ", shader not found!";
-			return;
+			const auto &unit = units[i];
+
+			auto shader = GetUnitShader(pass, unit);
+			unsigned int shaderId = shader != nullptr ? shader->GetProgram() : 0;
+			unsigned int materialId = unit.material->GetID();
+			// pooled and packed meshes have no Positions buffer, so key by the mesh itself.
+			unsigned int meshId = unit.mesh->GetBufferId();
+			uint16_t depth = i < depths.size() ? depths[i] : 0;
+
+			items[i].key = transparent ? RenderQuery::GetTransparentKey(passIndex, shaderId, materialId, meshId, depth) :
+				RenderQuery::GetOpaqueKey(passIndex, shaderId, materialId, meshId, depth);
+			items[i].index = i;
+		}
+
+		RenderQuery::SortItems(items);
+	}
+
+	void PrelightPipeline::DrawUnits(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const std::vector<RenderItem> &items)
+	{
+		struct Run
+		{
+			size_t begin;
+
+			size_t end;
+
+			// instanced shader, nullptr if the run is drawn unit by unit.
+			Shader::Ptr shader;
+
+			size_t offset;
+
+			// drawn from MeshPool with indirect commands.
+			bool indirect;
+		};
+
+		// consecutive indirect runs sharing shader, material and MeshPool page, or a single other run.
+		struct Batch
+		{
+			size_t begin;
+
+			size_t end;
+
+			// first command in m_IndirectCommands.
+			size_t command;
+		};
+
+		bool instancing = IsSwitchOn(PipelineSwitch::INSTANCING);
+		bool indirect = IsSwitchOn({ PipelineSwitch::MULTI_DRAW_INDIRECT, PipelineSwitch::MESH_POOL }, false);
+		bool culling = indirect && IsSwitchOn(PipelineSwitch::OCCLUSION_CULLING) && OcclusionCuller::IsSupported();
+
+		// sorting put units sharing mesh, submesh and material next to each other.
+		std::vector<Run> runs;
+		m_InstanceData.clear();
+
+		for (size_t begin = 0; begin < items.size();)
+		{
+			const RenderUnit &unit = units[items[begin].index];
+
+			size_t end = begin + 1;
+			if ((instancing || indirect) && !unit.mesh->IsSkinnedMesh())
+			{
+				while (end < items.size())
+				{
+					const RenderUnit &other = units[items[end].index];
+					if (other.mesh != unit.mesh || other.subMesh != unit.subMesh || other.material != unit.material)
+						break;
+					end++;
+				}
+			}
+
+			Run run = { begin, end, nullptr, 0, indirect && UseMeshPool(unit.mesh) };
+			if ((instancing && end - begin >= MIN_INSTANCE_COUNT) || run.indirect)
+			{
+				auto shader = GetUnitShader(pass, unit);
+				if (shader != nullptr)
+					run.shader = shader->GetInstanced() ? shader : shader->GetInstancedShader();
+			}
+
+			// indirect draws read world matrices as instance attributes.
+			if (run.shader == nullptr)
+				run.indirect = false;
+
+			if (run.shader != nullptr)
+			{
+				run.offset = m_InstanceData.size() * sizeof(float);
+				for (size_t i = begin; i < end; i++)
+				{
+					const Matrix4 &matrix = units[items[i].index].node->GetWorldMatrix();
+					m_InstanceData.insert(m_InstanceData.end(), matrix.Raw, matrix.Raw + 16);
+				}
+			}
+
+			runs.push_back(run);
+			begin = end;
+		}
+
+		std::vector<Batch> batches;
+		m_IndirectCommands.clear();
+		m_CullCommands.clear();
+		m_CullBounds.clear();
+
+		for (size_t begin = 0; begin < runs.size();)
+		{
+			const Run &first = runs[begin];
+			const RenderUnit &unit = units[items[first.begin].index];
+
+			size_t end = begin + 1;
+			if (first.indirect)
+			{
+				while (end < runs.size() && runs[end].indirect && runs[end].shader == first.shader)
+				{
+					const RenderUnit &other = units[items[runs[end].begin].index];
+					if (other.material != unit.material || other.mesh->GetPoolPage() != unit.mesh->GetPoolPage())
+						break;
+					end++;
+				}
+			}
+
+			Batch batch = { begin, end, m_IndirectCommands.size() };
+			if (first.indirect)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const Run &run = runs[i];
+					const RenderUnit &runUnit = units[items[run.begin].index];
+					const auto &mesh = runUnit.mesh;
+
+					DrawElementsIndirectCommand command;
+					command.instanceCount = run.end - run.begin;
+					command.baseVertex = mesh->GetPoolBaseVertex();
+					command.baseInstance = (run.offset - first.offset) / (sizeof(float) * 16);
+
+					if (mesh->GetSubMeshCount() > 0)
+					{
+						auto subMesh = mesh->GetSubMeshAt(runUnit.subMesh);
+						command.count = subMesh->Indices.Data.size();
+						command.firstIndex = subMesh->GetPoolFirstIndex();
+					}
+					else
+					{
+						command.count = mesh->Indices.Data.size();
+						command.firstIndex = mesh->GetPoolFirstIndex();
+					}
+
+					m_IndirectCommands.push_back(command);
+
+					if (!culling)
+						continue;
+
+					unsigned int commandIndex = m_CullCommands.size();
+					unsigned int matrixIndex = run.offset / (sizeof(float) * 16);
+					command.baseInstance = matrixIndex;
+					m_CullCommands.push_back(command);
+
+					// index bits ride in w, the shader reads them back with floatBitsToUint.
+					for (size_t j = run.begin; j < run.end; j++, matrixIndex++)
+					{
+						BoxBounds aabb = units[items[j].index].node->GetWorldAABB();
+						Vector4 bmin = aabb.GetMin(), bmax = aabb.GetMax();
+						std::memcpy(&bmin.w, &commandIndex, sizeof(float));
+						std::memcpy(&bmax.w, &matrixIndex, sizeof(float));
+						m_CullBounds.insert(m_CullBounds.end(), { bmin.x, bmin.y, bmin.z, bmin.w, bmax.x, bmax.y, bmax.z, bmax.w });
+					}
+				}
+			}
+
+			batches.push_back(batch);
+			begin = end;
+		}
+
+		// one upload per pass, into this frame's region of the ring.
+		if (m_InstanceData.size() > 0)
+		{
+			size_t base = m_InstanceStream->Upload(&m_InstanceData[0], m_InstanceData.size() * sizeof(float), sizeof(float) * 16);
+			for (auto &run : runs)
+				run.offset += base;
+		}
+
+		// the cpu fallback reads m_IndirectCommands directly.
+		if (m_IndirectCommands.size() > 0 && glMultiDrawElementsIndirect != nullptr)
+		{
+			m_IndirectOffset = m_IndirectStream->Upload(&m_IndirectCommands[0],
+				m_IndirectCommands.size() * sizeof(DrawElementsIndirectCommand), sizeof(unsigned int));
+		}
+
+		// culled commands line up with m_IndirectCommands, so batches index both the same.
+		m_IndirectCulled = false;
+		if (culling && m_CullBounds.size() > 0)
+		{
+			auto camera = m_CurrentCamera->GetComponent<Camera>();
+			m_IndirectCulled = m_OcclusionCuller->Cull(camera->GetProjectionMatrix() * m_CurrentCamera->GetInvertWorldMatrix(),
+				m_InstanceData, m_CullBounds, m_CullCommands);
+
+			// culler used it's own program.
+			m_CurrentShader = nullptr;
+		}
+
+		for (const auto &batch : batches)
+		{
+			const Run &run = runs[batch.begin];
+			if (run.indirect)
+			{
+				DrawIndirect(pass, run.shader, units[items[run.begin].index], run.offset, batch.command, batch.end - batch.begin);
+			}
+			else if (run.shader != nullptr)
+			{
+				DrawInstances(pass, run.shader, units[items[run.begin].index], run.end - run.begin, run.offset);
+			}
+			else
+			{
+				for (size_t i = run.begin; i < run.end; i++)
+					DrawUnit(pass, units[items[i].index]);
+			}
 		}
+	}
+
+	void PrelightPipeline::BindUnit(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit)
+	{
+		auto mesh = unit.mesh;
+		auto material = unit.material;
 
 		bool materialChanged = material != m_CurrentMateral;
 		m_CurrentMateral = material;
 
-		bool meshChanged = mesh != m_CurrentMesh;
+		// a mesh leaves the pool while it's edited, and rejoins once it's own buffers are uploaded.
+		bool pooled = UseMeshPool(mesh);
+		bool meshChanged = mesh != m_CurrentMesh || pooled != m_CurrentMeshPooled;
 		m_CurrentMesh = mesh;
+		m_CurrentMeshPooled = pooled;
 
-		bool shaderChanged = materialChanged || shader != m_CurrentShader;
+		bool shaderChanged = shader != m_CurrentShader;
 		m_CurrentShader = shader;
 
 		if (shaderChanged)
 		{
 			materialChanged = meshChanged = true;
 
+			RenderUtil::Instance()->IncreaseShaderChangeCount();
+
 			shader->Bind();
 			shader->BindCamera(m_CurrentCamera);
 
 			for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 			{
 				auto ptr = pass->GetTextureAt(i, true);
-				shader->BindTexture(ptr->GetName(), ptr);
+				shader->BindTexture(ptr->GetHashCode(), ptr);
 			}
+
+			shader->SaveTextureUnit();
 		}
 
 		if (materialChanged)
+		{
+			// materials under the same shader reuse the units after the pass textures.
+			shader->RestoreTextureUnit();
 			shader->BindMaterial(material);
-
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, node->GetWorldMatrix());
+			RenderUtil::Instance()->IncreaseMaterialChangeCount();
+		}
 
 		if (meshChanged)
-			shader->BindMesh(mesh);
+		{
+			if (pooled)
+				shader->BindPooledMesh(mesh);
+			else
+				shader->BindMesh(mesh);
+
+			RenderUtil::Instance()->IncreaseMeshChangeCount();
+		}
+	}
+
+	bool PrelightPipeline::UseMeshPool(const std::shared_ptr<Mesh> &mesh)
+	{
+		if (!IsSwitchOn(PipelineSwitch::MESH_POOL) || !MeshPool::HasInstance())
+			return false;
+
+		// edited meshes draw from their own buffers, which uploads the changes, and are pooled again once clean.
+		if (mesh->GetDirty() || mesh->HasDirtyRanges())
+		{
+			MeshPool::Instance()->Remove(mesh.get());
+			return false;
+		}
+
+		return MeshPool::Instance()->Add(mesh);
+	}
+
+	void PrelightPipeline::DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit)
+	{
+		auto node = unit.node;
+		auto mesh = unit.mesh;
+
+		auto shader = GetUnitShader(pass, unit);
+
+		if (shader == nullptr)
+		{
+			FURYW << "Failed to draw " << node->GetName() << ", shader not found!";
+			return;
+		}
+
+		BindUnit(pass, shader, unit);
+
+		shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, node->GetWorldMatrix());
+
+		// nodes sharing a skinned mesh keep BindUnit from rebinding it, so the palette goes every draw.
+		if (mesh->IsSkinnedMesh())
+		{
+			if (auto skeleton = node->GetComponent<Skeleton>())
+				shader->BindSkeleton(skeleton);
+		}
+
+		bool pooled = m_CurrentMeshPooled;
 
 		if (mesh->GetSubMeshCount() > 0)
 		{
 			auto subMesh = mesh->GetSubMeshAt(unit.subMesh);
-			shader->BindSubMesh(mesh, unit.subMesh);
-			glDrawElements(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			if (pooled)
+			{
+				glDrawElementsBaseVertex(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT,
+					(const void*)(subMesh->GetPoolFirstIndex() * sizeof(unsigned int)), mesh->GetPoolBaseVertex());
+			}
+			else
+			{
+				shader->BindSubMesh(mesh, unit.subMesh);
+				glDrawElements(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			}
 
 			RenderUtil::Instance()->IncreaseTriangleCount(subMesh->Indices.Data.size());
 		}
+		else if (pooled)
+		{
+			glDrawElementsBaseVertex(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT,
+				(const void*)(mesh->GetPoolFirstIndex() * sizeof(unsigned int)), mesh->GetPoolBaseVertex());
+
+			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size());
+		}
 		else
 		{
 			glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
@@ -244,6 +581,108 @@ namespace fury
 		RenderUtil::Instance()->IncreaseDrawCall();
 	}
 
+	void PrelightPipeline::DrawInstances(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit,
+		unsigned int count, size_t offset)
+	{
+		auto mesh = unit.mesh;
+
+		BindUnit(pass, shader, unit);
+
+		shader->BindInstances(m_InstanceStream->GetID(), offset);
+
+		bool pooled = m_CurrentMeshPooled;
+
+		if (mesh->GetSubMeshCount() > 0)
+		{
+			auto subMesh = mesh->GetSubMeshAt(unit.subMesh);
+			if (pooled)
+			{
+				glDrawElementsInstancedBaseVertex(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT,
+					(const void*)(subMesh->GetPoolFirstIndex() * sizeof(unsigned int)), count, mesh->GetPoolBaseVertex());
+			}
+			else
+			{
+				shader->BindSubMesh(mesh, unit.subMesh);
+				glDrawElementsInstanced(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0, count);
+			}
+
+			RenderUtil::Instance()->IncreaseTriangleCount(subMesh->Indices.Data.size() * count);
+		}
+		else if (pooled)
+		{
+			glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT,
+				(const void*)(mesh->GetPoolFirstIndex() * sizeof(unsigned int)), count, mesh->GetPoolBaseVertex());
+
+			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size() * count);
+		}
+		else
+		{
+			glDrawElementsInstanced(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0, count);
+
+			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size() * count);
+		}
+
+		shader->UnBindInstances();
+
+		RenderUtil::Instance()->IncreaseMeshCount(count);
+		RenderUtil::Instance()->IncreaseDrawCall();
+		RenderUtil::Instance()->IncreaseInstancedDrawCall();
+	}
+
+	void PrelightPipeline::DrawIndirect(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit,
+		size_t offset, size_t command, unsigned int commandCount)
+	{
+		BindUnit(pass, shader, unit);
+
+		if (m_IndirectCulled)
+		{
+			// culled commands have absolute base instances into the culled matrices.
+			shader->BindInstances(m_OcclusionCuller->GetInstanceBuffer(), 0);
+
+			size_t indirect = m_OcclusionCuller->GetCommandOffset() + command * sizeof(DrawElementsIndirectCommand);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_OcclusionCuller->GetCommandBuffer());
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)indirect, commandCount, 0);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+			RenderUtil::Instance()->IncreaseDrawCall();
+		}
+		else if (glMultiDrawElementsIndirect != nullptr)
+		{
+			shader->BindInstances(m_InstanceStream->GetID(), offset);
+
+			size_t indirect = m_IndirectOffset + command * sizeof(DrawElementsIndirectCommand);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectStream->GetID());
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)indirect, commandCount, 0);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+			RenderUtil::Instance()->IncreaseDrawCall();
+		}
+		else
+		{
+			// same commands one by one, base instance becomes an attribute offset.
+			for (size_t i = command; i < command + commandCount; i++)
+			{
+				const auto &cmd = m_IndirectCommands[i];
+				shader->BindInstances(m_InstanceStream->GetID(), offset + cmd.baseInstance * sizeof(float) * 16);
+				glDrawElementsInstancedBaseVertex(GL_TRIANGLES, cmd.count, GL_UNSIGNED_INT,
+					(const void*)(cmd.firstIndex * sizeof(unsigned int)), cmd.instanceCount, cmd.baseVertex);
+
+				RenderUtil::Instance()->IncreaseDrawCall();
+			}
+		}
+
+		shader->UnBindInstances();
+
+		for (size_t i = command; i < command + commandCount; i++)
+		{
+			const auto &cmd = m_IndirectCommands[i];
+			RenderUtil::Instance()->IncreaseTriangleCount(cmd.count * cmd.instanceCount);
+			RenderUtil::Instance()->IncreaseMeshCount(cmd.instanceCount);
+		}
+
+		RenderUtil::Instance()->IncreaseInstancedDrawCall();
+	}
+
 	void PrelightPipeline::DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
 	{
 		auto light = node->GetComponent<Light>();
@@ -276,13 +715,13 @@ namespace fury
 			float camNear = (camPtr->GetFrustum().GetCurrentCorners()[0] - camPos).Length();
 			if (SphereBounds(node->GetWorldPosition(), light->GetRadius() + camNear).IsInsideFast(camPos))
 			{
-				glDisable(GL_DEPTH_TEST);
-				glCullFace(GL_FRONT);
+				GLState::Disable(GL_DEPTH_TEST);
+				GLState::CullFace(GL_FRONT);
 			}
 			else
 			{
-				glEnable(GL_DEPTH_TEST);
-				glCullFace(GL_BACK);
+				GLState::Enable(GL_DEPTH_TEST);
+				GLState::CullFace(GL_BACK);
 			}
 
 			worldMatrix.AppendScale(Vector4(light->GetRadius(), 0.0f));
@@ -291,12 +730,12 @@ namespace fury
 		shader->Bind();
 
 		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, worldMatrix);
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			shader->BindTexture(SHADOW_BUFFER, shadowData.first);
+			shader->BindMatrix(SHADOW_MATRIX, &shadowData.second.Raw[0]);
 		}
 
 		shader->BindLight(node);
@@ -305,7 +744,7 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(ptr->GetHashCode(), ptr);
 		}
 
 		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
@@ -358,29 +797,29 @@ namespace fury
 		pass->Bind(false);
 
 		// change depthTest && face culling state.
-		glEnable(GL_DEPTH_TEST);
-		glCullFace(GL_BACK);
+		GLState::Enable(GL_DEPTH_TEST);
+		GLState::CullFace(GL_BACK);
 
 		shader->Bind();
 
 		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, worldMatrix);
 
 		if (castShadows)
 		{
 			if (useCascaded && cascadedShadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", cascadedShadowData.first);
+				shader->BindTexture(SHADOW_BUFFER, cascadedShadowData.first);
 				// for cacasded shadow maps
 				shader->BindMatrices("shadow_matrix", cascadedShadowData.second.size(), &cascadedShadowData.second[0]);
 				float base = camPtr->GetFar() - camPtr->GetNear();
 				float average = base / 4.0f;
-				shader->BindFloat("shadow_far", average, average * 2, average * 3, average * 4);
+				shader->BindFloat(SHADOW_FAR, average, average * 2, average * 3, average * 4);
 			}
 			else if (shadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", shadowData.first);
-				shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+				shader->BindTexture(SHADOW_BUFFER, shadowData.first);
+				shader->BindMatrix(SHADOW_MATRIX, &shadowData.second.Raw[0]);
 			}
 		}
 
@@ -390,7 +829,7 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(ptr->GetHashCode(), ptr);
 		}
 
 		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
@@ -454,25 +893,25 @@ namespace fury
 
 			if (MathUtil::PointInCone(coneCenter, coneDir, height, theta, camPos))
 			{
-				glDisable(GL_DEPTH_TEST);
-				glCullFace(GL_FRONT);
+				GLState::Disable(GL_DEPTH_TEST);
+				GLState::CullFace(GL_FRONT);
 			}
 			else
 			{
-				glEnable(GL_DEPTH_TEST);
-				glCullFace(GL_BACK);
+				GLState::Enable(GL_DEPTH_TEST);
+				GLState::CullFace(GL_BACK);
 			}
 		}
 
 		shader->Bind();
 
 		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		shader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, worldMatrix);
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			shader->BindTexture(SHADOW_BUFFER, shadowData.first);
+			shader->BindMatrix(SHADOW_MATRIX, &shadowData.second.Raw[0]);
 		}
 
 		shader->BindLight(node);
@@ -481,7 +920,7 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(ptr->GetHashCode(), ptr);
 		}
 
 		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
@@ -517,7 +956,7 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(ptr->GetHashCode(), ptr);
 		}
 
 		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
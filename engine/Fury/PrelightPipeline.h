@@ -1,6 +1,7 @@
 #ifndef _FURY_PRELIGHT_PIPELINE_H_
 #define _FURY_PRELIGHT_PIPELINE_H_
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -9,6 +10,7 @@
 
 #include "Fury/Pipeline.h"
 #include "Fury/Matrix4.h"
+#include "Fury/RenderQuery.h"
 
 namespace fury
 {
@@ -18,7 +20,9 @@ namespace fury
 
 	class Pass;
 
-	struct RenderUnit;
+	class StreamBuffer;
+
+	class OcclusionCuller;
 
 	class FURY_API PrelightPipeline : public Pipeline
 	{
@@ -28,6 +32,41 @@ namespace fury
 
 		static Ptr Create(const std::string &name);
 
+		// runs of units sharing mesh, submesh and material are drawn instanced from this many units.
+		static const unsigned int MIN_INSTANCE_COUNT = 2;
+
+	protected:
+
+		// world matrices of instanced draws, refilled for each pass.
+		std::shared_ptr<StreamBuffer> m_InstanceStream;
+
+		std::vector<float> m_InstanceData;
+
+		// commands of pooled draws, refilled for each pass.
+		std::shared_ptr<StreamBuffer> m_IndirectStream;
+
+		std::vector<DrawElementsIndirectCommand> m_IndirectCommands;
+
+		// byte offset of m_IndirectCommands in m_IndirectStream.
+		size_t m_IndirectOffset = 0;
+
+		// culls pooled draws on gpu when PipelineSwitch::OCCLUSION_CULLING is on, against last frame's opaque depth.
+		std::shared_ptr<OcclusionCuller> m_OcclusionCuller;
+
+		// world aabb of each indirect instance, with it's command and matrix index.
+		std::vector<float> m_CullBounds;
+
+		// m_IndirectCommands with absolute base instances.
+		std::vector<DrawElementsIndirectCommand> m_CullCommands;
+
+		// true if indirect draws of this pass read m_OcclusionCuller's buffers.
+		bool m_IndirectCulled = false;
+
+		// true if m_CurrentMesh is bound from it's MeshPool page.
+		bool m_CurrentMeshPooled = false;
+
+	public:
+
 		PrelightPipeline(const std::string &name);
 
 		virtual bool Load(const void* wrapper, bool object = true) override;
@@ -38,8 +77,35 @@ namespace fury
 
 	protected:
 
+		// shader the unit is drawn with in pass, nullptr if there's none.
+		std::shared_ptr<Shader> GetUnitShader(const std::shared_ptr<Pass> &pass, const RenderUnit &unit) const;
+
+		// orders units by sort key, so draws sharing shader, material and mesh are next to each other.
+		void SortUnits(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units,
+			const std::vector<uint16_t> &depths, bool transparent, std::vector<RenderItem> &items) const;
+
+		// draws units in items order, with instancing when PipelineSwitch::INSTANCING is on,
+		// and pooled meshes with indirect commands when PipelineSwitch::MULTI_DRAW_INDIRECT is on.
+		void DrawUnits(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const std::vector<RenderItem> &items);
+
+		// binds shader, material and mesh if they changed since last draw.
+		void BindUnit(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit);
+
 		void DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit);
 
+		// true if mesh draws from it's MeshPool page, pools the mesh on first use when PipelineSwitch::MESH_POOL is on.
+		bool UseMeshPool(const std::shared_ptr<Mesh> &mesh);
+
+		// draws count instances of unit, with world matrices from m_InstanceStream at offset bytes.
+		void DrawInstances(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit,
+			unsigned int count, size_t offset);
+
+		// draws commandCount commands from m_IndirectCommands starting at command, all sharing unit's shader,
+		// material and MeshPool page. one glMultiDrawElementsIndirect when available, one draw per command otherwise.
+		// culled commands and matrices come from m_OcclusionCuller when m_IndirectCulled.
+		void DrawIndirect(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit,
+			size_t offset, size_t command, unsigned int commandCount);
+
 		void DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
 
 		void DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
 
 #include "Fury/RenderQuery.h"
@@ -12,6 +14,13 @@
 
 namespace fury
 {
+	static void ComputeUnitDepths(const std::vector<RenderUnit> &units, std::vector<uint16_t> &depths, Vector4 camPos)
+	{
+		depths.resize(units.size());
+		for (unsigned int i = 0; i < units.size(); i++)
+			depths[i] = RenderQuery::QuantizeDepth((units[i].node->GetWorldPosition() - camPos).SquareLength());
+	}
+
 	RenderQuery::Ptr RenderQuery::Create()
 	{
 		return std::make_shared<RenderQuery>();
@@ -51,17 +60,20 @@ namespace fury
 		lightNodes.push_back(node);
 	}
 
-	void RenderQuery::Sort(Vector4 camPos)
+	void RenderQuery::Append(const RenderQuery &other)
 	{
-		std::sort(opaqueUnits.begin(), opaqueUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
-		{
-			return a.node->GetWorldPosition().Distance(camPos) < b.node->GetWorldPosition().Distance(camPos);
-		});
+		opaqueUnits.insert(opaqueUnits.end(), other.opaqueUnits.begin(), other.opaqueUnits.end());
+		transparentUnits.insert(transparentUnits.end(), other.transparentUnits.begin(), other.transparentUnits.end());
+		renderableNodes.insert(renderableNodes.end(), other.renderableNodes.begin(), other.renderableNodes.end());
+		lightNodes.insert(lightNodes.end(), other.lightNodes.begin(), other.lightNodes.end());
+		opaqueDepths.insert(opaqueDepths.end(), other.opaqueDepths.begin(), other.opaqueDepths.end());
+		transparentDepths.insert(transparentDepths.end(), other.transparentDepths.begin(), other.transparentDepths.end());
+	}
 
-		std::sort(transparentUnits.begin(), transparentUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
-		{
-			return a.node->GetWorldPosition().Distance(camPos) > b.node->GetWorldPosition().Distance(camPos);
-		});
+	void RenderQuery::ComputeDepths(Vector4 camPos)
+	{
+		ComputeUnitDepths(opaqueUnits, opaqueDepths, camPos);
+		ComputeUnitDepths(transparentUnits, transparentDepths, camPos);
 
 		/*std::sort(lightNodes.begin(), lightNodes.end(), [](const SceneNode::Ptr &a, const SceneNode::Ptr &b) -> bool
 		{
@@ -75,5 +87,62 @@ namespace fury
 		transparentUnits.clear();
 		renderableNodes.clear();
 		lightNodes.clear();
+		opaqueDepths.clear();
+		transparentDepths.clear();
+	}
+
+	uint64_t RenderQuery::GetOpaqueKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, uint16_t depth)
+	{
+		return ((uint64_t)(pass & 0xff) << 56) | ((uint64_t)(shader & 0xfff) << 44) |
+			((uint64_t)(material & 0x3fff) << 30) | ((uint64_t)(mesh & 0x3fff) << 16) | depth;
+	}
+
+	uint64_t RenderQuery::GetTransparentKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, uint16_t depth)
+	{
+		return ((uint64_t)(pass & 0xff) << 56) | ((uint64_t)(0xffff - depth) << 40) |
+			((uint64_t)(shader & 0xfff) << 28) | ((uint64_t)(material & 0x3fff) << 14) | (mesh & 0x3fff);
+	}
+
+	uint16_t RenderQuery::QuantizeDepth(float sqrDistance)
+	{
+		// bits of positive floats sort like the floats, top 16 bits keep the exponent and 7 bits of mantissa.
+		uint32_t bits;
+		std::memcpy(&bits, &sqrDistance, sizeof(bits));
+		return (bits & 0x80000000u) != 0 ? 0 : (uint16_t)(bits >> 16);
+	}
+
+	void RenderQuery::SortItems(std::vector<RenderItem> &items)
+	{
+		if (items.size() < 2)
+			return;
+
+		// all histograms in one read.
+		std::array<std::array<unsigned int, 256>, 8> counts = {};
+		for (const auto &item : items)
+		{
+			for (unsigned int digit = 0; digit < 8; digit++)
+				counts[digit][(item.key >> (digit * 8)) & 0xff]++;
+		}
+
+		std::vector<RenderItem> buffer(items.size());
+		for (unsigned int digit = 0; digit < 8; digit++)
+		{
+			auto &count = counts[digit];
+			if (count[(items[0].key >> (digit * 8)) & 0xff] == items.size())
+				continue;
+
+			unsigned int offset = 0;
+			for (auto &value : count)
+			{
+				unsigned int next = offset + value;
+				value = offset;
+				offset = next;
+			}
+
+			for (const auto &item : items)
+				buffer[count[(item.key >> (digit * 8)) & 0xff]++] = item;
+
+			items.swap(buffer);
+		}
 	}
 }
@@ -1,6 +1,7 @@
 #ifndef _FURY_RENDERQUERY_H_
 #define _FURY_RENDERQUERY_H_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -34,6 +35,29 @@ namespace fury
 		}
 	};
 
+	// layout glMultiDrawElementsIndirect reads.
+	struct FURY_API DrawElementsIndirectCommand
+	{
+		unsigned int count;
+
+		unsigned int instanceCount;
+
+		unsigned int firstIndex;
+
+		int baseVertex;
+
+		// first world matrix of the command, relative to the instance attributes' offset.
+		unsigned int baseInstance;
+	};
+
+	// a draw and it's sort key, index points into RenderQuery's opaqueUnits or transparentUnits.
+	struct FURY_API RenderItem
+	{
+		uint64_t key = 0;
+
+		unsigned int index = 0;
+	};
+
 	class FURY_API RenderQuery
 	{
 	public:
@@ -50,13 +74,36 @@ namespace fury
 
 		std::vector<std::shared_ptr<SceneNode>> lightNodes;
 
+		// quantized camera distance of each unit, filled by ComputeDepths.
+		std::vector<uint16_t> opaqueDepths;
+
+		std::vector<uint16_t> transparentDepths;
+
 		void AddRenderable(const std::shared_ptr<SceneNode> &node);
 
 		void AddLight(const std::shared_ptr<SceneNode> &node);
 
-		void Sort(Vector4 camPos);
+		void Append(const RenderQuery &other);
+
+		// fills opaqueDepths and transparentDepths, units keep their order.
+		// the pipeline sorts them once per pass, by state keys that end or start with these depths.
+		void ComputeDepths(Vector4 camPos);
 
 		void Clear();
+
+		// pass (8 bits) | shader (12) | material (14) | mesh buffer (14) | depth (16), from high to low bits.
+		// ids wider than their field wrap around, that only costs some extra state changes.
+		static uint64_t GetOpaqueKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, uint16_t depth);
+
+		// pass (8 bits) | inverted depth (16) | shader (12) | material (14) | mesh buffer (14),
+		// depth comes first so blending order is kept.
+		static uint64_t GetTransparentKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, uint16_t depth);
+
+		// monotonic 16 bit depth from squared distance, so no sqrt is needed.
+		static uint16_t QuantizeDepth(float sqrDistance);
+
+		// stable lsd radix sort by key, 8 bits per pass, passes where all items share a digit are skipped.
+		static void SortItems(std::vector<RenderItem> &items);
 	};
 }
 
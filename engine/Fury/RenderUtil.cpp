@@ -1,11 +1,16 @@
 #include <SFML/System/Time.hpp>
 
+#include <cstring>
+
+#include "Fury/Camera.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
 #include "Fury/Log.h"
 #include "Fury/Vector4.h"
 #include "Fury/Shader.h"
 #include "Fury/SceneNode.h"
+#include "Fury/StreamBuffer.h"
 #include "Fury/Frustum.h"
 #include "Fury/Mesh.h"
 #include "Fury/MeshUtil.h"
@@ -13,6 +18,22 @@
 
 namespace fury
 {
+	// std140 layout of Shader::CAMERA_BLOCK.
+	struct CameraBlockData
+	{
+		float projection_matrix[16];
+
+		float invert_view_matrix[16];
+
+		float camera_pos[3];
+
+		float camera_near;
+
+		float camera_far;
+
+		float padding[3];
+	};
+
 	RenderUtil::RenderUtil()
 	{
 		// blit shader
@@ -69,16 +90,13 @@ namespace fury
 		glBindAttribLocation(shaderId, 0, "vertex_position");
 
 		glGenVertexArrays(1, &m_LineVAO);
-		glGenBuffers(1, &m_LineVBO);
+		m_LineStream = StreamBuffer::Create("LineStream", GL_ARRAY_BUFFER, 64 * 1024);
+		m_PaletteStream = StreamBuffer::Create("PaletteStream", GL_UNIFORM_BUFFER, 64 * 1024);
 
-		glBindVertexArray(m_LineVAO);
-
-		glBindBuffer(GL_ARRAY_BUFFER, m_LineVBO);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+		// attribute pointer is set per DrawLines, since offset in m_LineStream changes.
+		GLState::BindVertexArray(m_LineVAO);
 		glEnableVertexAttribArray(0);
-
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
+		GLState::BindVertexArray(0);
 
 		m_DebugShader->UnBind();
 		}
@@ -93,10 +111,13 @@ namespace fury
 	RenderUtil::~RenderUtil()
 	{
 		if (m_LineVAO != 0)
+		{
+			GLState::OnDeleteVertexArray(m_LineVAO);
 			glDeleteVertexArrays(1, &m_LineVAO);
+		}
 
-		if (m_LineVBO != 0)
-			glDeleteBuffers(1, &m_LineVBO);
+		if (m_CameraBlock != 0)
+			glDeleteBuffers(1, &m_CameraBlock);
 	}
 
 	void RenderUtil::Blit(const std::shared_ptr<Texture> &src, const std::shared_ptr<Texture> &dest, 
@@ -135,17 +156,16 @@ namespace fury
 
 	void RenderUtil::BeginDrawLines(const std::shared_ptr<SceneNode> &camera)
 	{
-		if (m_DrawingLine || m_LineVAO == 0 || m_LineVBO == 0 || m_DebugShader->GetDirty())
+		if (m_DrawingLine || m_LineVAO == 0 || m_DebugShader->GetDirty())
 			return;
 
 		m_DrawingLine = true;
 
 		m_DebugShader->Bind();
 		m_DebugShader->BindCamera(camera);
-		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX, Matrix4());
+		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, Matrix4());
 
-		glBindVertexArray(m_LineVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_LineVBO);
+		GLState::BindVertexArray(m_LineVAO);
 	}
 
 	void RenderUtil::DrawLines(const float* positions, unsigned int size, Color color, LineMode lineMode)
@@ -157,8 +177,11 @@ namespace fury
 		}
 
 		auto dataSize = sizeof(float) * size;
-		glBufferData(GL_ARRAY_BUFFER, dataSize, 0, GL_STREAM_DRAW);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, positions);
+		size_t offset = m_LineStream->Upload(positions, dataSize);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_LineStream->GetID());
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (const void*)offset);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 		m_DebugShader->BindFloat("color", color.r, color.g, color.b);
 		
@@ -219,8 +242,7 @@ namespace fury
 	{
 		m_DrawingLine = false;
 
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::BindVertexArray(0);
 
 		m_DebugShader->UnBind();
 	}
@@ -244,7 +266,7 @@ namespace fury
 			return;
 
 		m_DebugShader->BindFloat("color", color.r, color.g, color.b);
-		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX_HASH, worldMatrix);
 		m_DebugShader->BindMesh(mesh);
 
 		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
@@ -260,13 +282,83 @@ namespace fury
 		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 	}
 
+	void RenderUtil::UpdateCameraBlock(const std::shared_ptr<SceneNode> &camNode)
+	{
+		auto camera = camNode->GetComponent<Camera>();
+		if (camera == nullptr)
+			return;
+
+		CameraBlockData data = {};
+		Vector4 camPos = camNode->GetWorldPosition();
+
+		std::memcpy(data.projection_matrix, camera->GetProjectionMatrix().Raw, sizeof(data.projection_matrix));
+		std::memcpy(data.invert_view_matrix, camNode->GetInvertWorldMatrix().Raw, sizeof(data.invert_view_matrix));
+		data.camera_pos[0] = camPos.x;
+		data.camera_pos[1] = camPos.y;
+		data.camera_pos[2] = camPos.z;
+		data.camera_near = camera->GetNear();
+		data.camera_far = camera->GetFar();
+
+		UpdateBlock(m_CameraBlock, m_CameraBlockData, Shader::CAMERA_BLOCK_BINDING, &data, sizeof(data));
+	}
+
+	void RenderUtil::UpdateBoneBlock(const float *matrices, unsigned int count)
+	{
+		size_t size = sizeof(float) * 16 * count;
+		size_t offset = m_PaletteStream->Upload(matrices, size);
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, Shader::BONE_BLOCK_BINDING, m_PaletteStream->GetID(), offset, size);
+		m_BlockUploadCount++;
+	}
+
+	unsigned int RenderUtil::GetBlockUploadCount()
+	{
+		return m_BlockUploadCount;
+	}
+
+	void RenderUtil::UpdateBlock(unsigned int &buffer, std::vector<char> &cache, unsigned int binding, const void *data, size_t size)
+	{
+		if (buffer == 0)
+		{
+			glGenBuffers(1, &buffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+			glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+			// binding points are shared by all programs, so the buffer stays bound.
+			glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+		}
+		else if (cache.size() == size && std::memcmp(cache.data(), data, size) == 0)
+		{
+			return;
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		cache.assign((const char*)data, (const char*)data + size);
+		m_BlockUploadCount++;
+	}
+
 	void RenderUtil::BeginFrame()
 	{
 		m_DrawCall = 0;
+		m_InstancedDrawCall = 0;
 		m_MeshCount = 0;
 		m_TriangleCount = 0;
 		m_SkinnedMeshCount = 0;
 		m_LightCount = 0;
+		m_ShaderChangeCount = 0;
+		m_MaterialChangeCount = 0;
+		m_MeshChangeCount = 0;
+		m_BlockUploadCount = 0;
+
+		// states may be changed outside engine between frames.
+		GLState::Invalidate();
+		GLState::ResetCounters();
+
+		StreamBuffer::BeginFrame();
 
 		m_FrameClock.restart();
 
@@ -275,6 +367,8 @@ namespace fury
 
 	void RenderUtil::EndFrame()
 	{
+		StreamBuffer::EndFrame();
+
 		auto frameTime = m_FrameClock.restart().asMilliseconds();
 		OnEndFrame->Emit(std::move(frameTime));
 	}
@@ -289,6 +383,16 @@ namespace fury
 		return m_DrawCall;
 	}
 
+	void RenderUtil::IncreaseInstancedDrawCall(unsigned int count)
+	{
+		m_InstancedDrawCall += count;
+	}
+
+	unsigned int RenderUtil::GetInstancedDrawCall()
+	{
+		return m_InstancedDrawCall;
+	}
+
 	void RenderUtil::IncreaseMeshCount(unsigned int count)
 	{
 		m_MeshCount += count;
@@ -328,4 +432,44 @@ namespace fury
 	{
 		return m_LightCount;
 	}
+
+	void RenderUtil::IncreaseShaderChangeCount(unsigned int count)
+	{
+		m_ShaderChangeCount += count;
+	}
+
+	unsigned int RenderUtil::GetShaderChangeCount()
+	{
+		return m_ShaderChangeCount;
+	}
+
+	void RenderUtil::IncreaseMaterialChangeCount(unsigned int count)
+	{
+		m_MaterialChangeCount += count;
+	}
+
+	unsigned int RenderUtil::GetMaterialChangeCount()
+	{
+		return m_MaterialChangeCount;
+	}
+
+	void RenderUtil::IncreaseMeshChangeCount(unsigned int count)
+	{
+		m_MeshChangeCount += count;
+	}
+
+	unsigned int RenderUtil::GetMeshChangeCount()
+	{
+		return m_MeshChangeCount;
+	}
+
+	unsigned int RenderUtil::GetIssuedStateCount()
+	{
+		return GLState::GetIssuedCount();
+	}
+
+	unsigned int RenderUtil::GetSkippedStateCount()
+	{
+		return GLState::GetSkippedCount();
+	}
 }
\ No newline at end of file
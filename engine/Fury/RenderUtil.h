@@ -27,6 +27,8 @@ namespace fury
 
 	class Shader;
 
+	class StreamBuffer;
+
 	class Texture;
 
 	class FURY_API RenderUtil final : public Singleton <RenderUtil>
@@ -45,10 +47,23 @@ namespace fury
 
 		unsigned int m_LineVAO = 0;
 
-		unsigned int m_LineVBO = 0;
+		std::shared_ptr<StreamBuffer> m_LineStream;
+
+		// skinning palettes, see Shader::BONE_BLOCK.
+		std::shared_ptr<StreamBuffer> m_PaletteStream;
+
+		// shared std140 uniform block, see Shader::CAMERA_BLOCK.
+		unsigned int m_CameraBlock = 0;
+
+		// last uploaded block data, uploads of the same data are skipped.
+		std::vector<char> m_CameraBlockData;
+
+		unsigned int m_BlockUploadCount = 0;
 
 		unsigned int m_DrawCall = 0;
 
+		unsigned int m_InstancedDrawCall = 0;
+
 		unsigned int m_MeshCount = 0;
 
 		unsigned int m_TriangleCount = 0;
@@ -57,6 +72,12 @@ namespace fury
 
 		unsigned int m_LightCount = 0;
 
+		unsigned int m_ShaderChangeCount = 0;
+
+		unsigned int m_MaterialChangeCount = 0;
+
+		unsigned int m_MeshChangeCount = 0;
+
 		sf::Clock m_FrameClock;
 
 		bool m_DrawingLine = false;
@@ -98,6 +119,14 @@ namespace fury
 
 		void EndDrawMeshes();
 
+		// uploads camera data to the shared camera block, if it changed.
+		void UpdateCameraBlock(const std::shared_ptr<SceneNode> &camNode);
+
+		// streams count matrices to the palette ring and binds them to Shader::BONE_BLOCK_BINDING.
+		void UpdateBoneBlock(const float *matrices, unsigned int count);
+
+		unsigned int GetBlockUploadCount();
+
 		void BeginFrame();
 
 		void EndFrame();
@@ -106,6 +135,11 @@ namespace fury
 
 		unsigned int GetDrawCall();
 
+		// instanced draws are counted in draw calls too.
+		void IncreaseInstancedDrawCall(unsigned int count = 1);
+
+		unsigned int GetInstancedDrawCall();
+
 		void IncreaseMeshCount(unsigned int count = 1);
 
 		unsigned int GetMeshCount();
@@ -121,6 +155,28 @@ namespace fury
 		void IncreaseLightCount(unsigned int count = 1);
 
 		unsigned int GetLightCount();
+
+		void IncreaseShaderChangeCount(unsigned int count = 1);
+
+		unsigned int GetShaderChangeCount();
+
+		void IncreaseMaterialChangeCount(unsigned int count = 1);
+
+		unsigned int GetMaterialChangeCount();
+
+		void IncreaseMeshChangeCount(unsigned int count = 1);
+
+		unsigned int GetMeshChangeCount();
+
+		// gl state calls sent this frame, see GLState.
+		unsigned int GetIssuedStateCount();
+
+		// redundant gl state calls dropped this frame.
+		unsigned int GetSkippedStateCount();
+
+	private:
+
+		void UpdateBlock(unsigned int &buffer, std::vector<char> &cache, unsigned int binding, const void *data, size_t size);
 	};
 }
 
@@ -1,3 +1,4 @@
+#include "Fury/AnimationClip.h"
 #include "Fury/Scene.h"
 #include "Fury/OcTree.h"
 #include "Fury/EntityManager.h"
@@ -99,6 +100,21 @@ namespace fury
 			return false;
 		}
 
+		// load clips, older scenes have none
+		if (IsArray(wrapper, "clips") && !LoadArray(wrapper, "clips", [&](const void* node) -> bool
+		{
+			auto clip = AnimationClip::Create("temp");
+			if (!clip->Load(node))
+				return false;
+
+			m_EntityManager->Add(clip);
+			return true;
+		}))
+		{
+			FURYE << "Error serializing clips!";
+			return false;
+		}
+
 		// load nodes
 		if (auto rootNodeWrapper = FindMember(wrapper, "nodes"))
 		{
@@ -144,6 +160,16 @@ namespace fury
 		});
 		EndArray(wrapper);
 
+		// save clips
+		SaveKey(wrapper, "clips");
+		StartArray(wrapper);
+		m_EntityManager->ForEach<AnimationClip>([&](const AnimationClip::Ptr &ptr) -> bool
+		{
+			ptr->Save(wrapper);
+			return true;
+		});
+		EndArray(wrapper);
+
 		// save nodes
 		SaveKey(wrapper, "nodes");
 		m_RootNode->Save(wrapper);
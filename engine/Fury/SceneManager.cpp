@@ -0,0 +1,116 @@
+#include "Fury/Frustum.h"
+#include "Fury/Light.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+#include "Fury/TransformStore.h"
+
+namespace fury
+{
+	void SceneManager::GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear) const
+	{
+		if (clear)
+			renderQuery->Clear();
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			AddToRenderQuery(*renderQuery, sceneNode);
+		});
+	}
+
+	void SceneManager::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear) const
+	{
+		if (clear)
+			sceneNodes.clear();
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			sceneNodes.push_back(sceneNode);
+		});
+	}
+
+	void SceneManager::GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (IsRenderable(sceneNode))
+				renderables.push_back(sceneNode);
+		});
+	}
+
+	void SceneManager::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (IsShadowCaster(sceneNode))
+				renderables.push_back(sceneNode);
+		});
+	}
+
+	void SceneManager::GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+			lights.clear();
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		});
+	}
+
+	void SceneManager::GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+		{
+			renderables.clear();
+			lights.clear();
+		}
+
+		WalkVisible(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (IsRenderable(sceneNode))
+				renderables.push_back(sceneNode);
+			else if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		});
+	}
+
+	void SceneManager::WalkVisible(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		auto frustum = dynamic_cast<const Frustum*>(&collider);
+		if (frustum != nullptr && TransformStore::HasInstance())
+			TransformStore::Instance()->Cull(*frustum, this, filterFunc);
+		else
+			WalkScene(collider, filterFunc);
+	}
+
+	void SceneManager::AddToRenderQuery(RenderQuery &renderQuery, const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetComponent<Light>() != nullptr)
+			renderQuery.AddLight(sceneNode);
+
+		if (IsRenderable(sceneNode))
+			renderQuery.AddRenderable(sceneNode);
+	}
+
+	bool SceneManager::IsRenderable(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		auto render = sceneNode->GetComponent<MeshRender>();
+		return render != nullptr && render->GetRenderable();
+	}
+
+	bool SceneManager::IsShadowCaster(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		auto render = sceneNode->GetComponent<MeshRender>();
+		return render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows();
+	}
+}
\ No newline at end of file
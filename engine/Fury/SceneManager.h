@@ -27,6 +27,8 @@ namespace fury
 
 	public:
 
+		virtual ~SceneManager() {}
+
 		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) = 0;
 
 		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) = 0;
@@ -35,21 +37,44 @@ namespace fury
 
 		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) = 0;
 
-		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const = 0;
+		// called by TransformManager once per batch, override to update nodes in bulk.
+		virtual void UpdateSceneNodes(const SceneNodes &sceneNodes)
+		{
+			for (auto &sceneNode : sceneNodes)
+				UpdateSceneNode(sceneNode);
+		}
+
+		// the query functions below are implemented with WalkVisible by default.
+
+		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const;
 
-		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear = true) const = 0;
+		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear = true) const;
 
-		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const = 0;
+		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
 
-		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const = 0;
+		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
 
-		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const = 0;
+		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const;
 
-		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const = 0;
+		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const;
 
 		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const = 0;
 
 		virtual void Clear() = 0;
+
+	protected:
+
+		// frustums stream TransformStore's world aabbs when the store is enabled, which visits every stored node
+		// but never touches SceneNodes outside the frustum. other colliders, and scenes without the store, use WalkScene.
+		void WalkVisible(const Collidable &collider, const FilterFunc &filterFunc) const;
+
+		// filters shared by the query functions, so overrides that gather nodes differently stay in sync.
+
+		static void AddToRenderQuery(RenderQuery &renderQuery, const std::shared_ptr<SceneNode> &sceneNode);
+
+		static bool IsRenderable(const std::shared_ptr<SceneNode> &sceneNode);
+
+		static bool IsShadowCaster(const std::shared_ptr<SceneNode> &sceneNode);
 	};
 }
 
@@ -10,13 +10,16 @@
 #include "Fury/MeshRender.h"
 #include "Fury/Mesh.h"
 #include "Fury/Material.h"
+#include "Fury/Skeleton.h"
+#include "Fury/TransformManager.h"
 
 namespace fury
 {
 	std::unordered_map<std::string, std::function<Component::Ptr()>> SceneNode::ComponentRegistry = 
 	{
 		{ "MeshRender", []() -> Component::Ptr { return MeshRender::Create(nullptr, nullptr); } },
-		{ "Light", []() -> Component::Ptr { return Light::Create(); } }
+		{ "Light", []() -> Component::Ptr { return Light::Create(); } },
+		{ "Skeleton", []() -> Component::Ptr { return Skeleton::Create(nullptr); } }
 	};
 
 	SceneNode::Ptr SceneNode::Create(const std::string &name)
@@ -29,12 +32,18 @@ namespace fury
 	{
 		m_TypeIndex = typeid(SceneNode);
 		OnTransformChange = Signal<const Ptr&>::Create();
+
+		if (TransformStore::HasInstance())
+			m_TransformHandle = TransformStore::Instance()->Allocate(this);
 	}
 
 	SceneNode::~SceneNode()
 	{
 		RemoveAllComponents(true);
 		RemoveAllChilds();
+
+		if (m_TransformHandle != TransformStore::INVALID_HANDLE && TransformStore::HasInstance())
+			TransformStore::Instance()->Release(m_TransformHandle);
 		//FURYD << m_Name << " destoried.";
 	}
 
@@ -196,6 +205,8 @@ namespace fury
 	{
 		if (!m_OcTreeNode.expired())
 			m_OcTreeNode.lock()->RemoveSceneNode(shared_from_this());
+		else if (m_SceneManager != nullptr)
+			m_SceneManager->RemoveSceneNode(shared_from_this());
 
 		if (recursively)
 		{
@@ -204,18 +215,26 @@ namespace fury
 		}
 	}
 
-	void SceneNode::SetModelAABB(const BoxBounds &aabb)
+	std::shared_ptr<OcTreeNode> SceneNode::GetOcTreeNode() const
 	{
-		if (aabb.GetInfinite())
-		{
-			m_ModelAABB = m_LocalAABB = m_WorldAABB = aabb;
-		}
+		return m_OcTreeNode.lock();
+	}
+
+	SceneManager *SceneNode::GetSceneManager() const
+	{
+		if (auto treeNode = m_OcTreeNode.lock())
+			return &treeNode->GetManager();
 		else
-		{
-			m_ModelAABB = aabb;
-			m_LocalAABB = m_LocalMatrix.Multiply(m_ModelAABB);
-			m_WorldAABB = m_WorldMatrix.Multiply(m_ModelAABB);
-		}
+			return m_SceneManager;
+	}
+
+	void SceneNode::SetModelAABB(const BoxBounds &aabb)
+	{
+		m_ModelAABB = aabb;
+		UpdateAABB();
+
+		if (m_TransformHandle != TransformStore::INVALID_HANDLE)
+			TransformStore::Instance()->SetWorldAABB(m_TransformHandle, m_WorldAABB);
 	}
 
 	BoxBounds SceneNode::GetModelAABB() const
@@ -233,6 +252,11 @@ namespace fury
 		return m_WorldAABB;
 	}
 
+	TransformStore::Handle SceneNode::GetTransformHandle() const
+	{
+		return m_TransformHandle;
+	}
+
 	//////////////////////////////////
 	// Transforms
 	//////////////////////////////////
@@ -242,6 +266,11 @@ namespace fury
 		if (!force && !m_TransformDirty)
 			return;
 
+		TransformManager::Recompose({ shared_from_this() });
+	}
+
+	bool SceneNode::UpdateTransform()
+	{
 		m_TransformDirty = false;
 
 		// update local matrix
@@ -250,7 +279,7 @@ namespace fury
 		m_LocalMatrix.AppendRotation(m_LocalRotation);
 		m_LocalMatrix.AppendScale(m_LocalScale);
 
-		m_InvertLocalMatrix = m_LocalMatrix.Inverse();
+		m_InvertLocalDirty = true;
 
 		// update world matrix
 		if (m_Parent.expired())
@@ -268,21 +297,34 @@ namespace fury
 			m_WorldRotation = matrix.Multiply(m_LocalRotation);
 			m_WorldScale = matrix.Multiply(m_LocalScale);
 		}
-		m_InvertWorldMatrix = m_WorldMatrix.Inverse();
+		m_InvertWorldDirty = true;
 
 		// update bounding box
-		SetModelAABB(m_ModelAABB);
+		BoxBounds worldAABB = m_WorldAABB;
+		UpdateAABB();
 
-		// update octree info
-		if (!m_OcTreeNode.expired())
-			m_OcTreeNode.lock()->GetManager().UpdateSceneNode(shared_from_this());
+		return worldAABB != m_WorldAABB;
+	}
+
+	void SceneNode::UpdateAABB()
+	{
+		if (m_ModelAABB.GetInfinite())
+		{
+			m_LocalAABB = m_WorldAABB = m_ModelAABB;
+		}
+		else
+		{
+			m_LocalAABB = m_LocalMatrix.Multiply(m_ModelAABB);
+			m_WorldAABB = m_WorldMatrix.Multiply(m_ModelAABB);
+		}
+	}
 
-		// trigger event
-		OnTransformChange->Emit(shared_from_this());
+	void SceneNode::SetTransformDirty()
+	{
+		m_TransformDirty = true;
 
-		// force update child nodes' matrix
-		for (auto &child : m_Childs)
-			child->Recompose(true);
+		if (!m_TransformQueued && TransformManager::HasInstance())
+			TransformManager::Instance()->AddDirtyNode(shared_from_this());
 	}
 
 	Matrix4 SceneNode::GetLocalMatrix() const
@@ -292,6 +334,11 @@ namespace fury
 
 	Matrix4 SceneNode::GetInvertLocalMatrix() const
 	{
+		if (m_InvertLocalDirty)
+		{
+			m_InvertLocalMatrix = m_LocalMatrix.Inverse();
+			m_InvertLocalDirty = false;
+		}
 		return m_InvertLocalMatrix;
 	}
 
@@ -302,6 +349,11 @@ namespace fury
 
 	Matrix4 SceneNode::GetInvertWorldMatrix() const
 	{
+		if (m_InvertWorldDirty)
+		{
+			m_InvertWorldMatrix = m_WorldMatrix.Inverse();
+			m_InvertWorldDirty = false;
+		}
 		return m_InvertWorldMatrix;
 	}
 
@@ -340,7 +392,7 @@ namespace fury
 		if (m_TransformDirty || m_LocalPosition != position)
 		{
 			m_LocalPosition = position;
-			m_TransformDirty = true;
+			SetTransformDirty();
 		}
 	}
 
@@ -354,7 +406,7 @@ namespace fury
 		if (m_TransformDirty || m_LocalRotation != rotation)
 		{
 			m_LocalRotation = rotation;
-			m_TransformDirty = true;
+			SetTransformDirty();
 		}
 	}
 
@@ -374,7 +426,7 @@ namespace fury
 		if (m_TransformDirty || m_LocalScale != scale)
 		{
 			m_LocalScale = scale;
-			m_TransformDirty = true;
+			SetTransformDirty();
 		}
 	}
 
@@ -11,6 +11,7 @@
 #include "Fury/Matrix4.h"
 #include "Fury/Vector4.h"
 #include "Fury/Signal.h"
+#include "Fury/TransformStore.h"
 
 namespace fury
 {
@@ -18,6 +19,8 @@ namespace fury
 
 	class OcTreeNode;
 
+	class SceneManager;
+
 	// To destory a scenenode.
 	// Call node.RemoveFromParent + node.RemoveFromOcTree(true) + node.reset.
 	// This node together with all it's childs will be destoried.
@@ -25,6 +28,12 @@ namespace fury
 	{
 		friend class OcTreeNode;
 
+		friend class LinearOcTree;
+
+		friend class BVHTree;
+
+		friend class TransformManager;
+
 	public:
 
 		typedef std::shared_ptr<SceneNode> Ptr;
@@ -38,6 +47,12 @@ namespace fury
 
 		std::weak_ptr<OcTreeNode> m_OcTreeNode;
 
+		// set by scene managers that don't use OcTreeNode.
+		SceneManager *m_SceneManager = nullptr;
+
+		// manager specific id of this node in m_SceneManager.
+		unsigned int m_SceneManagerProxy = 0xffffffff;
+
 		std::weak_ptr<SceneNode> m_Parent;
 
 		std::vector<Ptr> m_Childs;
@@ -52,6 +67,14 @@ namespace fury
 
 		bool m_TransformDirty;
 
+		// true when registered to TransformManager's dirty list.
+		bool m_TransformQueued = false;
+
+		// inverse matrices are computed on demand.
+		mutable bool m_InvertLocalDirty = true;
+
+		mutable bool m_InvertWorldDirty = true;
+
 		Vector4 m_WorldPosition;
 
 		Vector4 m_WorldScale;
@@ -66,11 +89,14 @@ namespace fury
 
 		Matrix4 m_LocalMatrix;
 
-		Matrix4 m_InvertLocalMatrix;
+		mutable Matrix4 m_InvertLocalMatrix;
 
 		Matrix4 m_WorldMatrix;
 
-		Matrix4 m_InvertWorldMatrix;
+		mutable Matrix4 m_InvertWorldMatrix;
+
+		// handle in TransformStore, INVALID_HANDLE if the store isn't enabled.
+		TransformStore::Handle m_TransformHandle = TransformStore::INVALID_HANDLE;
 
 	public:
 
@@ -91,6 +117,11 @@ namespace fury
 		// set recursively to true will call this on child nodes.
 		void RemoveFromOcTree(bool recursively = false);
 
+		std::shared_ptr<OcTreeNode> GetOcTreeNode() const;
+
+		// the scene manager this node is attached to, nullptr if none.
+		SceneManager *GetSceneManager() const;
+
 		void SetModelAABB(const BoxBounds &aabb);
 
 		BoxBounds GetModelAABB() const;
@@ -99,10 +130,14 @@ namespace fury
 
 		BoxBounds GetWorldAABB() const;
 
+		TransformStore::Handle GetTransformHandle() const;
+
 		//////////////////////////////////
 		// Transforms
 		//////////////////////////////////
 
+		// updates this node and all it's childs immediately.
+		// dirty nodes are also recomposed by TransformManager at the end of Engine::Update.
 		void Recompose(bool force = false);
 
 		Matrix4 GetLocalMatrix() const;
@@ -202,6 +237,15 @@ namespace fury
 		void SetOcTreeNode(const std::shared_ptr<OcTreeNode> &ocTreeNode);
 
 		void SetParent(const Ptr &parent);
+
+		void SetTransformDirty();
+
+		// updates matrices and aabbs of this node only, returns true if world aabb changed.
+		// TransformManager copies the results to TransformStore.
+		bool UpdateTransform();
+
+		// local and world aabb from model aabb and matrices.
+		void UpdateAABB();
 	};
 
 	template<class ComponentType>
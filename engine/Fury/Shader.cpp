@@ -1,19 +1,55 @@
+#include <algorithm>
+
+#include "Fury/AnimationSystem.h"
 #include "Fury/Camera.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLState.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/FileUtil.h"
 #include "Fury/Joint.h"
 #include "Fury/Light.h"
 #include "Fury/Material.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshPool.h"
+#include "Fury/RenderUtil.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Shader.h"
+#include "Fury/Skeleton.h"
 #include "Fury/Texture.h"
 #include "Fury/Uniform.h"
 
 namespace fury
 {
+	std::string Shader::INSTANCED = "INSTANCED";
+
+	std::string Shader::CAMERA_BLOCK = "CameraBlock";
+
+	std::string Shader::BONE_BLOCK = "BoneBlock";
+
+	// uniforms bound for every camera and light, hashed once.
+	static const size_t CAMERA_POS = std::hash<std::string>()("camera_pos");
+
+	static const size_t CAMERA_FAR = std::hash<std::string>()("camera_far");
+
+	static const size_t CAMERA_NEAR = std::hash<std::string>()("camera_near");
+
+	static const size_t LIGHT_POS = std::hash<std::string>()("light_pos");
+
+	static const size_t LIGHT_DIR = std::hash<std::string>()("light_dir");
+
+	static const size_t LIGHT_COLOR = std::hash<std::string>()("light_color");
+
+	static const size_t LIGHT_INTENSITY = std::hash<std::string>()("light_intensity");
+
+	static const size_t LIGHT_INNERANGLE = std::hash<std::string>()("light_innerangle");
+
+	static const size_t LIGHT_OUTTERANGLE = std::hash<std::string>()("light_outterangle");
+
+	static const size_t LIGHT_FALLOFF = std::hash<std::string>()("light_falloff");
+
+	static const size_t LIGHT_RADIUS = std::hash<std::string>()("light_radius");
+
 	Shader::Ptr Shader::Create(const std::string &name, ShaderType type, unsigned int textureFlags)
 	{
 		return std::make_shared<Shader>(name, type, textureFlags);
@@ -301,6 +337,14 @@ namespace fury
 			if (m_UseGeomShader)
 				glAttachShader(m_Program, geometryShader);
 
+			// fixed locations, so pooled meshes can share one vao between shaders.
+			glBindAttribLocation(m_Program, MeshPool::POSITION_LOCATION, "vertex_position");
+			glBindAttribLocation(m_Program, MeshPool::NORMAL_LOCATION, "vertex_normal");
+			glBindAttribLocation(m_Program, MeshPool::TANGENT_LOCATION, "vertex_tangent");
+			glBindAttribLocation(m_Program, MeshPool::UV_LOCATION, "vertex_uv");
+			glBindAttribLocation(m_Program, MeshPool::BONE_ID_LOCATION, "bone_ids");
+			glBindAttribLocation(m_Program, MeshPool::BONE_WEIGHT_LOCATION, "bone_weights");
+
 			glLinkProgram(m_Program);
 
 			glDetachShader(m_Program, vertexShader);
@@ -334,6 +378,8 @@ namespace fury
 		}
 		
 		m_Dirty = false;
+		Reflect();
+
 		FURYD << m_Name << " compile & link success!";
 		return true;
 	}
@@ -342,11 +388,54 @@ namespace fury
 	{
 		if (m_Program != 0)
 		{
+			GLState::OnDeleteProgram(m_Program);
 			glDeleteProgram(m_Program);
 			m_Program = 0;
 		}
 
 		m_Dirty = true;
+		m_InstanceLocation = -1;
+
+		m_Uniforms.clear();
+		m_Attributes.clear();
+		m_UseCameraBlock = m_UseBoneBlock = false;
+
+		m_InstancedShader = nullptr;
+		m_InstancedFailed = false;
+	}
+
+	bool Shader::GetInstanced() const
+	{
+		return m_InstanceLocation != -1;
+	}
+
+	Shader::Ptr Shader::GetInstancedShader()
+	{
+		if (m_InstancedShader != nullptr || m_InstancedFailed)
+			return m_InstancedShader;
+
+		m_InstancedFailed = true;
+
+		if (m_Dirty || m_Type != ShaderType::STATIC_MESH || m_FilePath.empty())
+			return nullptr;
+
+		auto shader = Shader::Create(m_Name + "_instanced", m_Type, m_TextureFlags);
+		shader->m_Defines = m_Defines;
+		shader->AddDefine(INSTANCED);
+
+		if (!shader->LoadAndCompile(m_FilePath, m_UseGeomShader))
+			return nullptr;
+
+		if (!shader->GetInstanced())
+		{
+			FURYW << m_Name << " doesn't support instancing, " << Matrix4::INSTANCE_MATRIX << " not found!";
+			return nullptr;
+		}
+
+		m_InstancedShader = shader;
+		m_InstancedFailed = false;
+
+		return m_InstancedShader;
 	}
 
 	void Shader::Bind()
@@ -357,20 +446,26 @@ namespace fury
 			return;
 		}
 
-		glUseProgram(m_Program);
-		m_TextureID = GL_TEXTURE0;
+		GLState::UseProgram(m_Program);
+		m_TextureID = m_SavedTextureID = GL_TEXTURE0;
 	}
 
 	void Shader::BindCamera(const std::shared_ptr<SceneNode> &camNode)
 	{
+		if (m_UseCameraBlock)
+		{
+			RenderUtil::Instance()->UpdateCameraBlock(camNode);
+			return;
+		}
+
 		Vector4 camPos = camNode->GetWorldPosition();
 		if (auto camera = camNode->GetComponent<Camera>())
 		{
-			BindFloat("camera_pos", camPos.x, camPos.y, camPos.z);
-			BindFloat("camera_far", camera->GetFar());
-			BindFloat("camera_near", camera->GetNear());
-			BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &camNode->GetInvertWorldMatrix().Raw[0]);
-			BindMatrix(Matrix4::PROJECTION_MATRIX, &camera->GetProjectionMatrix().Raw[0]);
+			BindFloat(CAMERA_POS, camPos.x, camPos.y, camPos.z);
+			BindFloat(CAMERA_FAR, camera->GetFar());
+			BindFloat(CAMERA_NEAR, camera->GetNear());
+			BindMatrix(Matrix4::INVERT_VIEW_MATRIX_HASH, &camNode->GetInvertWorldMatrix().Raw[0]);
+			BindMatrix(Matrix4::PROJECTION_MATRIX_HASH, &camera->GetProjectionMatrix().Raw[0]);
 		}
 	}
 
@@ -384,27 +479,27 @@ namespace fury
 		if (auto light = lightNode->GetComponent<Light>())
 		{
 			Color color = light->GetColor();
-			BindFloat("light_pos", lightPos.x, lightPos.y, lightPos.z);
-			BindFloat("light_dir", lightDir.x, lightDir.y, lightDir.z);
-			BindFloat("light_color", color.r / pi, color.g / pi, color.b / pi);
-			BindFloat("light_intensity", light->GetIntensity());
-			BindFloat("light_innerangle", light->GetInnerAngle());
-			BindFloat("light_outterangle", light->GetOutterAngle());
-			BindFloat("light_falloff", light->GetFalloff());
-			BindFloat("light_radius", light->GetRadius());
+			BindFloat(LIGHT_POS, lightPos.x, lightPos.y, lightPos.z);
+			BindFloat(LIGHT_DIR, lightDir.x, lightDir.y, lightDir.z);
+			BindFloat(LIGHT_COLOR, color.r / pi, color.g / pi, color.b / pi);
+			BindFloat(LIGHT_INTENSITY, light->GetIntensity());
+			BindFloat(LIGHT_INNERANGLE, light->GetInnerAngle());
+			BindFloat(LIGHT_OUTTERANGLE, light->GetOutterAngle());
+			BindFloat(LIGHT_FALLOFF, light->GetFalloff());
+			BindFloat(LIGHT_RADIUS, light->GetRadius());
 		}
 	}
 
 	void Shader::BindTexture(const std::shared_ptr<Texture> &texture)
 	{
-		glActiveTexture(m_TextureID);
-		glBindTexture(texture->GetTypeUint(), texture->GetID());
+		GLState::ActiveTexture(m_TextureID);
+		GLState::BindTexture(texture->GetTypeUint(), texture->GetID());
 	}
 
 	void Shader::BindTexture(size_t textureId, TextureType type)
 	{
-		glActiveTexture(m_TextureID);
-		glBindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
+		GLState::ActiveTexture(m_TextureID);
+		GLState::BindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
 	}
 
 	void Shader::BindTexture(const std::string &name, const std::shared_ptr<Texture> &texture)
@@ -415,13 +510,10 @@ namespace fury
 			return;
 		}
 
-		int id = GetUniformLocation(name);
-
-		if (id != -1)
+		if (BindSampler(name))
 		{
-			glActiveTexture(m_TextureID);
-			glBindTexture(texture->GetTypeUint(), texture->GetID());
-			glUniform1i(id, m_TextureID - GL_TEXTURE0);
+			GLState::ActiveTexture(m_TextureID);
+			GLState::BindTexture(texture->GetTypeUint(), texture->GetID());
 
 			m_TextureID++;
 		}
@@ -429,18 +521,53 @@ namespace fury
 
 	void Shader::BindTexture(const std::string &name, size_t textureId, TextureType type)
 	{
-		int id = GetUniformLocation(name);
+		if (BindSampler(name))
+		{
+			GLState::ActiveTexture(m_TextureID);
+			GLState::BindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
 
-		if (id != -1)
+			m_TextureID++;
+		}
+	}
+
+	void Shader::BindTexture(size_t nameHash, const std::shared_ptr<Texture> &texture)
+	{
+		if (texture->GetDirty())
+		{
+			FURYW << "Binding dirty texture!";
+			return;
+		}
+
+		if (BindSampler(nameHash))
 		{
-			glActiveTexture(m_TextureID);
-			glBindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
-			glUniform1i(id, m_TextureID - GL_TEXTURE0);
+			GLState::ActiveTexture(m_TextureID);
+			GLState::BindTexture(texture->GetTypeUint(), texture->GetID());
 
 			m_TextureID++;
 		}
 	}
 
+	void Shader::BindTexture(size_t nameHash, size_t textureId, TextureType type)
+	{
+		if (BindSampler(nameHash))
+		{
+			GLState::ActiveTexture(m_TextureID);
+			GLState::BindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
+
+			m_TextureID++;
+		}
+	}
+
+	void Shader::SaveTextureUnit()
+	{
+		m_SavedTextureID = m_TextureID;
+	}
+
+	void Shader::RestoreTextureUnit()
+	{
+		m_TextureID = m_SavedTextureID;
+	}
+
 	void Shader::BindMaterial(const std::shared_ptr<Material> &material)
 	{
 		if (m_Dirty)
@@ -455,25 +582,30 @@ namespace fury
 		{
 			UniformBase::Ptr &ptr = it->second;
 			if (ptr != nullptr)
-				ptr->Bind(m_Program, it->first.c_str());
+				ptr->Bind(GetUniformLocation(it->first));
 		}
 	}
 
 	void Shader::BindMeshData(const std::shared_ptr<Mesh> &mesh)
 	{
-		int posFlag = glGetAttribLocation(m_Program, mesh->Positions.Name.c_str());
-		int normalFlag = glGetAttribLocation(m_Program, mesh->Normals.Name.c_str());
-		int tangentFlag = glGetAttribLocation(m_Program, mesh->Tangents.Name.c_str());
-		int uvFlag = glGetAttribLocation(m_Program, mesh->UVs.Name.c_str());
+		int posFlag = GetAttribLocation(mesh->Positions.Name);
+		int normalFlag = GetAttribLocation(mesh->Normals.Name);
+		int tangentFlag = GetAttribLocation(mesh->Tangents.Name);
+		int uvFlag = GetAttribLocation(mesh->UVs.Name);
 
-		glBindVertexArray(mesh->m_VAO);
+		GLState::BindVertexArray(mesh->m_VAO);
 
-		if (posFlag != -1)
+		// packed meshes keep every attribute in one buffer.
+		bool packed = mesh->GetVertexPacked();
+		if (packed)
+			BindPackedVertices(mesh);
+
+		if (!packed && posFlag != -1)
 		{
 			if (!mesh->Positions.GetDirty())
 			{
 				glBindBuffer(GL_ARRAY_BUFFER, mesh->Positions.GetID());
-				glVertexAttribPointer(posFlag, 3, GL_FLOAT, GL_FALSE, 0, 0);
+				glVertexAttribPointer(posFlag, 3, GL_FLOAT, GL_FALSE, 0, (const void*)mesh->Positions.GetOffset());
 				glEnableVertexAttribArray(posFlag);
 			}
 			else
@@ -481,12 +613,12 @@ namespace fury
 				FURYW << "Mesh " + mesh->GetName() + " Position data dirty!";
 			}
 		}
-		if (normalFlag != -1)
+		if (!packed && normalFlag != -1)
 		{
 			if (!mesh->Normals.GetDirty())
 			{
 				glBindBuffer(GL_ARRAY_BUFFER, mesh->Normals.GetID());
-				glVertexAttribPointer(normalFlag, 3, GL_FLOAT, GL_FALSE, 0, 0);
+				glVertexAttribPointer(normalFlag, 3, GL_FLOAT, GL_FALSE, 0, (const void*)mesh->Normals.GetOffset());
 				glEnableVertexAttribArray(normalFlag);
 			}
 			else
@@ -494,12 +626,12 @@ namespace fury
 				FURYW << "Mesh " + mesh->GetName() + " Normal data dirty!";
 			}
 		}
-		if (tangentFlag != -1)
+		if (!packed && tangentFlag != -1)
 		{
 			if (!mesh->Tangents.GetDirty())
 			{
 				glBindBuffer(GL_ARRAY_BUFFER, mesh->Tangents.GetID());
-				glVertexAttribPointer(tangentFlag, 3, GL_FLOAT, GL_FALSE, 0, 0);
+				glVertexAttribPointer(tangentFlag, 3, GL_FLOAT, GL_FALSE, 0, (const void*)mesh->Tangents.GetOffset());
 				glEnableVertexAttribArray(tangentFlag);
 			}
 			else
@@ -507,12 +639,12 @@ namespace fury
 				FURYW << "Mesh" + mesh->GetName() + " Tangent data dirty!";
 			}
 		}
-		if (uvFlag != -1)
+		if (!packed && uvFlag != -1)
 		{
 			if (!mesh->UVs.GetDirty())
 			{
 				glBindBuffer(GL_ARRAY_BUFFER, mesh->UVs.GetID());
-				glVertexAttribPointer(uvFlag, 2, GL_FLOAT, GL_FALSE, 0, 0);
+				glVertexAttribPointer(uvFlag, 2, GL_FLOAT, GL_FALSE, 0, (const void*)mesh->UVs.GetOffset());
 				glEnableVertexAttribArray(uvFlag);
 			}
 			else
@@ -523,15 +655,19 @@ namespace fury
 
 		if (mesh->IsSkinnedMesh())
 		{
-			int idFlag = glGetAttribLocation(m_Program, mesh->IDs.Name.c_str());
-			int weightFlag = glGetAttribLocation(m_Program, mesh->Weights.Name.c_str());
+			int idFlag = GetAttribLocation(mesh->IDs.Name);
+			int weightFlag = GetAttribLocation(mesh->Weights.Name);
 
-			if (idFlag != -1)
+			if (idFlag == -1)
+			{
+				FURYW << "Can't find " << mesh->IDs.Name << " in " << m_Name;
+			}
+			else if (!packed)
 			{
 				if (!mesh->IDs.GetDirty())
 				{
 					glBindBuffer(GL_ARRAY_BUFFER, mesh->IDs.GetID());
-					glVertexAttribIPointer(idFlag, 4, GL_UNSIGNED_INT, 0, 0);
+					glVertexAttribIPointer(idFlag, 4, GL_UNSIGNED_INT, 0, (const void*)mesh->IDs.GetOffset());
 					glEnableVertexAttribArray(idFlag);
 				}
 				else
@@ -539,17 +675,17 @@ namespace fury
 					FURYW << "Mesh " + mesh->GetName() + " ID data dirty!";
 				}
 			}
-			else
+
+			if (weightFlag == -1)
 			{
-				FURYW << "Can't find " << mesh->IDs.Name << " in " << m_Name;
+				FURYW << "Can't find " << mesh->Weights.Name << " in " << m_Name;
 			}
-
-			if (weightFlag != -1)
+			else if (!packed)
 			{
 				if (!mesh->Weights.GetDirty())
 				{
 					glBindBuffer(GL_ARRAY_BUFFER, mesh->Weights.GetID());
-					glVertexAttribPointer(weightFlag, 3, GL_FLOAT, GL_FALSE, 0, 0);
+					glVertexAttribPointer(weightFlag, 3, GL_FLOAT, GL_FALSE, 0, (const void*)mesh->Weights.GetOffset());
 					glEnableVertexAttribArray(weightFlag);
 				}
 				else
@@ -557,45 +693,119 @@ namespace fury
 					FURYW << "Mesh " + mesh->GetName() + " Weight data dirty!";
 				}
 			}
-			else
-			{
-				FURYW << "Can't find " << mesh->Weights.Name << " in " << m_Name;
-			}
 
-			if (idFlag != -1 && weightFlag != -1)
+			// bind pose, nodes with a Skeleton bind their own palette per draw.
+			if (idFlag != -1 && weightFlag != -1 && mesh->GetJointCount() > 0)
 			{
-				int jointCount = (int)mesh->GetJointCount();
-				if (jointCount > 35)
-				{
-					FURYW << "Max joint count 35!";
-					jointCount = 35;
-				}
-
-				std::vector<float> raw(jointCount * 16);
+				unsigned int jointCount = mesh->GetJointCount();
+				m_BindPose.resize(jointCount * 16);
 
-				for (int i = 0; i < jointCount; i++)
+				for (unsigned int i = 0; i < jointCount; i++)
 				{
-					auto joint = mesh->GetJointAt(i);
-					auto matrix = joint->GetFinalMatrix();
-					int index = i * 16;
-
-					for (int j = 0; j < 16; j++)
-					{
-						raw[index + j] = matrix.Raw[j];
-					}
+					auto matrix = mesh->GetJointAt(i)->GetFinalMatrix();
+					std::copy(matrix.Raw, matrix.Raw + 16, &m_BindPose[i * 16]);
 				}
 
-				BindMatrices("bone_matrices", jointCount, &raw[0]);
+				BindPalette(&m_BindPose[0], jointCount);
 			}
 		}
 		
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	void Shader::BindSkeleton(const std::shared_ptr<Skeleton> &skeleton)
+	{
+		auto mesh = skeleton->GetMesh();
+		if (mesh == nullptr || skeleton->GetPaletteSize() == 0)
+			return;
+
+		if (GetAttribLocation(mesh->IDs.Name) == -1 || GetAttribLocation(mesh->Weights.Name) == -1)
+			return;
+
+		// AnimationSystem already uploaded it this frame.
+		unsigned int buffer;
+		size_t offset;
+		if (m_UseBoneBlock && AnimationSystem::HasInstance() && AnimationSystem::Instance()->GetPaletteRange(*skeleton, buffer, offset))
+		{
+			glBindBufferRange(GL_UNIFORM_BUFFER, BONE_BLOCK_BINDING, buffer, offset, MAX_JOINT_COUNT * 16 * sizeof(float));
+			return;
+		}
+
+		BindPalette(skeleton->GetPalette(), skeleton->GetPaletteSize());
+	}
+
+	void Shader::BindPalette(const float *palette, unsigned int count)
+	{
+		if (count > MAX_JOINT_COUNT)
+		{
+			FURYW << "Max joint count " << MAX_JOINT_COUNT << "!";
+			count = MAX_JOINT_COUNT;
+		}
+
+		if (m_UseBoneBlock)
+		{
+			// the block is always bound in full, so unused joints are zero.
+			float raw[MAX_JOINT_COUNT * 16];
+			std::copy(palette, palette + count * 16, raw);
+			std::fill(raw + count * 16, raw + MAX_JOINT_COUNT * 16, 0.0f);
+			RenderUtil::Instance()->UpdateBoneBlock(raw, MAX_JOINT_COUNT);
+		}
+		else
+		{
+			BindMatrices("bone_matrices", count, palette);
+		}
+	}
+
+	void Shader::BindPackedVertices(const std::shared_ptr<Mesh> &mesh)
+	{
+		auto format = mesh->GetVertexFormat(mesh->m_VertexLayout);
+		bool quantized = mesh->m_VertexLayout == VertexLayout::QUANTIZED;
+
+		const std::string names[] = { mesh->Positions.Name, mesh->Normals.Name, mesh->Tangents.Name,
+			mesh->UVs.Name, mesh->IDs.Name, mesh->Weights.Name };
+		const int offsets[] = { format.position, format.normal, format.tangent, format.uv, format.ids, format.weights };
+
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->m_Vertices.GetID());
+
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			int flag = GetAttribLocation(names[i]);
+			if (flag == -1)
+				continue;
+
+			if (offsets[i] == -1)
+			{
+				FURYW << "Mesh " + mesh->GetName() + " has no " + names[i] + " data!";
+				continue;
+			}
+
+			const void* offset = (const void*)(size_t)offsets[i];
+			if (i == 0)
+				glVertexAttribPointer(flag, 3, GL_FLOAT, GL_FALSE, format.stride, offset);
+			else if (i == 1 || i == 2)
+			{
+				if (quantized)
+					glVertexAttribPointer(flag, 4, GL_INT_2_10_10_10_REV, GL_TRUE, format.stride, offset);
+				else
+					glVertexAttribPointer(flag, 3, GL_FLOAT, GL_FALSE, format.stride, offset);
+			}
+			else if (i == 3)
+				glVertexAttribPointer(flag, 2, quantized ? GL_HALF_FLOAT : GL_FLOAT, GL_FALSE, format.stride, offset);
+			else if (i == 4)
+				glVertexAttribIPointer(flag, 4, quantized ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT, format.stride, offset);
+			else
+				glVertexAttribPointer(flag, 3, quantized ? GL_UNSIGNED_BYTE : GL_FLOAT, quantized ? GL_TRUE : GL_FALSE, format.stride, offset);
+
+			glEnableVertexAttribArray(flag);
+		}
+	}
+
 	void Shader::BindMesh(const std::shared_ptr<Mesh> &mesh)
 	{
 		if (mesh->GetDirty())
 			mesh->UpdateBuffer();
+		else
+			mesh->UpdateDirtyRanges();
 
 		if (m_Dirty || mesh->GetDirty() || mesh->Indices.GetDirty())
 			return;
@@ -605,6 +815,14 @@ namespace fury
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->Indices.GetID());
 	}
 
+	void Shader::BindPooledMesh(const std::shared_ptr<Mesh> &mesh)
+	{
+		if (m_Dirty || mesh->GetPoolPage() == -1)
+			return;
+
+		GLState::BindVertexArray(MeshPool::Instance()->GetVertexArray(mesh->GetPoolPage()));
+	}
+
 	void Shader::BindSubMesh(const std::shared_ptr<Mesh> &mesh, unsigned int index)
 	{
 		auto subMesh = mesh->GetSubMeshAt(index);
@@ -623,6 +841,34 @@ namespace fury
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, subMesh->Indices.GetID());
 	}
 
+	void Shader::BindInstances(unsigned int buffer, size_t offset)
+	{
+		if (m_Dirty || m_InstanceLocation == -1)
+			return;
+
+		// a mat4 attribute takes 4 locations, one per column.
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		for (int i = 0; i < 4; i++)
+		{
+			glVertexAttribPointer(m_InstanceLocation + i, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16, (const void*)(offset + sizeof(float) * 4 * i));
+			glVertexAttribDivisor(m_InstanceLocation + i, 1);
+			glEnableVertexAttribArray(m_InstanceLocation + i);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void Shader::UnBindInstances()
+	{
+		if (m_Dirty || m_InstanceLocation == -1)
+			return;
+
+		for (int i = 0; i < 4; i++)
+		{
+			glVertexAttribDivisor(m_InstanceLocation + i, 0);
+			glDisableVertexAttribArray(m_InstanceLocation + i);
+		}
+	}
+
 	void Shader::BindMatrix(const std::string &name, const Matrix4 &matrix)
 	{
 		BindMatrix(name, &matrix.Raw[0]);
@@ -635,6 +881,18 @@ namespace fury
 			glUniformMatrix4fv(id, 1, false, raw);
 	}
 
+	void Shader::BindMatrix(size_t nameHash, const Matrix4 &matrix)
+	{
+		BindMatrix(nameHash, &matrix.Raw[0]);
+	}
+
+	void Shader::BindMatrix(size_t nameHash, const float *raw)
+	{
+		int id = GetUniformLocation(nameHash);
+		if (id != -1)
+			glUniformMatrix4fv(id, 1, false, raw);
+	}
+
 	void Shader::BindMatrices(const std::string &name, int count, const float *raw)
 	{
 		int id = GetUniformLocation(name);
@@ -685,6 +943,27 @@ namespace fury
 			glUniform4f(id, v0, v1, v2, v3);
 	}
 
+	void Shader::BindFloat(size_t nameHash, float v0)
+	{
+		int id = GetUniformLocation(nameHash);
+		if (id != -1)
+			glUniform1f(id, v0);
+	}
+
+	void Shader::BindFloat(size_t nameHash, float v0, float v1, float v2)
+	{
+		int id = GetUniformLocation(nameHash);
+		if (id != -1)
+			glUniform3f(id, v0, v1, v2);
+	}
+
+	void Shader::BindFloat(size_t nameHash, float v0, float v1, float v2, float v3)
+	{
+		int id = GetUniformLocation(nameHash);
+		if (id != -1)
+			glUniform4f(id, v0, v1, v2, v3);
+	}
+
 	void Shader::BindFloat(const std::string &name, int size, int count, const float *value)
 	{
 		int id = GetUniformLocation(name);
@@ -818,11 +1097,11 @@ namespace fury
 
 	void Shader::UnBind()
 	{
-		m_TextureID = GL_TEXTURE0;
+		m_TextureID = m_SavedTextureID = GL_TEXTURE0;
 
-		glUseProgram(0);
+		GLState::UseProgram(0);
 
-		glBindVertexArray(0);
+		GLState::BindVertexArray(0);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
@@ -831,9 +1110,145 @@ namespace fury
 		if (m_Dirty)
 			return -1;
 
+		if (auto variable = FindVariable(m_Uniforms, name, true))
+			return variable->location;
+
 		return glGetUniformLocation(m_Program, name.c_str());
 	}
 
+	int Shader::GetUniformLocation(size_t nameHash) const
+	{
+		if (m_Dirty)
+			return -1;
+
+		auto variable = FindVariable(m_Uniforms, nameHash);
+		return variable != nullptr ? variable->location : -1;
+	}
+
+	int Shader::GetAttribLocation(const std::string &name) const
+	{
+		if (m_Dirty)
+			return -1;
+
+		if (auto variable = FindVariable(m_Attributes, name, false))
+			return variable->location;
+
+		return glGetAttribLocation(m_Program, name.c_str());
+	}
+
+	void Shader::Reflect()
+	{
+		m_Uniforms.clear();
+		m_Attributes.clear();
+
+		std::hash<std::string> hasher;
+		char buffer[256];
+		GLsizei length;
+		GLint size;
+		GLenum type;
+
+		GLint uniformCount = 0;
+		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &uniformCount);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			glGetActiveUniform(m_Program, i, sizeof(buffer), &length, &size, &type, buffer);
+
+			// block members have no location.
+			int location = glGetUniformLocation(m_Program, buffer);
+			if (location == -1)
+				continue;
+
+			// arrays are reported as name[0], but bound by name.
+			std::string name(buffer, length);
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+				name.resize(name.size() - 3);
+
+			m_Uniforms[hasher(name)] = { name, location, -1 };
+		}
+
+		GLint attribCount = 0;
+		glGetProgramiv(m_Program, GL_ACTIVE_ATTRIBUTES, &attribCount);
+		for (GLint i = 0; i < attribCount; i++)
+		{
+			glGetActiveAttrib(m_Program, i, sizeof(buffer), &length, &size, &type, buffer);
+
+			std::string name(buffer, length);
+			m_Attributes[hasher(name)] = { name, glGetAttribLocation(m_Program, buffer), -1 };
+		}
+
+		m_InstanceLocation = GetAttribLocation(Matrix4::INSTANCE_MATRIX);
+
+		unsigned int cameraBlock = glGetUniformBlockIndex(m_Program, CAMERA_BLOCK.c_str());
+		m_UseCameraBlock = cameraBlock != GL_INVALID_INDEX;
+		if (m_UseCameraBlock)
+			glUniformBlockBinding(m_Program, cameraBlock, CAMERA_BLOCK_BINDING);
+
+		unsigned int boneBlock = glGetUniformBlockIndex(m_Program, BONE_BLOCK.c_str());
+		m_UseBoneBlock = boneBlock != GL_INVALID_INDEX;
+		if (m_UseBoneBlock)
+			glUniformBlockBinding(m_Program, boneBlock, BONE_BLOCK_BINDING);
+	}
+
+	Shader::Variable *Shader::FindVariable(std::unordered_map<size_t, Variable> &variables, const std::string &name, bool uniform) const
+	{
+		size_t hash = std::hash<std::string>()(name);
+
+		if (auto variable = FindVariable(variables, hash))
+			return variable->name == name ? variable : nullptr;
+
+		// inactive names and names like array[1] aren't listed after linking.
+		int location = uniform ? glGetUniformLocation(m_Program, name.c_str()) : glGetAttribLocation(m_Program, name.c_str());
+		return &(variables[hash] = { name, location, -1 });
+	}
+
+	Shader::Variable *Shader::FindVariable(std::unordered_map<size_t, Variable> &variables, size_t hash) const
+	{
+		auto it = variables.find(hash);
+		return it != variables.end() ? &it->second : nullptr;
+	}
+
+	bool Shader::BindSampler(const std::string &name)
+	{
+		if (m_Dirty)
+			return false;
+
+		if (auto variable = FindVariable(m_Uniforms, name, true))
+			return BindSampler(*variable);
+
+		// another name with the same hash is cached, so this one isn't.
+		int location = glGetUniformLocation(m_Program, name.c_str());
+		if (location == -1)
+			return false;
+
+		glUniform1i(location, m_TextureID - GL_TEXTURE0);
+		return true;
+	}
+
+	bool Shader::BindSampler(size_t nameHash)
+	{
+		if (m_Dirty)
+			return false;
+
+		auto variable = FindVariable(m_Uniforms, nameHash);
+		return variable != nullptr && BindSampler(*variable);
+	}
+
+	bool Shader::BindSampler(Variable &variable)
+	{
+		if (variable.location == -1)
+			return false;
+
+		// uniform values stay in the program, so only changed units are set.
+		int unit = m_TextureID - GL_TEXTURE0;
+		if (variable.unit != unit)
+		{
+			glUniform1i(variable.location, unit);
+			variable.unit = unit;
+		}
+
+		return true;
+	}
+
 	void Shader::GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr)
 	{
 		auto index = source.find("#version");
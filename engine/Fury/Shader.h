@@ -2,6 +2,7 @@
 #define _FURY_SHADER_H_
 
 #include <iostream>
+#include <unordered_map>
 
 #include "Fury/Entity.h"
 #include "Fury/EnumUtil.h"
@@ -15,6 +16,8 @@ namespace fury
 
 	class SceneNode;
 
+	class Skeleton;
+
 	class Texture;
 
 	// always bind shader first. then material and meshes.
@@ -26,8 +29,35 @@ namespace fury
 
 		static Ptr Create(const std::string &name, ShaderType type, unsigned int textureFlags = 0);
 
+		// define of instanced shader variants, they read world matrices from Matrix4::INSTANCE_MATRIX attribute.
+		static std::string INSTANCED;
+
+		// std140 uniform block shared by all programs, RenderUtil keeps it's buffer.
+		// programs declaring it get camera data from the buffer instead of plain uniforms.
+		static std::string CAMERA_BLOCK;
+
+		static const unsigned int CAMERA_BLOCK_BINDING = 0;
+
+		// skinning palette block, streamed per draw through RenderUtil's palette ring.
+		static std::string BONE_BLOCK;
+
+		static const unsigned int BONE_BLOCK_BINDING = 1;
+
+		// size of bone_matrices array in skinned shaders.
+		static const unsigned int MAX_JOINT_COUNT = 35;
+
 	protected:
 
+		struct Variable
+		{
+			std::string name;
+
+			int location;
+
+			// texture unit last set to a sampler, -1 if unknown.
+			int unit;
+		};
+
 		std::string m_FilePath;
 
 		ShaderType m_Type;
@@ -40,10 +70,32 @@ namespace fury
 
 		unsigned int m_TextureID = 0;
 
+		unsigned int m_SavedTextureID = 0;
+
 		bool m_Dirty = true;
 
 		bool m_UseGeomShader = false;
 
+		// location of instance matrix attribute, -1 if the shader isn't instanced.
+		int m_InstanceLocation = -1;
+
+		Ptr m_InstancedShader;
+
+		bool m_InstancedFailed = false;
+
+		// active uniforms and attributes by hash of their names, filled after linking.
+		// names not found there are looked up once and cached, -1 included.
+		mutable std::unordered_map<size_t, Variable> m_Uniforms;
+
+		mutable std::unordered_map<size_t, Variable> m_Attributes;
+
+		bool m_UseCameraBlock = false;
+
+		bool m_UseBoneBlock = false;
+
+		// bind pose palette of meshes drawn without a Skeleton, kept to avoid an allocation per draw.
+		std::vector<float> m_BindPose;
+
 	public:
 
 		Shader(const std::string &name, ShaderType type, unsigned int textureFlags = 0);
@@ -74,6 +126,20 @@ namespace fury
 
 		void DeleteProgram();
 
+		bool GetInstanced() const;
+
+		int GetUniformLocation(const std::string &name) const;
+
+		// lookup by std::hash of the name, for names hashed once by the caller.
+		// only finds uniforms listed after linking, so elements like name[1] need the string version.
+		int GetUniformLocation(size_t nameHash) const;
+
+		int GetAttribLocation(const std::string &name) const;
+
+		// compiles this shader again from it's file with INSTANCED defined, for static mesh shaders that aren't instanced.
+		// returns nullptr if the variant doesn't compile or doesn't read instance matrices.
+		Ptr GetInstancedShader();
+
 		void Bind();
 
 		void BindCamera(const std::shared_ptr<SceneNode> &camNode);
@@ -90,16 +156,43 @@ namespace fury
 
 		void BindTexture(const std::string &name, size_t textureId, TextureType type);
 
+		void BindTexture(size_t nameHash, const std::shared_ptr<Texture> &texture);
+
+		void BindTexture(size_t nameHash, size_t textureId, TextureType type);
+
+		// named BindTexture takes the next texture unit, Bind resets them.
+		// save the unit after binding shared textures, and restore it before each material
+		// when materials change without binding the shader again.
+		void SaveTextureUnit();
+
+		void RestoreTextureUnit();
+
 		void BindMaterial(const std::shared_ptr<Material> &material);
 
 		void BindMesh(const std::shared_ptr<Mesh> &mesh);
 
 		void BindSubMesh(const std::shared_ptr<Mesh> &mesh, unsigned int index);
 
+		// binds the shared vao of mesh's MeshPool page, draw with the mesh's base vertex and first index.
+		void BindPooledMesh(const std::shared_ptr<Mesh> &mesh);
+
+		// binds skeleton's palette over the bind pose BindMesh bound, call for every skinned draw.
+		void BindSkeleton(const std::shared_ptr<Skeleton> &skeleton);
+
+		// binds 4x4 float matrices starting at offset bytes in buffer as per instance attributes, call after BindMesh.
+		void BindInstances(unsigned int buffer, size_t offset);
+
+		// resets instance attributes, so mesh's vao can be used with other shaders.
+		void UnBindInstances();
+
 		void BindMatrix(const std::string &name, const Matrix4 &matrix);
 
 		void BindMatrix(const std::string &name, const float *raw);
 
+		void BindMatrix(size_t nameHash, const Matrix4 &matrix);
+
+		void BindMatrix(size_t nameHash, const float *raw);
+
 		void BindMatrices(const std::string &name, int count, const float *raw);
 
 		void BindMatrices(const std::string &name, int count, const Matrix4 *matrices);
@@ -112,6 +205,12 @@ namespace fury
 
 		void BindFloat(const std::string &name, float v0, float v1, float v2, float v3);
 
+		void BindFloat(size_t nameHash, float v0);
+
+		void BindFloat(size_t nameHash, float v0, float v1, float v2);
+
+		void BindFloat(size_t nameHash, float v0, float v1, float v2, float v3);
+
 		void BindFloat(const std::string &name, int size, int count, const float *value);
 
 		void BindInt(const std::string &name, int v0);
@@ -140,7 +239,26 @@ namespace fury
 
 		void BindMeshData(const std::shared_ptr<Mesh> &mesh);
 
-		int GetUniformLocation(const std::string &name) const;
+		// count 4x4 float matrices to bone_matrices, or Shader::BONE_BLOCK.
+		void BindPalette(const float *palette, unsigned int count);
+
+		// sets attribute pointers into mesh's interleaved buffer, for VertexLayout other than SEPARATE.
+		void BindPackedVertices(const std::shared_ptr<Mesh> &mesh);
+
+		// caches active uniforms and attributes, and binds shared uniform blocks.
+		void Reflect();
+
+		Variable *FindVariable(std::unordered_map<size_t, Variable> &variables, const std::string &name, bool uniform) const;
+
+		// cached variable only, nullptr if hash isn't known.
+		Variable *FindVariable(std::unordered_map<size_t, Variable> &variables, size_t hash) const;
+
+		// sets sampler name to texture unit m_TextureID, returns false if it's not used by the program.
+		bool BindSampler(const std::string &name);
+
+		bool BindSampler(size_t nameHash);
+
+		bool BindSampler(Variable &variable);
 
 		void GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr);
 
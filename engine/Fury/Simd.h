@@ -0,0 +1,80 @@
+#ifndef _FURY_SIMD_H_
+#define _FURY_SIMD_H_
+
+// Thin wrappers over sse/neon intrinsics, so math kernels are written once for both backends.
+// Only include this in translation units, FURY_SIMD_SSE/FURY_SIMD_NEON are defined in Macros.h.
+
+#include "Fury/Macros.h"
+
+#if defined(FURY_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(FURY_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace fury
+{
+	namespace simd
+	{
+#if defined(FURY_SIMD_SSE)
+
+		typedef __m128 Float4;
+
+		inline Float4 Load(const float *ptr) { return _mm_loadu_ps(ptr); }
+
+		inline void Store(float *ptr, Float4 value) { _mm_storeu_ps(ptr, value); }
+
+		inline Float4 Splat(float value) { return _mm_set1_ps(value); }
+
+		inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+
+		inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+
+		inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+		inline Float4 Abs(Float4 value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+
+		inline Float4 CmpLt(Float4 a, Float4 b) { return _mm_cmplt_ps(a, b); }
+
+		inline Float4 Or(Float4 a, Float4 b) { return _mm_or_ps(a, b); }
+
+		// bit i is set when lane i's sign bit is set.
+		inline int MoveMask(Float4 value) { return _mm_movemask_ps(value); }
+
+#elif defined(FURY_SIMD_NEON)
+
+		typedef float32x4_t Float4;
+
+		inline Float4 Load(const float *ptr) { return vld1q_f32(ptr); }
+
+		inline void Store(float *ptr, Float4 value) { vst1q_f32(ptr, value); }
+
+		inline Float4 Splat(float value) { return vdupq_n_f32(value); }
+
+		inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+
+		inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+
+		inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+		inline Float4 Abs(Float4 value) { return vabsq_f32(value); }
+
+		inline Float4 CmpLt(Float4 a, Float4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+
+		inline Float4 Or(Float4 a, Float4 b)
+		{
+			return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+		}
+
+		inline int MoveMask(Float4 value)
+		{
+			static const int32_t shifts[4] = { 0, 1, 2, 3 };
+			uint32x4_t bits = vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(value), 31), vld1q_s32(shifts));
+			return (int)(vgetq_lane_u32(bits, 0) | vgetq_lane_u32(bits, 1) | vgetq_lane_u32(bits, 2) | vgetq_lane_u32(bits, 3));
+		}
+
+#endif
+	}
+}
+
+#endif // _FURY_SIMD_H_
\ No newline at end of file
@@ -25,6 +25,11 @@ namespace fury
 			return m_Instance;
 		}
 
+		inline static bool HasInstance()
+		{
+			return m_Instance != nullptr;
+		}
+
 		// make sure your singleton initializes later than log singleton.
 		inline static std::shared_ptr<TargetType> &Initialize(Args&&... args)
 		{
@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cmath>
+#include <stack>
+
+#include "Fury/Log.h"
+#include "Fury/Mesh.h"
+#include "Fury/Joint.h"
+#include "Fury/PoseBuffer.h"
+#include "Fury/Scene.h"
+#include "Fury/Skeleton.h"
+
+namespace fury
+{
+	Skeleton::Ptr Skeleton::Create(const std::shared_ptr<Mesh> &mesh)
+	{
+		return std::make_shared<Skeleton>(mesh);
+	}
+
+	Skeleton::Skeleton(const std::shared_ptr<Mesh> &mesh)
+	{
+		m_TypeIndex = typeid(Skeleton);
+		SetMesh(mesh);
+	}
+
+	bool Skeleton::Load(const void* wrapper, bool object)
+	{
+		if (Scene::Active == nullptr)
+		{
+			FURYE << "Active Pipeline is null!";
+			return false;
+		}
+
+		if (object && !IsObject(wrapper))
+		{
+			FURYE << "Json node is not an object!";
+			return false;
+		}
+
+		std::string str;
+		if (!LoadMemberValue(wrapper, "type", str) || str != "Skeleton")
+		{
+			FURYE << "Invalide type " << str << "!";
+			return false;
+		}
+
+		if (!LoadMemberValue(wrapper, "mesh", str))
+		{
+			FURYE << "mesh not found!";
+			return false;
+		}
+
+		if (auto mesh = Scene::Manager()->Get<Mesh>(str))
+		{
+			SetMesh(mesh);
+		}
+		else
+		{
+			FURYE << "Mesh " << str << " not found!";
+			return false;
+		}
+
+		return true;
+	}
+
+	void Skeleton::Save(void* wrapper, bool object)
+	{
+		if (object)
+			StartObject(wrapper);
+
+		SaveKey(wrapper, "type");
+		SaveValue(wrapper, "Skeleton");
+
+		if (auto ptr = m_Mesh.lock())
+		{
+			SaveKey(wrapper, "mesh");
+			SaveValue(wrapper, ptr->GetName());
+		}
+
+		if (object)
+			EndObject(wrapper);
+	}
+
+	Component::Ptr Skeleton::Clone() const
+	{
+		return Skeleton::Create(m_Mesh.lock());
+	}
+
+	void Skeleton::SetMesh(const std::shared_ptr<Mesh> &mesh)
+	{
+		m_Mesh = mesh;
+
+		m_JointMap.clear();
+		m_Parents.clear();
+		m_BindMatrices.clear();
+		m_BindPoses.clear();
+		m_PaletteJoints.clear();
+		m_OffsetMatrices.clear();
+
+		if (mesh != nullptr && mesh->IsSkinnedMesh())
+		{
+			// flatten depth first, so parents come first.
+			std::stack<std::pair<Joint::Ptr, int>> jointStack;
+			jointStack.push(std::make_pair(mesh->GetRootJoint(), -1));
+
+			while (!jointStack.empty())
+			{
+				auto pair = jointStack.top();
+				jointStack.pop();
+
+				int index = m_Parents.size();
+				m_JointMap[pair.first->GetHashCode()] = index;
+				m_Parents.push_back(pair.second);
+				m_BindMatrices.push_back(pair.first->GetLocalMatrix());
+				m_BindPoses.push_back(DecomposeMatrix(pair.first->GetLocalMatrix()));
+
+				for (auto child = pair.first->GetFirstChild(); child != nullptr; child = child->GetSibling())
+					jointStack.push(std::make_pair(child, index));
+			}
+
+			unsigned int jointCount = mesh->GetJointCount();
+			for (unsigned int i = 0; i < jointCount; i++)
+			{
+				auto joint = mesh->GetJointAt(i);
+				auto it = m_JointMap.find(joint->GetHashCode());
+				if (it == m_JointMap.end())
+				{
+					FURYW << "Joint " << joint->GetName() << " isn't in " << mesh->GetName() << "'s joint tree!";
+					m_PaletteJoints.push_back(0);
+				}
+				else
+				{
+					m_PaletteJoints.push_back(it->second);
+				}
+
+				m_OffsetMatrices.push_back(joint->GetOffsetMatrix());
+			}
+		}
+
+		unsigned int count = m_Parents.size();
+		m_OldPoses.assign(count, JointPose());
+		m_Poses.assign(count, JointPose());
+		m_Posed.assign(count, false);
+		m_CombinedMatrices.assign(count, Matrix4());
+		m_Palette.assign(m_PaletteJoints.size() * 16, 0.0f);
+
+		Update(1.0f);
+	}
+
+	std::shared_ptr<Mesh> Skeleton::GetMesh() const
+	{
+		return m_Mesh.lock();
+	}
+
+	int Skeleton::GetJointIndex(const std::string &name) const
+	{
+		return GetJointIndex(std::hash<std::string>()(name));
+	}
+
+	int Skeleton::GetJointIndex(size_t hashCode) const
+	{
+		auto it = m_JointMap.find(hashCode);
+		return it != m_JointMap.end() ? (int)it->second : -1;
+	}
+
+	unsigned int Skeleton::GetJointCount() const
+	{
+		return m_Parents.size();
+	}
+
+	void Skeleton::SetPose(unsigned int index, const JointPose &pose, bool reset)
+	{
+		if (index >= m_Poses.size())
+			return;
+
+		m_OldPoses[index] = reset ? pose : m_Poses[index];
+		m_Poses[index] = pose;
+		m_Posed[index] = true;
+	}
+
+	void Skeleton::SetPose(const PoseBuffer &pose, bool reset)
+	{
+		unsigned int count = std::min<unsigned int>(pose.count, m_Poses.size());
+		for (unsigned int i = 0; i < count; i++)
+			SetPose(i, pose.poses[i], reset);
+	}
+
+	const Skeleton::JointPose &Skeleton::GetPose(unsigned int index) const
+	{
+		return m_Poses[index];
+	}
+
+	void Skeleton::GetBindPose(PoseBuffer &pose) const
+	{
+		unsigned int count = std::min<unsigned int>(pose.count, m_BindPoses.size());
+		for (unsigned int i = 0; i < count; i++)
+			pose.poses[i] = m_BindPoses[i];
+	}
+
+	void Skeleton::GetJointMask(const std::string &name, float weight, std::vector<float> &mask) const
+	{
+		unsigned int count = m_Parents.size();
+		mask.resize(count, 0.0f);
+
+		int root = GetJointIndex(name);
+		if (root < 0)
+		{
+			FURYW << "Joint " << name << " not found!";
+			return;
+		}
+
+		// parents come first, so one pass finds every child.
+		std::vector<bool> masked(count, false);
+		for (unsigned int i = root; i < count; i++)
+		{
+			if (i == (unsigned int)root || (m_Parents[i] >= 0 && masked[m_Parents[i]]))
+			{
+				masked[i] = true;
+				mask[i] = weight;
+			}
+		}
+	}
+
+	Skeleton::JointPose Skeleton::DecomposeMatrix(const Matrix4 &matrix)
+	{
+		const float *raw = matrix.Raw;
+
+		JointPose pose;
+		pose.position = Vector4(raw[12], raw[13], raw[14]);
+
+		// local matrix is translation * rotation * scale, columns of the upper 3x3 are scaled axes.
+		float sx = std::sqrt(raw[0] * raw[0] + raw[1] * raw[1] + raw[2] * raw[2]);
+		float sy = std::sqrt(raw[4] * raw[4] + raw[5] * raw[5] + raw[6] * raw[6]);
+		float sz = std::sqrt(raw[8] * raw[8] + raw[9] * raw[9] + raw[10] * raw[10]);
+
+		float det = raw[0] * (raw[5] * raw[10] - raw[9] * raw[6]) - raw[4] * (raw[1] * raw[10] - raw[9] * raw[2]) + 
+			raw[8] * (raw[1] * raw[6] - raw[5] * raw[2]);
+		if (det < 0.0f)
+			sx = -sx;
+
+		pose.scaling = Vector4(sx, sy, sz);
+
+		if (sx == 0.0f || sy == 0.0f || sz == 0.0f)
+			return pose;
+
+		// m(row, col) of the rotation, as Matrix4::Rotate lays it out.
+		float m00 = raw[0] / sx, m10 = raw[1] / sx, m20 = raw[2] / sx;
+		float m01 = raw[4] / sy, m11 = raw[5] / sy, m21 = raw[6] / sy;
+		float m02 = raw[8] / sz, m12 = raw[9] / sz, m22 = raw[10] / sz;
+
+		float trace = m00 + m11 + m22;
+		Quaternion q;
+		if (trace > 0.0f)
+		{
+			float s = 0.5f / std::sqrt(trace + 1.0f);
+			q = Quaternion((m21 - m12) * s, (m02 - m20) * s, (m10 - m01) * s, 0.25f / s);
+		}
+		else if (m00 > m11 && m00 > m22)
+		{
+			float s = 2.0f * std::sqrt(1.0f + m00 - m11 - m22);
+			q = Quaternion(0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s);
+		}
+		else if (m11 > m22)
+		{
+			float s = 2.0f * std::sqrt(1.0f + m11 - m00 - m22);
+			q = Quaternion((m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s);
+		}
+		else
+		{
+			float s = 2.0f * std::sqrt(1.0f + m22 - m00 - m11);
+			q = Quaternion((m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s);
+		}
+
+		q.Normalize();
+		pose.rotation = q;
+
+		return pose;
+	}
+
+	void Skeleton::Update(float ratio)
+	{
+		unsigned int count = m_Parents.size();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Matrix4 local = m_BindMatrices[i];
+			if (m_Posed[i])
+			{
+				const JointPose &from = m_OldPoses[i];
+				const JointPose &to = m_Poses[i];
+
+				local.Translate(from.position + (to.position - from.position) * ratio);
+				local.AppendRotation(from.rotation.Slerp(to.rotation, ratio));
+				local.AppendScale(from.scaling + (to.scaling - from.scaling) * ratio);
+			}
+
+			int parent = m_Parents[i];
+			m_CombinedMatrices[i] = parent < 0 ? local : m_CombinedMatrices[parent] * local;
+		}
+
+		for (unsigned int i = 0; i < m_PaletteJoints.size(); i++)
+		{
+			Matrix4 matrix = m_CombinedMatrices[m_PaletteJoints[i]] * m_OffsetMatrices[i];
+			std::copy(matrix.Raw, matrix.Raw + 16, &m_Palette[i * 16]);
+		}
+	}
+
+	Matrix4 Skeleton::GetCombinedMatrix(unsigned int index) const
+	{
+		return index < m_CombinedMatrices.size() ? m_CombinedMatrices[index] : Matrix4();
+	}
+
+	const float *Skeleton::GetPalette() const
+	{
+		return m_Palette.empty() ? nullptr : &m_Palette[0];
+	}
+
+	unsigned int Skeleton::GetPaletteSize() const
+	{
+		return m_PaletteJoints.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef _FURY_SKELETON_H_
+#define _FURY_SKELETON_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/Component.h"
+#include "Fury/Matrix4.h"
+#include "Fury/Quaternion.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	class Mesh;
+
+	struct PoseBuffer;
+
+	// Animated pose of one skinned mesh instance. The mesh's Joint tree only keeps the bind pose and
+	// offset matrices, each node animating it owns a Skeleton, so nodes sharing a mesh pose independently.
+	// Joints are flattened parent first, Update walks the arrays once to rebuild the skinning palette.
+	class FURY_API Skeleton : public Component
+	{
+		friend class AnimationSystem;
+
+	public:
+
+		typedef std::shared_ptr<Skeleton> Ptr;
+
+		static Ptr Create(const std::shared_ptr<Mesh> &mesh);
+
+		// local transform of a joint.
+		struct JointPose
+		{
+			Vector4 position;
+
+			Quaternion rotation;
+
+			Vector4 scaling = Vector4(1.0f, 1.0f, 1.0f);
+		};
+
+	protected:
+
+		std::weak_ptr<Mesh> m_Mesh;
+
+		// joint name hash to flat index.
+		std::unordered_map<size_t, unsigned int> m_JointMap;
+
+		// parent's flat index, -1 for root. parents come before their children.
+		std::vector<int> m_Parents;
+
+		// local matrix of joints without a pose.
+		std::vector<Matrix4> m_BindMatrices;
+
+		// bind matrices as poses, for blending joints a clip doesn't animate.
+		std::vector<JointPose> m_BindPoses;
+
+		// pose before and after last SetPose, Update interpolates between them.
+		std::vector<JointPose> m_OldPoses;
+
+		std::vector<JointPose> m_Poses;
+
+		// joints not posed yet keep their bind matrix.
+		std::vector<bool> m_Posed;
+
+		// joint to model space.
+		std::vector<Matrix4> m_CombinedMatrices;
+
+		// flat index and offset matrix of mesh's i-th skinning joint.
+		std::vector<unsigned int> m_PaletteJoints;
+
+		std::vector<Matrix4> m_OffsetMatrices;
+
+		// 4x4 float matrices for Shader::BindSkeleton, ordered as mesh's joints.
+		std::vector<float> m_Palette;
+
+		// slot in AnimationSystem's palette buffer, valid while generation matches the system's.
+		unsigned int m_PaletteSlot = 0;
+
+		unsigned int m_PaletteGeneration = 0;
+
+	public:
+
+		Skeleton(const std::shared_ptr<Mesh> &mesh);
+
+		virtual bool Load(const void* wrapper, bool object = true) override;
+
+		virtual void Save(void* wrapper, bool object = true) override;
+
+		Component::Ptr Clone() const override;
+
+		// rebuilds joint arrays from mesh's joint tree, poses reset to bind pose.
+		void SetMesh(const std::shared_ptr<Mesh> &mesh);
+
+		std::shared_ptr<Mesh> GetMesh() const;
+
+		// flat index of joint, -1 if not found.
+		int GetJointIndex(const std::string &name) const;
+
+		int GetJointIndex(size_t hashCode) const;
+
+		unsigned int GetJointCount() const;
+
+		// reset sets both poses, otherwise current pose becomes the old one.
+		void SetPose(unsigned int index, const JointPose &pose, bool reset);
+
+		// sets every joint from a blended pose buffer.
+		void SetPose(const PoseBuffer &pose, bool reset);
+
+		const JointPose &GetPose(unsigned int index) const;
+
+		// copies bind poses into pose, the usual start for blending.
+		void GetBindPose(PoseBuffer &pose) const;
+
+		// resizes mask to joint count and sets weight for joint and all its children, for layer masks.
+		void GetJointMask(const std::string &name, float weight, std::vector<float> &mask) const;
+
+		// ratio 0 - 1 interpolates old to current pose, then updates combined matrices and palette.
+		void Update(float ratio);
+
+		Matrix4 GetCombinedMatrix(unsigned int index) const;
+
+		const float *GetPalette() const;
+
+		// matrix count of palette.
+		unsigned int GetPaletteSize() const;
+
+	protected:
+
+		// translation, rotation and scale of a local matrix.
+		static JointPose DecomposeMatrix(const Matrix4 &matrix);
+	};
+}
+
+#endif // _FURY_SKELETON_H_
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Fury/BufferManager.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Log.h"
+#include "Fury/StreamBuffer.h"
+
+namespace fury
+{
+	unsigned int StreamBuffer::m_FrameIndex = 0;
+
+	size_t StreamBuffer::m_FrameCount = 0;
+
+	void* StreamBuffer::m_Fences[StreamBuffer::FRAME_COUNT] = {};
+
+	static void DeleteGLBuffer(unsigned int target, unsigned int id, char* mapped)
+	{
+		if (mapped != nullptr)
+		{
+			glBindBuffer(target, id);
+			glUnmapBuffer(target);
+			glBindBuffer(target, 0);
+		}
+
+		glDeleteBuffers(1, &id);
+	}
+
+	StreamBuffer::Ptr StreamBuffer::Create(const std::string &name, unsigned int bufferTarget, size_t frameSize)
+	{
+		return std::make_shared<StreamBuffer>(name, bufferTarget, frameSize);
+	}
+
+	void StreamBuffer::BeginFrame()
+	{
+		GLsync fence = (GLsync)m_Fences[m_FrameIndex];
+		if (fence == nullptr)
+			return;
+
+		// 1ms per try, flush on first try so the fence can signal at all.
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fence, flags, 1000000);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+
+			if (result == GL_WAIT_FAILED)
+			{
+				FURYW << "StreamBuffer fence wait failed!";
+				break;
+			}
+
+			flags = 0;
+		}
+
+		glDeleteSync(fence);
+		m_Fences[m_FrameIndex] = nullptr;
+	}
+
+	void StreamBuffer::EndFrame()
+	{
+		if (m_Fences[m_FrameIndex] != nullptr)
+			glDeleteSync((GLsync)m_Fences[m_FrameIndex]);
+
+		m_Fences[m_FrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_FrameIndex = (m_FrameIndex + 1) % FRAME_COUNT;
+		m_FrameCount++;
+	}
+
+	StreamBuffer::StreamBuffer(const std::string &name, unsigned int bufferTarget, size_t frameSize)
+		: m_Name(name), m_BufferTarget(bufferTarget), m_FrameSize(frameSize > 0 ? frameSize : 1)
+	{
+
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		DeleteBuffer();
+	}
+
+	void StreamBuffer::UpdateBuffer()
+	{
+		if (!m_Dirty)
+			return;
+
+		// an old buffer may still be read by this frame's draws.
+		RetireBuffer();
+
+		size_t totalSize = m_FrameSize * FRAME_COUNT;
+
+		glGenBuffers(1, &m_ID);
+		glBindBuffer(m_BufferTarget, m_ID);
+
+		if (glBufferStorage != nullptr)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(m_BufferTarget, totalSize, nullptr, flags);
+			m_Mapped = (char*)glMapBufferRange(m_BufferTarget, 0, totalSize, flags);
+
+			if (m_Mapped == nullptr)
+				FURYW << m_Name << " failed to map persistently, using glBufferSubData!";
+		}
+
+		// storage from glBufferStorage is immutable, so the fallback needs a new buffer.
+		if (m_Mapped == nullptr && glBufferStorage != nullptr)
+		{
+			glBindBuffer(m_BufferTarget, 0);
+			glDeleteBuffers(1, &m_ID);
+			glGenBuffers(1, &m_ID);
+			glBindBuffer(m_BufferTarget, m_ID);
+		}
+
+		if (m_Mapped == nullptr)
+			glBufferData(m_BufferTarget, totalSize, nullptr, GL_STREAM_DRAW);
+
+		glBindBuffer(m_BufferTarget, 0);
+
+		// offsets are bound with glBindBufferRange for these targets.
+		if (m_BufferTarget == GL_UNIFORM_BUFFER || m_BufferTarget == GL_SHADER_STORAGE_BUFFER)
+		{
+			int alignment = 1;
+			glGetIntegerv(m_BufferTarget == GL_UNIFORM_BUFFER ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT :
+				GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			m_MinAlignment = alignment > 0 ? alignment : 1;
+		}
+
+		m_Cursor = 0;
+		m_Dirty = false;
+
+		IncreaseMemory();
+	}
+
+	void StreamBuffer::DeleteBuffer()
+	{
+		m_Dirty = true;
+
+		if (m_ID != 0)
+		{
+			DecreaseMemory();
+
+			// gl keeps storage alive until draws still reading it are done.
+			DeleteGLBuffer(m_BufferTarget, m_ID, m_Mapped);
+			m_ID = 0;
+			m_Mapped = nullptr;
+		}
+
+		DeleteRetiredBuffers(true);
+	}
+
+	size_t StreamBuffer::Upload(const void* data, size_t size, size_t alignment)
+	{
+		if (m_CursorFrame != m_FrameCount)
+		{
+			m_CursorFrame = m_FrameCount;
+			m_Cursor = 0;
+
+			if (!m_RetiredBuffers.empty())
+				DeleteRetiredBuffers(false);
+		}
+
+		if (alignment < m_MinAlignment)
+			alignment = m_MinAlignment;
+
+		size_t cursor = (m_Cursor + alignment - 1) / alignment * alignment;
+
+		// region is full, grow to fit the rest of this frame, regions of the new buffer are all free.
+		// draws queued this frame may still use the old buffer, so it's only retired.
+		if (cursor + size > m_FrameSize)
+		{
+			RetireBuffer();
+			m_FrameSize = std::max(m_FrameSize * 2, cursor + size);
+			FURYD << m_Name << " grows to " << m_FrameSize << " bytes per frame.";
+		}
+
+		if (m_Dirty)
+		{
+			UpdateBuffer();
+			if (m_Dirty)
+				return 0;
+
+			// the new buffer has nothing from this frame.
+			cursor = 0;
+		}
+
+		size_t offset = m_FrameIndex * m_FrameSize + cursor;
+
+		if (m_Mapped != nullptr)
+		{
+			std::memcpy(m_Mapped + offset, data, size);
+		}
+		else
+		{
+			glBindBuffer(m_BufferTarget, m_ID);
+			glBufferSubData(m_BufferTarget, offset, size, data);
+			glBindBuffer(m_BufferTarget, 0);
+		}
+
+		m_Cursor = cursor + size;
+
+		return offset;
+	}
+
+	unsigned int StreamBuffer::GetID() const
+	{
+		return m_ID;
+	}
+
+	unsigned int StreamBuffer::GetBufferTarget() const
+	{
+		return m_BufferTarget;
+	}
+
+	size_t StreamBuffer::GetFrameSize() const
+	{
+		return m_FrameSize;
+	}
+
+	bool StreamBuffer::GetPersistent() const
+	{
+		return m_Mapped != nullptr;
+	}
+
+	void StreamBuffer::RetireBuffer()
+	{
+		m_Dirty = true;
+
+		if (m_ID != 0)
+		{
+			m_RetiredBuffers.push_back({ m_ID, m_Mapped, m_FrameSize * FRAME_COUNT, m_FrameCount });
+			m_ID = 0;
+			m_Mapped = nullptr;
+		}
+	}
+
+	void StreamBuffer::DeleteRetiredBuffers(bool all)
+	{
+		// BeginFrame of frame + FRAME_COUNT waited on the fence placed after the buffer's last frame.
+		auto last = std::remove_if(m_RetiredBuffers.begin(), m_RetiredBuffers.end(), [&](const RetiredBuffer &buffer)
+		{
+			if (!all && m_FrameCount < buffer.frame + FRAME_COUNT)
+				return false;
+
+			BufferManager::Instance()->DecreaseMemory(buffer.size);
+			DeleteGLBuffer(m_BufferTarget, buffer.id, buffer.mapped);
+			return true;
+		});
+
+		m_RetiredBuffers.erase(last, m_RetiredBuffers.end());
+	}
+
+	void StreamBuffer::IncreaseMemory()
+	{
+		BufferManager::Instance()->IncreaseMemory(m_FrameSize * FRAME_COUNT);
+	}
+
+	void StreamBuffer::DecreaseMemory()
+	{
+		BufferManager::Instance()->DecreaseMemory(m_FrameSize * FRAME_COUNT);
+	}
+}
\ No newline at end of file
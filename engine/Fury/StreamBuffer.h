@@ -0,0 +1,118 @@
+#ifndef _FURY_STREAM_BUFFER_H_
+#define _FURY_STREAM_BUFFER_H_
+
+#include <string>
+#include <vector>
+
+#include "Fury/Buffer.h"
+
+namespace fury
+{
+	// Ring buffer for data rewritten every frame, like instance matrices, debug lines and skinning palettes.
+	// Storage is split into FRAME_COUNT regions and each frame only writes it's own region, a fence placed
+	// at EndFrame keeps cpu from overwriting a region gpu may still be reading, so we never wait on orphaning.
+	// Storage is persistently mapped when glBufferStorage is available, otherwise uploads use glBufferSubData.
+	class FURY_API StreamBuffer : public Buffer
+	{
+	public:
+
+		typedef std::shared_ptr<StreamBuffer> Ptr;
+
+		static const unsigned int FRAME_COUNT = 3;
+
+		static Ptr Create(const std::string &name, unsigned int bufferTarget, size_t frameSize);
+
+		// waits until gpu is done with the region this frame writes, call before any Upload.
+		// RenderUtil::BeginFrame calls this.
+		static void BeginFrame();
+
+		// fences this frame's region, call after the last draw reading stream data.
+		// RenderUtil::EndFrame calls this.
+		static void EndFrame();
+
+	protected:
+
+		// region written this frame.
+		static unsigned int m_FrameIndex;
+
+		// frames ended since startup.
+		static size_t m_FrameCount;
+
+		// GLsync of each region, nullptr if there's nothing to wait for.
+		static void* m_Fences[FRAME_COUNT];
+
+		std::string m_Name;
+
+		unsigned int m_ID = 0;
+
+		unsigned int m_BufferTarget;
+
+		// size of one region in bytes.
+		size_t m_FrameSize;
+
+		// write position in current region.
+		size_t m_Cursor = 0;
+
+		// m_FrameCount when m_Cursor was reset.
+		size_t m_CursorFrame = 0;
+
+		size_t m_MinAlignment = 1;
+
+		// persistently mapped storage, nullptr when using the glBufferSubData fallback.
+		char* m_Mapped = nullptr;
+
+		// buffers replaced by growing, offsets handed out before the growth still point into them.
+		struct RetiredBuffer
+		{
+			unsigned int id;
+
+			char* mapped;
+
+			size_t size;
+
+			// m_FrameCount when it was replaced.
+			size_t frame;
+		};
+
+		std::vector<RetiredBuffer> m_RetiredBuffers;
+
+	public:
+
+		StreamBuffer(const std::string &name, unsigned int bufferTarget, size_t frameSize);
+
+		virtual ~StreamBuffer();
+
+		// allocates storage, Upload calls this when buffer is dirty.
+		virtual void UpdateBuffer();
+
+		virtual void DeleteBuffer();
+
+		// copies data into this frame's region, returns byte offset of the copy in GetID() buffer.
+		// a full region grows by replacing the gl buffer, so query GetID() after Upload.
+		// the replaced buffer stays alive until it's last frame is fenced and waited on,
+		// so ids and offsets returned earlier in the frame stay valid.
+		size_t Upload(const void* data, size_t size, size_t alignment = 4);
+
+		unsigned int GetID() const;
+
+		unsigned int GetBufferTarget() const;
+
+		size_t GetFrameSize() const;
+
+		bool GetPersistent() const;
+
+	protected:
+
+		// moves current buffer to m_RetiredBuffers, the next Upload allocates a new one.
+		void RetireBuffer();
+
+		// deletes retired buffers gpu is done with, or all of them.
+		void DeleteRetiredBuffers(bool all);
+
+		void IncreaseMemory();
+
+		void DecreaseMemory();
+	};
+}
+
+#endif // _FURY_STREAM_BUFFER_H_
\ No newline at end of file
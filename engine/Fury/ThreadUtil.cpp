@@ -1,141 +1,422 @@
-#include <stack>
-#include <list>
-
-#include "Fury/Log.h"
-#include "Fury/ThreadUtil.h"
-
-namespace fury
-{
-	std::thread::id ThreadUtil::m_MainThreadId;
-
-	size_t ThreadUtil::m_TaskKey = 0;
-
-	ThreadUtil::ThreadUtil(unsigned int numThreads)
-		: m_Stop(false)
-	{
-		unsigned int maxThreads = std::thread::hardware_concurrency();
-		if (numThreads > maxThreads)
-		{
-			numThreads = maxThreads / 2;
-			FURYW << "Hardware supports " << maxThreads << " threads at most!";
-		}
-
-		for (unsigned int i = 0; i < numThreads; i++)
-		{
-			m_Workers.emplace_back([this]
-			{
-				while (true)
-				{
-					std::function<void()> task;
-
-					{
-						std::unique_lock<std::mutex> lock(this->m_QueueMutex);
-						this->m_Condiction.wait(lock, [this]
-						{
-							return this->m_Stop || !this->m_Tasks.empty();
-						});
-
-						if (this->m_Stop && this->m_Tasks.empty())
-							return;
-
-						task = std::move(this->m_Tasks.front());
-						this->m_Tasks.pop();
-					}
-
-					task();
-				}
-			});
-		}
-	}
-
-	ThreadUtil::~ThreadUtil()
-	{
-		{
-			std::unique_lock<std::mutex> lock(m_QueueMutex);
-			m_Stop = true;
-			m_TaskStates.clear();
-		}
-
-		m_Condiction.notify_all();
-		for (std::thread &worker : m_Workers)
-			worker.join();
-	}
-
-	size_t ThreadUtil::Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged)
-	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-		// don't allow enqueueing after stopping the pool
-		if (m_Stop)
-			throw std::runtime_error("Enqueue on stopped ThreadPool");
-
-		size_t key = m_TaskKey++;
-		auto state = std::make_shared<TaskState>(key, nullptr);
-		state->callback = callback;
-		state->progressChanged = progressChanged;
-
-		m_Tasks.emplace([task, state]()
-		{
-			task(state->progress);
-			state->finished = true;
-		});
-
-		m_TaskStates.emplace(key, state);
-		m_Condiction.notify_one();
-		return key;
-	}
-
-	void ThreadUtil::Update()
-	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-		std::list<size_t> finishedTasks;
-		for (auto &pair : m_TaskStates)
-		{
-			auto id = pair.first;
-			auto &state = pair.second;
-
-			if (state->progressChanged)
-			{
-				auto it = m_TaskProgresses.find(id);
-				if (it == m_TaskProgresses.end())
-				{
-					m_TaskProgresses.emplace(id, state->progress);
-					state->progressChanged(state->progress);
-				}
-				else if (it->second != state->progress)
-				{
-					m_TaskProgresses[id] = state->progress;
-					state->progressChanged(state->progress);
-				}
-			}
-
-			if (state->finished)
-				finishedTasks.emplace_back(id);
-		}
-
-		for (auto &id : finishedTasks)
-		{
-			auto state = m_TaskStates[id];
-			m_TaskStates.erase(id);
-			m_TaskProgresses.erase(id);
-			if (state->callback)
-				state->callback();
-		}
-	}
-
-	size_t ThreadUtil::GetWorkerCount()
-	{
-		return m_Workers.size();
-	}
-
-	void ThreadUtil::SetMainThread()
-	{
-		m_MainThreadId = std::this_thread::get_id();
-	}
-
-	bool ThreadUtil::IsMainThread()
-	{
-		return std::this_thread::get_id() == m_MainThreadId;
-	}
-}
\ No newline at end of file
+#include <list>
+#include <algorithm>
+
+#include "Fury/Log.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	std::thread::id ThreadUtil::m_MainThreadId;
+
+	size_t ThreadUtil::m_TaskKey = 0;
+
+	static thread_local unsigned int s_ThreadIndex = 0;
+
+	ThreadUtil::ThreadUtil(unsigned int numThreads)
+		: m_JobIndex(0), m_PendingJobs(0), m_SleepingWorkers(0), m_Stop(false)
+	{
+		unsigned int maxThreads = std::thread::hardware_concurrency();
+		if (numThreads > maxThreads)
+		{
+			numThreads = maxThreads / 2;
+			FURYW << "Hardware supports " << maxThreads << " threads at most!";
+		}
+
+		m_JobPool.reset(new Job[MAX_JOB_COUNT]);
+
+		for (unsigned int i = 0; i <= numThreads; i++)
+			m_Queues.emplace_back(new JobQueue());
+
+		for (unsigned int i = 0; i < numThreads; i++)
+			m_Workers.emplace_back(&ThreadUtil::WorkerLoop, this, i + 1);
+	}
+
+	ThreadUtil::~ThreadUtil()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_Stop = true;
+		}
+
+		m_Condiction.notify_all();
+		for (std::thread &worker : m_Workers)
+			worker.join();
+
+		std::unique_lock<std::mutex> lock(m_StateMutex);
+		m_TaskStates.clear();
+	}
+
+	ThreadUtil::Job *ThreadUtil::CreateJob(std::function<void()> function)
+	{
+		auto job = AllocateJob();
+		job->m_Function = std::move(function);
+		job->m_Parent = nullptr;
+		return job;
+	}
+
+	ThreadUtil::Job *ThreadUtil::CreateChildJob(Job *parent, std::function<void()> function)
+	{
+		ASSERT_MSG(parent != nullptr, "Parent job can't be null!");
+
+		parent->m_Unfinished++;
+
+		auto job = AllocateJob();
+		job->m_Function = std::move(function);
+		job->m_Parent = parent;
+		return job;
+	}
+
+	void ThreadUtil::Run(Job *job)
+	{
+		// don't allow running jobs after stopping the pool
+		if (m_Stop)
+			throw std::runtime_error("Run on stopped ThreadPool");
+
+		Push(*m_Queues[s_ThreadIndex < m_Queues.size() ? s_ThreadIndex : 0], job);
+	}
+
+	void ThreadUtil::RunBackground(Job *job)
+	{
+		if (m_Stop)
+			throw std::runtime_error("Run on stopped ThreadPool");
+
+		Push(m_BackgroundQueue, job);
+	}
+
+	void ThreadUtil::Push(JobQueue &queue, Job *job)
+	{
+		{
+			std::unique_lock<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back(job);
+		}
+
+		// only the first pending job wakes a worker, that worker wakes the next one if there is more work.
+		// waking on every push costs a mutex and a notify per job while workers are still getting scheduled.
+		if (m_PendingJobs++ == 0 && m_SleepingWorkers > 0)
+			WakeWorker();
+	}
+
+	void ThreadUtil::WakeWorker()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+		}
+		m_Condiction.notify_one();
+	}
+
+	void ThreadUtil::WaitFor(Job *job)
+	{
+		while (!job->IsFinished())
+		{
+			if (auto next = GetJob())
+				Execute(next);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void ThreadUtil::ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &fn)
+	{
+		if (end <= begin)
+			return;
+
+		if (RunsInline(end - begin, grain))
+		{
+			fn(begin, end);
+			return;
+		}
+
+		auto &instance = Instance();
+		instance->ParallelChunks(begin, end, instance->GetChunkSize(end - begin, grain), [&fn](size_t index, size_t chunkBegin, size_t chunkEnd)
+		{
+			fn(chunkBegin, chunkEnd);
+		});
+	}
+
+	void ThreadUtil::SetMinGrainSize(size_t grain)
+	{
+		m_MinGrainSize = grain > 0 ? grain : 1;
+	}
+
+	size_t ThreadUtil::GetMinGrainSize()
+	{
+		return m_MinGrainSize;
+	}
+
+	size_t ThreadUtil::Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged)
+	{
+		auto state = CreateTaskState(progressChanged);
+		state->callback = callback;
+
+		auto job = CreateJob([task, state]()
+		{
+			task(state->progress);
+			state->finished = true;
+		});
+
+		RunBackground(job);
+		return state->id;
+	}
+
+	void ThreadUtil::Update()
+	{
+		if (m_Workers.empty())
+		{
+			while (auto job = GetJob(true))
+				Execute(job);
+		}
+
+		std::list<std::shared_ptr<TaskState>> finishedTasks;
+		std::vector<std::pair<std::function<void(int)>, int>> progresses;
+
+		{
+			std::unique_lock<std::mutex> lock(m_StateMutex);
+
+			for (auto &pair : m_TaskStates)
+			{
+				auto id = pair.first;
+				auto &state = pair.second;
+
+				if (state->progressChanged)
+				{
+					auto it = m_TaskProgresses.find(id);
+					int progress = state->progress;
+					if (it == m_TaskProgresses.end())
+					{
+						m_TaskProgresses.emplace(id, progress);
+						progresses.emplace_back(state->progressChanged, progress);
+					}
+					else if (it->second != progress)
+					{
+						it->second = progress;
+						progresses.emplace_back(state->progressChanged, progress);
+					}
+				}
+
+				if (state->finished)
+					finishedTasks.emplace_back(state);
+			}
+
+			for (auto &state : finishedTasks)
+			{
+				m_TaskStates.erase(state->id);
+				m_TaskProgresses.erase(state->id);
+			}
+		}
+
+		// callbacks might enqueue new tasks, so call them without holding the lock.
+		for (auto &pair : progresses)
+			pair.first(pair.second);
+
+		for (auto &state : finishedTasks)
+		{
+			if (state->callback)
+				state->callback();
+		}
+	}
+
+	size_t ThreadUtil::GetWorkerCount()
+	{
+		return m_Workers.size();
+	}
+
+	unsigned int ThreadUtil::GetThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+	void ThreadUtil::SetMainThread()
+	{
+		m_MainThreadId = std::this_thread::get_id();
+	}
+
+	bool ThreadUtil::IsMainThread()
+	{
+		return std::this_thread::get_id() == m_MainThreadId;
+	}
+
+	std::shared_ptr<ThreadUtil::TaskState> ThreadUtil::CreateTaskState(std::function<void(int)> progressChanged)
+	{
+		std::unique_lock<std::mutex> lock(m_StateMutex);
+
+		// don't allow enqueueing after stopping the pool
+		if (m_Stop)
+			throw std::runtime_error("Enqueue on stopped ThreadPool");
+
+		size_t key = m_TaskKey++;
+		auto state = std::make_shared<TaskState>(key, nullptr);
+		state->progressChanged = progressChanged;
+
+		m_TaskStates.emplace(key, state);
+		return state;
+	}
+
+	ThreadUtil::Job *ThreadUtil::AllocateJob()
+	{
+		// skip slots that are still in use, long running tasks can hold a slot for many frames.
+		size_t tries = 0;
+		while (true)
+		{
+			auto job = &m_JobPool[m_JobIndex++ & (MAX_JOB_COUNT - 1)];
+			int expected = 0;
+			if (job->m_Unfinished.compare_exchange_strong(expected, 1))
+				return job;
+
+			// pool is exhausted, help finishing some jobs.
+			if (++tries % MAX_JOB_COUNT == 0)
+			{
+				if (auto next = GetJob())
+					Execute(next);
+				else
+					std::this_thread::yield();
+			}
+		}
+	}
+
+	ThreadUtil::Job *ThreadUtil::GetJob(bool background)
+	{
+		unsigned int count = m_Queues.size();
+		unsigned int index = s_ThreadIndex < count ? s_ThreadIndex : 0;
+
+		// pop from own queue, newest first.
+		{
+			auto &queue = m_Queues[index];
+			std::unique_lock<std::mutex> lock(queue->mutex);
+			if (!queue->jobs.empty())
+			{
+				auto job = queue->jobs.back();
+				queue->jobs.pop_back();
+				m_PendingJobs--;
+				return job;
+			}
+		}
+
+		// steal from others, oldest first.
+		for (unsigned int i = 1; i < count; i++)
+		{
+			auto &queue = m_Queues[(index + i) % count];
+			std::unique_lock<std::mutex> lock(queue->mutex, std::try_to_lock);
+			if (lock.owns_lock() && !queue->jobs.empty())
+			{
+				auto job = queue->jobs.front();
+				queue->jobs.pop_front();
+				m_PendingJobs--;
+				return job;
+			}
+		}
+
+		if (background)
+		{
+			std::unique_lock<std::mutex> lock(m_BackgroundQueue.mutex);
+			if (!m_BackgroundQueue.jobs.empty())
+			{
+				auto job = m_BackgroundQueue.jobs.front();
+				m_BackgroundQueue.jobs.pop_front();
+				m_PendingJobs--;
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void ThreadUtil::Execute(Job *job)
+	{
+		if (job->m_Function)
+		{
+			job->m_Function();
+			// release captured resources while we still own the slot.
+			job->m_Function = nullptr;
+		}
+		Finish(job);
+	}
+
+	void ThreadUtil::Finish(Job *job)
+	{
+		auto parent = job->m_Parent;
+		if (--job->m_Unfinished == 0 && parent != nullptr)
+			Finish(parent);
+	}
+
+	bool ThreadUtil::RunsInline(size_t count, size_t grain)
+	{
+		if (!HasInstance())
+			return true;
+
+		// a worker waiting on nested chunks would only add scheduling overhead, it's siblings already keep the pool busy.
+		auto &instance = Instance();
+		if (instance->m_Workers.size() == 0 || s_ThreadIndex != 0)
+			return true;
+
+		return count <= std::max(grain, instance->m_MinGrainSize);
+	}
+
+	size_t ThreadUtil::GetChunkSize(size_t count, size_t grain)
+	{
+		grain = std::max(grain, m_MinGrainSize);
+
+		// a few chunks per thread, so stealing can balance uneven chunks.
+		size_t threadCount = m_Workers.size() + 1;
+		size_t chunkSize = count / (threadCount * 4);
+
+		return std::max(chunkSize, grain);
+	}
+
+	void ThreadUtil::ParallelChunks(size_t begin, size_t end, size_t chunkSize, const std::function<void(size_t, size_t, size_t)> &fn)
+	{
+		size_t chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+
+		auto root = CreateJob(nullptr);
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			size_t chunkBegin = begin + i * chunkSize;
+			size_t chunkEnd = std::min(chunkBegin + chunkSize, end);
+			Run(CreateChildJob(root, [&fn, i, chunkBegin, chunkEnd]()
+			{
+				fn(i, chunkBegin, chunkEnd);
+			}));
+		}
+
+		// root has no work itself, release it and help until children are done.
+		Execute(root);
+		WaitFor(root);
+	}
+
+	void ThreadUtil::WorkerLoop(unsigned int index)
+	{
+		s_ThreadIndex = index;
+
+		unsigned int idleSpins = 0;
+		while (true)
+		{
+			if (auto job = GetJob(true))
+			{
+				if (m_PendingJobs > 0 && m_SleepingWorkers > 0)
+					WakeWorker();
+
+				Execute(job);
+				idleSpins = 0;
+				continue;
+			}
+
+			// jobs usually come in bursts, sleeping as soon as the queues run dry means
+			// a condition variable round trip for almost every job of the next burst.
+			if (idleSpins++ < IDLE_SPIN_COUNT)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_SleepingWorkers++;
+			m_Condiction.wait(lock, [this]
+			{
+				return m_Stop || m_PendingJobs > 0;
+			});
+			m_SleepingWorkers--;
+
+			if (m_Stop && m_PendingJobs <= 0)
+				return;
+		}
+	}
+}
@@ -1,112 +1,246 @@
-#ifndef _FURY_THREAD_UTIL_H_
-#define _FURY_THREAD_UTIL_H_
-
-// Implimentation refers to: https://github.com/progschj/ThreadPool
-
-#include <vector>
-#include <queue>
-#include <memory>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
-#include <unordered_map>
-
-#include "Fury/Singleton.h"
-
-namespace fury
-{
-	class FURY_API ThreadUtil : public Singleton<ThreadUtil, size_t>
-	{
-	public:
-
-		typedef std::shared_ptr<ThreadUtil> Ptr;
-
-	protected:
-
-		class TaskState
-		{
-		public:
-
-			size_t id = 0;
-
-			int progress = 0;
-
-			bool finished = false;
-
-			std::shared_ptr<void> data;
-
-			std::function<void()> callback;
-
-			std::function<void(int)> progressChanged;
-
-			TaskState(size_t id, std::shared_ptr<void> data)
-				: id(id), data(data) {}
-		};
-
-		static std::thread::id m_MainThreadId;
-
-		static size_t m_TaskKey;
-
-		std::unordered_map<size_t, std::shared_ptr<TaskState>> m_TaskStates;
-
-		std::unordered_map<size_t, int> m_TaskProgresses;
-
-		std::queue<std::function<void()>> m_Tasks;
-
-		std::vector<std::thread> m_Workers;
-
-		std::mutex m_QueueMutex;
-
-		std::condition_variable m_Condiction;
-
-		bool m_Stop;
-
-	public:
-
-		ThreadUtil(unsigned int numThreads);
-
-		~ThreadUtil();
-		
-		size_t Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged = nullptr);
-
-		template<class ReturnType>
-		size_t Enqueue(std::function<std::shared_ptr<ReturnType>(int&)> task, std::function<void(std::shared_ptr<ReturnType>)> callback, 
-			std::function<void(int)> progressChanged = nullptr)
-		{
-			std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-			// don't allow enqueueing after stopping the pool
-			if (m_Stop)
-				throw std::runtime_error("Enqueue on stopped ThreadPool");
-
-			size_t key = m_TaskKey++;
-			auto state = std::make_shared<TaskState>(key, nullptr);
-			state->callback = [callback, state]
-			{
-				callback(std::static_pointer_cast<ReturnType>(state->data));
-			};
-			state->progressChanged = progressChanged;
-
-			m_Tasks.emplace([task, state]()
-			{
-				state->data = task(state->progress);
-				state->finished = true;
-			});
-
-			m_TaskStates.emplace(key, state);
-			m_Condiction.notify_one();
-			return key;
-		}
-
-		void Update();
-
-		size_t GetWorkerCount();
-
-		void SetMainThread();
-
-		bool IsMainThread();
-	};
-}
-
-#endif // _FURY_THREAD_UTIL_H_
\ No newline at end of file
+#ifndef _FURY_THREAD_UTIL_H_
+#define _FURY_THREAD_UTIL_H_
+
+// Job system uses per-worker deques with work stealing.
+// Owner thread pushes and pops at the back, idle threads steal from the front.
+// Enqueue/Update callback api is a thin layer on top of it, it's tasks go to a separate queue only idle workers take,
+// so WaitFor never runs a long background task inline.
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class FURY_API ThreadUtil : public Singleton<ThreadUtil, size_t>
+	{
+	public:
+
+		typedef std::shared_ptr<ThreadUtil> Ptr;
+
+		// job slots come from a fixed size pool, but the function is a std::function,
+		// so captures that don't fit it's small buffer are still heap allocated per job.
+		// a job is finished when itself and all its child jobs are finished.
+		class Job
+		{
+			friend class ThreadUtil;
+
+		private:
+
+			std::function<void()> m_Function;
+
+			Job *m_Parent = nullptr;
+
+			std::atomic<int> m_Unfinished;
+
+		public:
+
+			Job() : m_Unfinished(0) {}
+
+			bool IsFinished() const
+			{
+				return m_Unfinished.load() == 0;
+			}
+		};
+
+		// size of job pool, must be power of 2.
+		static const size_t MAX_JOB_COUNT = 4096;
+
+		// times an idle worker yields and looks for jobs again before it goes to sleep.
+		static const unsigned int IDLE_SPIN_COUNT = 64;
+
+	protected:
+
+		class JobQueue
+		{
+		public:
+
+			std::deque<Job*> jobs;
+
+			std::mutex mutex;
+		};
+
+		class TaskState
+		{
+		public:
+
+			size_t id = 0;
+
+			int progress = 0;
+
+			std::atomic<bool> finished;
+
+			std::shared_ptr<void> data;
+
+			std::function<void()> callback;
+
+			std::function<void(int)> progressChanged;
+
+			TaskState(size_t id, std::shared_ptr<void> data)
+				: id(id), finished(false), data(data) {}
+		};
+
+		static std::thread::id m_MainThreadId;
+
+		static size_t m_TaskKey;
+
+		std::unordered_map<size_t, std::shared_ptr<TaskState>> m_TaskStates;
+
+		std::unordered_map<size_t, int> m_TaskProgresses;
+
+		std::mutex m_StateMutex;
+
+		std::unique_ptr<Job[]> m_JobPool;
+
+		std::atomic<size_t> m_JobIndex;
+
+		// queue 0 is shared by main thread and other non-worker threads.
+		std::vector<std::unique_ptr<JobQueue>> m_Queues;
+
+		// Enqueue tasks, oldest first.
+		JobQueue m_BackgroundQueue;
+
+		std::vector<std::thread> m_Workers;
+
+		std::atomic<int> m_PendingJobs;
+
+		std::atomic<int> m_SleepingWorkers;
+
+		std::mutex m_WakeMutex;
+
+		std::condition_variable m_Condiction;
+
+		std::atomic<bool> m_Stop;
+
+		size_t m_MinGrainSize = 1;
+
+	public:
+
+		ThreadUtil(unsigned int numThreads);
+
+		~ThreadUtil();
+
+		// create a job, call Run to schedule it.
+		Job *CreateJob(std::function<void()> function);
+
+		// parent job won't finish until this child job is finished.
+		// child must be created before parent is scheduled or from inside parent's function.
+		Job *CreateChildJob(Job *parent, std::function<void()> function);
+
+		void Run(Job *job);
+
+		// executes other pending jobs while waiting, so it won't block a worker.
+		void WaitFor(Job *job);
+
+		size_t Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged = nullptr);
+
+		template<class ReturnType>
+		size_t Enqueue(std::function<std::shared_ptr<ReturnType>(int&)> task, std::function<void(std::shared_ptr<ReturnType>)> callback,
+			std::function<void(int)> progressChanged = nullptr)
+		{
+			auto state = CreateTaskState(progressChanged);
+			state->callback = [callback, state]
+			{
+				callback(std::static_pointer_cast<ReturnType>(state->data));
+			};
+
+			auto job = CreateJob([task, state]()
+			{
+				state->data = task(state->progress);
+				state->finished = true;
+			});
+
+			RunBackground(job);
+			return state->id;
+		}
+
+		// splits [begin, end) into chunks of at least grain items and calls fn(chunkBegin, chunkEnd) in parallel.
+		// calling thread helps executing chunks, returns after all chunks are done.
+		// fn(begin, end) runs inline when there is no ThreadUtil instance or no workers, the range fits in one chunk,
+		// or the caller is a worker, so callers don't need to check any of these.
+		static void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &fn);
+
+		// map(chunkBegin, chunkEnd, identity) computes each chunk's partial result,
+		// partial results are then combined by reduce in chunk order, so the result is deterministic.
+		// runs map(begin, end, identity) inline in the same cases as ParallelFor.
+		template<class ValueType, class MapFunc, class ReduceFunc>
+		static ValueType ParallelReduce(size_t begin, size_t end, size_t grain, ValueType identity, MapFunc map, ReduceFunc reduce)
+		{
+			if (end <= begin)
+				return identity;
+
+			if (RunsInline(end - begin, grain))
+				return map(begin, end, identity);
+
+			auto &instance = Instance();
+			size_t chunkSize = instance->GetChunkSize(end - begin, grain);
+			size_t chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+
+			std::vector<ValueType> partials(chunkCount, identity);
+			instance->ParallelChunks(begin, end, chunkSize, [&](size_t index, size_t chunkBegin, size_t chunkEnd)
+			{
+				partials[index] = map(chunkBegin, chunkEnd, identity);
+			});
+
+			ValueType result = identity;
+			for (auto &partial : partials)
+				result = reduce(result, partial);
+			return result;
+		}
+
+		// chunks will never be smaller than this, whatever grain is passed to ParallelFor/ParallelReduce.
+		void SetMinGrainSize(size_t grain);
+
+		size_t GetMinGrainSize();
+
+		// calls progress and finish callbacks of Enqueue tasks, without workers it runs the queued tasks first.
+		void Update();
+
+		size_t GetWorkerCount();
+
+		// 0 for main or non-worker threads, 1 ~ GetWorkerCount() for workers.
+		static unsigned int GetThreadIndex();
+
+		void SetMainThread();
+
+		bool IsMainThread();
+
+	protected:
+
+		std::shared_ptr<TaskState> CreateTaskState(std::function<void(int)> progressChanged);
+
+		Job *AllocateJob();
+
+		// background also takes Enqueue tasks, only idle workers pass true.
+		Job *GetJob(bool background = false);
+
+		void RunBackground(Job *job);
+
+		void Push(JobQueue &queue, Job *job);
+
+		void WakeWorker();
+
+		void Execute(Job *job);
+
+		void Finish(Job *job);
+
+		void WorkerLoop(unsigned int index);
+
+		// true if count items should be processed by the caller itself.
+		static bool RunsInline(size_t count, size_t grain);
+
+		size_t GetChunkSize(size_t count, size_t grain);
+
+		void ParallelChunks(size_t begin, size_t end, size_t chunkSize, const std::function<void(size_t, size_t, size_t)> &fn);
+	};
+}
+
+#endif // _FURY_THREAD_UTIL_H_
@@ -0,0 +1,137 @@
+#include <unordered_map>
+
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+#include "Fury/TransformManager.h"
+#include "Fury/TransformStore.h"
+
+namespace fury
+{
+	void TransformManager::Recompose(const std::vector<std::shared_ptr<SceneNode>> &roots)
+	{
+		// flatten hierarchies level by level.
+		std::vector<SceneNode*> nodes;
+		std::vector<size_t> levels;
+
+		for (auto &root : roots)
+			nodes.push_back(root.get());
+
+		size_t levelBegin = 0;
+		while (levelBegin < nodes.size())
+		{
+			size_t levelEnd = nodes.size();
+			levels.push_back(levelEnd);
+
+			for (size_t i = levelBegin; i < levelEnd; i++)
+			{
+				for (auto &child : nodes[i]->m_Childs)
+					nodes.push_back(child.get());
+			}
+
+			levelBegin = levelEnd;
+		}
+
+		// nodes in the same level are independent, so each level can be updated in parallel.
+		// each node owns it's slot in the store, so workers can write it too.
+		TransformStore *store = TransformStore::HasInstance() ? TransformStore::Instance().get() : nullptr;
+		std::vector<char> aabbChanged(nodes.size(), 0);
+		auto UpdateRange = [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				SceneNode *node = nodes[i];
+				aabbChanged[i] = node->UpdateTransform() ? 1 : 0;
+
+				if (store != nullptr && node->m_TransformHandle != TransformStore::INVALID_HANDLE)
+				{
+					store->SetLocalTransform(node->m_TransformHandle, node->m_LocalPosition, node->m_LocalRotation, node->m_LocalScale);
+					store->SetWorldMatrix(node->m_TransformHandle, node->m_WorldMatrix);
+					store->SetWorldAABB(node->m_TransformHandle, node->m_WorldAABB);
+				}
+			}
+		};
+
+		levelBegin = 0;
+		for (auto levelEnd : levels)
+		{
+			ThreadUtil::ParallelFor(levelBegin, levelEnd, 64, UpdateRange);
+			levelBegin = levelEnd;
+		}
+
+		// batch octree updates, only nodes whose world aabb changed need to move.
+		std::unordered_map<SceneManager*, SceneManager::SceneNodes> updates;
+		std::vector<SceneNode::Ptr> ptrs;
+		ptrs.reserve(nodes.size());
+
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			auto node = nodes[i];
+			ptrs.push_back(node->shared_from_this());
+
+			if (aabbChanged[i])
+			{
+				if (SceneManager *manager = node->GetSceneManager())
+					updates[manager].push_back(ptrs.back());
+			}
+		}
+
+		for (auto &pair : updates)
+			pair.first->UpdateSceneNodes(pair.second);
+
+		// trigger events
+		for (auto &ptr : ptrs)
+			ptr->OnTransformChange->Emit(ptr);
+	}
+
+	void TransformManager::AddDirtyNode(const std::shared_ptr<SceneNode> &node)
+	{
+		node->m_TransformQueued = true;
+		m_DirtyNodes.push_back(node);
+	}
+
+	void TransformManager::Update()
+	{
+		if (m_DirtyNodes.empty())
+			return;
+
+		// nodes dirtied by OnTransformChange callbacks are handled next frame.
+		std::vector<std::weak_ptr<SceneNode>> dirtyNodes;
+		dirtyNodes.swap(m_DirtyNodes);
+
+		std::vector<SceneNode::Ptr> roots;
+		for (auto &weak : dirtyNodes)
+		{
+			auto node = weak.lock();
+			if (node == nullptr || !node->m_TransformDirty)
+				continue;
+
+			// skip nodes that will be forced by a dirty ancestor.
+			bool hasDirtyAncestor = false;
+			for (auto parent = node->GetParent(); parent != nullptr; parent = parent->GetParent())
+			{
+				if (parent->m_TransformQueued && parent->m_TransformDirty)
+				{
+					hasDirtyAncestor = true;
+					break;
+				}
+			}
+
+			if (!hasDirtyAncestor)
+				roots.push_back(node);
+		}
+
+		for (auto &weak : dirtyNodes)
+		{
+			if (auto node = weak.lock())
+				node->m_TransformQueued = false;
+		}
+
+		Recompose(roots);
+	}
+
+	size_t TransformManager::GetDirtyNodeCount() const
+	{
+		return m_DirtyNodes.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef _FURY_TRANSFORM_MANAGER_H_
+#define _FURY_TRANSFORM_MANAGER_H_
+
+#include <vector>
+#include <memory>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class SceneNode;
+
+	// Collects dirty scene nodes and updates them once per frame.
+	// World matrices are updated breadth-first in a flat pass,
+	// octree updates and OnTransformChange signals are batched at the end.
+	class FURY_API TransformManager : public Singleton<TransformManager>
+	{
+	public:
+
+		typedef std::shared_ptr<TransformManager> Ptr;
+
+		// update given hierarchies in one batch, parents are always updated before their childs.
+		// roots should not be descendants of each other.
+		static void Recompose(const std::vector<std::shared_ptr<SceneNode>> &roots);
+
+	protected:
+
+		std::vector<std::weak_ptr<SceneNode>> m_DirtyNodes;
+
+	public:
+
+		// called by SceneNode when it's transform becomes dirty.
+		void AddDirtyNode(const std::shared_ptr<SceneNode> &node);
+
+		// recompose all dirty hierarchies, Engine::Update calls this each frame.
+		void Update();
+
+		size_t GetDirtyNodeCount() const;
+	};
+}
+
+#endif // _FURY_TRANSFORM_MANAGER_H_
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Frustum.h"
+#include "Fury/Log.h"
+#include "Fury/Quaternion.h"
+#include "Fury/SceneNode.h"
+#include "Fury/TransformStore.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	// aabbs culled per batch, so the visible mask fits on the stack.
+	static const unsigned int CULL_BATCH_SIZE = 256;
+
+	const TransformStore::Handle TransformStore::INVALID_HANDLE;
+
+	TransformStore::Handle TransformStore::Allocate(SceneNode *sceneNode)
+	{
+		Handle handle;
+		if (m_FreeHandles.size() > 0)
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			handle = m_Indices.size();
+			m_Indices.push_back(INVALID_HANDLE);
+		}
+
+		m_Indices[handle] = m_Handles.size();
+		m_Handles.push_back(handle);
+		m_SceneNodes.push_back(sceneNode);
+
+		for (auto &array : m_Positions)
+			array.push_back(0.0f);
+
+		for (auto &array : m_Rotations)
+			array.push_back(0.0f);
+		m_Rotations[3].back() = 1.0f;
+
+		for (auto &array : m_Scales)
+			array.push_back(1.0f);
+
+		m_WorldMatrices.push_back(Matrix4());
+
+		for (auto &array : m_Centers)
+			array.push_back(0.0f);
+
+		for (auto &array : m_Extents)
+			array.push_back(0.0f);
+
+		return handle;
+	}
+
+	void TransformStore::Release(Handle handle)
+	{
+		if (!IsValid(handle))
+		{
+			FURYW << "Invalid transform handle " << handle << "!";
+			return;
+		}
+
+		// move the last element into the released slot.
+		unsigned int index = m_Indices[handle];
+		unsigned int last = m_Handles.size() - 1;
+
+		auto Remove = [index, last](AlignedVector<float> &array)
+		{
+			array[index] = array[last];
+			array.pop_back();
+		};
+
+		for (auto &array : m_Positions)
+			Remove(array);
+
+		for (auto &array : m_Rotations)
+			Remove(array);
+
+		for (auto &array : m_Scales)
+			Remove(array);
+
+		for (auto &array : m_Centers)
+			Remove(array);
+
+		for (auto &array : m_Extents)
+			Remove(array);
+
+		m_WorldMatrices[index] = m_WorldMatrices[last];
+		m_WorldMatrices.pop_back();
+
+		m_SceneNodes[index] = m_SceneNodes[last];
+		m_SceneNodes.pop_back();
+
+		Handle movedHandle = m_Handles[last];
+		m_Handles[index] = movedHandle;
+		m_Handles.pop_back();
+
+		m_Indices[movedHandle] = index;
+		m_Indices[handle] = INVALID_HANDLE;
+		m_FreeHandles.push_back(handle);
+	}
+
+	bool TransformStore::IsValid(Handle handle) const
+	{
+		return handle < m_Indices.size() && m_Indices[handle] != INVALID_HANDLE;
+	}
+
+	size_t TransformStore::GetCount() const
+	{
+		return m_Handles.size();
+	}
+
+	unsigned int TransformStore::GetIndex(Handle handle) const
+	{
+		return m_Indices[handle];
+	}
+
+	void TransformStore::SetLocalTransform(Handle handle, const Vector4 &position, const Quaternion &rotation, const Vector4 &scale)
+	{
+		unsigned int index = m_Indices[handle];
+
+		m_Positions[0][index] = position.x;
+		m_Positions[1][index] = position.y;
+		m_Positions[2][index] = position.z;
+
+		m_Rotations[0][index] = rotation.x;
+		m_Rotations[1][index] = rotation.y;
+		m_Rotations[2][index] = rotation.z;
+		m_Rotations[3][index] = rotation.w;
+
+		m_Scales[0][index] = scale.x;
+		m_Scales[1][index] = scale.y;
+		m_Scales[2][index] = scale.z;
+	}
+
+	void TransformStore::SetWorldMatrix(Handle handle, const Matrix4 &matrix)
+	{
+		m_WorldMatrices[m_Indices[handle]] = matrix;
+	}
+
+	void TransformStore::SetWorldAABB(Handle handle, const BoxBounds &aabb)
+	{
+		unsigned int index = m_Indices[handle];
+
+		float center[3], extents[3];
+		Frustum::PackAABB(aabb, center, extents);
+
+		for (int i = 0; i < 3; i++)
+		{
+			m_Centers[i][index] = center[i];
+			m_Extents[i][index] = extents[i];
+		}
+	}
+
+	SceneNode *TransformStore::GetSceneNode(unsigned int index) const
+	{
+		return m_SceneNodes[index];
+	}
+
+	const float *TransformStore::GetPositions(unsigned int axis) const
+	{
+		return m_Positions[axis].data();
+	}
+
+	const float *TransformStore::GetRotations(unsigned int axis) const
+	{
+		return m_Rotations[axis].data();
+	}
+
+	const float *TransformStore::GetScales(unsigned int axis) const
+	{
+		return m_Scales[axis].data();
+	}
+
+	const Matrix4 *TransformStore::GetWorldMatrices() const
+	{
+		return m_WorldMatrices.data();
+	}
+
+	const float *TransformStore::GetCenters(unsigned int axis) const
+	{
+		return m_Centers[axis].data();
+	}
+
+	const float *TransformStore::GetExtents(unsigned int axis) const
+	{
+		return m_Extents[axis].data();
+	}
+
+	void TransformStore::Cull(const Frustum &frustum, const SceneManager *sceneManager, const SceneManager::FilterFunc &filterFunc) const
+	{
+		size_t count = GetCount();
+		uint8_t visibleMask[CULL_BATCH_SIZE];
+
+		for (size_t begin = 0; begin < count; begin += CULL_BATCH_SIZE)
+		{
+			size_t size = std::min<size_t>(CULL_BATCH_SIZE, count - begin);
+
+			const float *centers[3] = { &m_Centers[0][begin], &m_Centers[1][begin], &m_Centers[2][begin] };
+			const float *extents[3] = { &m_Extents[0][begin], &m_Extents[1][begin], &m_Extents[2][begin] };
+			frustum.CullAABBs(centers, extents, size, visibleMask);
+
+			// only visible nodes are touched, to check which scene they belong to.
+			for (size_t i = 0; i < size; i++)
+			{
+				SceneNode *sceneNode = m_SceneNodes[begin + i];
+				if (visibleMask[i] && sceneNode->GetSceneManager() == sceneManager)
+					filterFunc(sceneNode->shared_from_this());
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#ifndef _FURY_TRANSFORM_STORE_H_
+#define _FURY_TRANSFORM_STORE_H_
+
+#include <array>
+#include <vector>
+
+#include "Fury/AlignedAllocator.h"
+#include "Fury/Matrix4.h"
+#include "Fury/SceneManager.h"
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	class Frustum;
+
+	class Quaternion;
+
+	class SceneNode;
+
+	class Vector4;
+
+	// Optional dense storage of scene node transforms, in cache aligned structure of arrays.
+	// Call TransformStore::Initialize before creating scene nodes to enable it,
+	// each SceneNode then holds a stable handle, TransformManager writes it's TRS, world matrix and world aabb here.
+	// While the store is enabled, SceneManager's frustum queries stream the aabbs through Frustum::CullAABBs
+	// instead of walking the scene, see SceneManager::WalkVisible.
+	// Data is kept packed by swapping the last element into removed slots, so dense indices may change
+	// but handles won't.
+	class FURY_API TransformStore : public Singleton<TransformStore>
+	{
+	public:
+
+		typedef std::shared_ptr<TransformStore> Ptr;
+
+		typedef unsigned int Handle;
+
+		static const Handle INVALID_HANDLE = 0xffffffff;
+
+	protected:
+
+		// handle -> dense index
+		std::vector<unsigned int> m_Indices;
+
+		// dense index -> handle
+		std::vector<Handle> m_Handles;
+
+		std::vector<Handle> m_FreeHandles;
+
+		std::vector<SceneNode*> m_SceneNodes;
+
+		// x, y, z
+		std::array<AlignedVector<float>, 3> m_Positions;
+
+		// x, y, z, w
+		std::array<AlignedVector<float>, 4> m_Rotations;
+
+		// x, y, z
+		std::array<AlignedVector<float>, 3> m_Scales;
+
+		AlignedVector<Matrix4> m_WorldMatrices;
+
+		// world aabb center, x, y, z
+		std::array<AlignedVector<float>, 3> m_Centers;
+
+		// world aabb extents, x, y, z
+		std::array<AlignedVector<float>, 3> m_Extents;
+
+	public:
+
+		Handle Allocate(SceneNode *sceneNode);
+
+		void Release(Handle handle);
+
+		bool IsValid(Handle handle) const;
+
+		// number of dense elements.
+		size_t GetCount() const;
+
+		unsigned int GetIndex(Handle handle) const;
+
+		void SetLocalTransform(Handle handle, const Vector4 &position, const Quaternion &rotation, const Vector4 &scale);
+
+		void SetWorldMatrix(Handle handle, const Matrix4 &matrix);
+
+		void SetWorldAABB(Handle handle, const BoxBounds &aabb);
+
+		SceneNode *GetSceneNode(unsigned int index) const;
+
+		// axis: 0 = x, 1 = y, 2 = z
+		const float *GetPositions(unsigned int axis) const;
+
+		// axis: 0 = x, 1 = y, 2 = z, 3 = w
+		const float *GetRotations(unsigned int axis) const;
+
+		const float *GetScales(unsigned int axis) const;
+
+		const Matrix4 *GetWorldMatrices() const;
+
+		const float *GetCenters(unsigned int axis) const;
+
+		const float *GetExtents(unsigned int axis) const;
+
+		// streams through world aabbs of all nodes, and calls filterFunc for visible ones attached to sceneManager.
+		void Cull(const Frustum &frustum, const SceneManager *sceneManager, const SceneManager::FilterFunc &filterFunc) const;
+	};
+}
+
+#endif // _FURY_TRANSFORM_STORE_H_
\ No newline at end of file
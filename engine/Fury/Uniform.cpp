@@ -58,8 +58,12 @@ namespace fury
 	template<typename Datatype, unsigned int Size>
 	void Uniform<Datatype, Size>::Bind(unsigned int program, const std::string &name)
 	{
-		unsigned int id = glGetUniformLocation(program, name.c_str());
+		Bind(glGetUniformLocation(program, name.c_str()));
+	}
 
+	template<typename Datatype, unsigned int Size>
+	void Uniform<Datatype, Size>::Bind(int id)
+	{
 		if (id == -1)
 			return;
 
@@ -21,6 +21,9 @@ namespace fury
 
 		virtual void Bind(unsigned int program, const std::string &name) = 0;
 
+		// binds to a known location of the current program.
+		virtual void Bind(int location) = 0;
+
 		virtual bool Load(const void* wrapper, bool object = true) override = 0;
 
 		virtual void Save(void* wrapper, bool object = true) override = 0;
@@ -55,6 +58,8 @@ namespace fury
 
 		virtual void Bind(unsigned int program, const std::string &name) override;
 
+		virtual void Bind(int location) override;
+
 		virtual bool Load(const void* wrapper, bool object = true) override;
 
 		virtual void Save(void* wrapper, bool object = true) override;
@@ -58,7 +58,7 @@ namespace fury
 		return x * x + y * y + z * z;
 	}
 
-	float Vector4::Distance(Vector4 other) const
+	float Vector4::Distance(const Vector4 &other) const
 	{
 		float dx = x - other.x;
 		float dy = y - other.y;
@@ -66,7 +66,7 @@ namespace fury
 		return sqrt(dx * dx + dy * dy + dz * dz);
 	}
 
-	Vector4 Vector4::CrossProduct(Vector4 other) const
+	Vector4 Vector4::CrossProduct(const Vector4 &other) const
 	{
 		return Vector4(
 			y * other.z - z * other.y, 
@@ -76,7 +76,7 @@ namespace fury
 		);
 	}
 
-	Vector4 Vector4::Project(Vector4 other) const
+	Vector4 Vector4::Project(const Vector4 &other) const
 	{
 		return other * (*this * other / other.SquareLength());
 	}
@@ -86,37 +86,37 @@ namespace fury
 		return Vector4(*this);
 	}
 	
-	bool Vector4::operator == (Vector4 other) const 
+	bool Vector4::operator == (const Vector4 &other) const 
 	{
 		return x == other.x && y == other.y && z == other.z;
 	}
 	
-	bool Vector4::operator != (Vector4 other) const 
+	bool Vector4::operator != (const Vector4 &other) const 
 	{
 		return x != other.x || y != other.y || z != other.z;
 	}
 
-	bool Vector4::operator < (Vector4 other) const
+	bool Vector4::operator < (const Vector4 &other) const
 	{
 		return x < other.x && y < other.y && z < other.z;
 	}
 
-	bool Vector4::operator <= (Vector4 other) const
+	bool Vector4::operator <= (const Vector4 &other) const
 	{
 		return x <= other.x && y <= other.y && z <= other.z;
 	}
 
-	bool Vector4::operator > (Vector4 other) const
+	bool Vector4::operator > (const Vector4 &other) const
 	{
 		return x > other.x && y > other.y && z > other.z;
 	}
 
-	bool Vector4::operator >= (Vector4 other) const
+	bool Vector4::operator >= (const Vector4 &other) const
 	{
 		return x >= other.x && y >= other.y && z >= other.z;
 	}
 
-	Vector4 &Vector4::operator = (Vector4 other) 
+	Vector4 &Vector4::operator = (const Vector4 &other) 
 	{
 		x = other.x; y = other.y; z = other.z;
 		return *this;
@@ -127,17 +127,17 @@ namespace fury
 		return Vector4(-x, -y, -z, 1.0f);
 	}
 	
-	Vector4 Vector4::operator + (Vector4 other) const 
+	Vector4 Vector4::operator + (const Vector4 &other) const 
 	{
 		return Vector4(x + other.x, y + other.y, z + other.z, 1.0f);
 	}
 	
-	Vector4 Vector4::operator - (Vector4 other) const 
+	Vector4 Vector4::operator - (const Vector4 &other) const 
 	{
 		return Vector4(x - other.x, y - other.y, z - other.z, 1.0f);
 	}
 
-	float Vector4::operator * (Vector4 other) const 
+	float Vector4::operator * (const Vector4 &other) const 
 	{
 		return x * other.x + y * other.y + z * other.z;
 	}
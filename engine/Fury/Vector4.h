@@ -11,7 +11,7 @@ namespace fury
 	 *	When you need a Vector4 with special w.
 	 *	Call Vector4(yourVector, yourW) to create one to make sure it's w is correct.
 	 */
-	class FURY_API Vector4
+	class FURY_API FURY_SIMD_ALIGN Vector4
 	{
 	public:
 
@@ -39,7 +39,7 @@ namespace fury
 		
 		Vector4(const Vector4 &other) : x(other.x), y(other.y), z(other.z), w(other.w) {}
 
-		Vector4(Vector4 other, const float w) : x(other.x), y(other.y), z(other.z), w(w) {}
+		Vector4(const Vector4 &other, const float w) : x(other.x), y(other.y), z(other.z), w(w) {}
 		
 		Vector4(float value) : x(value), y(value), z(value), w(1) {}
 
@@ -61,38 +61,38 @@ namespace fury
 
 		float SquareLength() const;
 
-		float Distance(Vector4 other) const;
+		float Distance(const Vector4 &other) const;
 
-		Vector4 CrossProduct(Vector4 other) const;
+		Vector4 CrossProduct(const Vector4 &other) const;
 
-		Vector4 Project(Vector4 other) const;
+		Vector4 Project(const Vector4 &other) const;
 
 		Vector4 Clone() const;
 		
 		// all operator ignores w component.
 		// or will simply set w to 1.0
 
-		bool operator == (Vector4 other) const;
+		bool operator == (const Vector4 &other) const;
 		
-		bool operator != (Vector4 other) const;
+		bool operator != (const Vector4 &other) const;
 
-		bool operator < (Vector4 other) const;
+		bool operator < (const Vector4 &other) const;
 
-		bool operator <= (Vector4 other) const;
+		bool operator <= (const Vector4 &other) const;
 
-		bool operator > (Vector4 other) const;
+		bool operator > (const Vector4 &other) const;
 
-		bool operator >= (Vector4 other) const;
+		bool operator >= (const Vector4 &other) const;
 
-		Vector4 &operator = (Vector4 other);
+		Vector4 &operator = (const Vector4 &other);
 		
 		Vector4 operator - () const;
 		
-		Vector4 operator + (Vector4 other) const;
+		Vector4 operator + (const Vector4 &other) const;
 		
-		Vector4 operator - (Vector4 other) const;
+		Vector4 operator - (const Vector4 &other) const;
 
-		float operator * (Vector4 other) const;
+		float operator * (const Vector4 &other) const;
 
 		Vector4 operator * (const float other) const;
 		
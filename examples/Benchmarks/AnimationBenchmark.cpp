@@ -0,0 +1,161 @@
+// Samples a long clip on a 128 joint skeleton, with the linear key scan AnimationPlayer used before
+// compiled clips, then with AnimationTrack cursors during playback and its binary search on random seeks,
+// then playback of the same clip compressed, which decodes keys while sampling.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <Fury/AnimationClip.h>
+#include <Fury/AnimationUtil.h>
+#include <Fury/MathUtil.h>
+#include <Fury/Quaternion.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// interpolated key at tick, scanning keys from the start.
+static bool LinearScan(const std::vector<KeyFrame> &keys, float tick, KeyFrame &a, KeyFrame &b, float &ratio)
+{
+	for (size_t i = 0; i + 1 < keys.size(); i++)
+	{
+		if (keys[i].tick <= tick && keys[i + 1].tick >= tick)
+		{
+			a = keys[i];
+			b = keys[i + 1];
+			ratio = (tick - a.tick) / (b.tick - a.tick);
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char *argv[])
+{
+	const unsigned int jointCount = 128;
+	const unsigned int frameCount = 600;
+	const unsigned int iterations = 5;
+
+	unsigned int keyCount = argc > 1 ? std::atoi(argv[1]) : 4000;
+
+	benchmark::InitializeLog();
+
+	auto clip = AnimationClip::Create("clip", 24);
+	for (unsigned int j = 0; j < jointCount; j++)
+	{
+		auto channel = clip->AddChannel("joint" + std::to_string(j));
+		for (unsigned int k = 0; k < keyCount; k++)
+		{
+			channel->positions.push_back(KeyFrame(k, std::sin(k * 0.1f + j), k * 0.01f, (float)j));
+			channel->rotations.push_back(KeyFrame(k, k * 0.01f, 0.2f, j * 0.3f));
+			channel->scalings.push_back(KeyFrame(k, 1.0f, 1.0f, 1.0f));
+		}
+	}
+	clip->CalculateDuration();
+
+	auto &channels = clip->GetCompiledChannels();
+	std::vector<unsigned int> cursors(jointCount * 3, 0);
+
+	std::printf("%u joints, %u keys per curve, %u frames\n", jointCount, keyCount, frameCount);
+
+	// 60 fps playback at 5x speed, looping over the clip.
+	auto PlaybackTick = [&](unsigned int frame)
+	{
+		return std::fmod(frame * 24.0f / 60.0f * 5.0f, (float)(keyCount - 1));
+	};
+
+	double sink = 0.0;
+
+	benchmark::Report("linear scan, euler keys", benchmark::Measure(iterations, [&]
+	{
+		KeyFrame a, b;
+		float ratio;
+		for (unsigned int f = 0; f < frameCount; f++)
+		{
+			float tick = PlaybackTick(f);
+			for (unsigned int j = 0; j < jointCount; j++)
+			{
+				auto channel = clip->GetChannelAt(j);
+				if (LinearScan(channel->positions, tick, a, b, ratio))
+					sink += a.x + (b.x - a.x) * ratio;
+				if (LinearScan(channel->scalings, tick, a, b, ratio))
+					sink += a.x + (b.x - a.x) * ratio;
+				if (LinearScan(channel->rotations, tick, a, b, ratio))
+				{
+					Quaternion from = MathUtil::EulerRadToQuat(Vector4(a.x, a.y, a.z));
+					Quaternion to = MathUtil::EulerRadToQuat(Vector4(b.x, b.y, b.z));
+					sink += from.Slerp(to, ratio).w;
+				}
+			}
+		}
+	}));
+
+	float output[4];
+
+	benchmark::Report("compiled tracks, playback cursors", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int f = 0; f < frameCount; f++)
+		{
+			float tick = PlaybackTick(f);
+			for (unsigned int j = 0; j < jointCount; j++)
+			{
+				auto &channel = channels[j];
+				channel.positions.Sample(tick, cursors[j * 3], output);
+				sink += output[0];
+				channel.rotations.Sample(tick, cursors[j * 3 + 1], output);
+				sink += output[3];
+				channel.scalings.Sample(tick, cursors[j * 3 + 2], output);
+				sink += output[0];
+			}
+		}
+	}));
+
+	// cursors miss on every frame, so each sample binary searches.
+	benchmark::Report("compiled tracks, random seeks", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int f = 0; f < frameCount; f++)
+		{
+			float tick = (f * 7919) % (keyCount - 1) + 0.5f;
+			for (unsigned int j = 0; j < jointCount; j++)
+			{
+				auto &channel = channels[j];
+				channel.positions.Sample(tick, cursors[j * 3], output);
+				sink += output[0];
+				channel.rotations.Sample(tick, cursors[j * 3 + 1], output);
+				sink += output[3];
+				channel.scalings.Sample(tick, cursors[j * 3 + 2], output);
+				sink += output[0];
+			}
+		}
+	}));
+
+	AnimationUtil::CompressAnimClip(clip);
+	auto &compressedChannels = clip->GetCompiledChannels();
+	std::fill(cursors.begin(), cursors.end(), 0);
+
+	benchmark::Report("compressed tracks, playback cursors", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int f = 0; f < frameCount; f++)
+		{
+			float tick = PlaybackTick(f);
+			for (unsigned int j = 0; j < jointCount; j++)
+			{
+				auto &channel = compressedChannels[j];
+				channel.positions.Sample(tick, cursors[j * 3], output);
+				sink += output[0];
+				channel.rotations.Sample(tick, cursors[j * 3 + 1], output);
+				sink += output[3];
+				channel.scalings.Sample(tick, cursors[j * 3 + 2], output);
+				sink += output[0];
+			}
+		}
+	}));
+
+	// keep results alive.
+	std::printf("%g\n", sink);
+
+	return 0;
+}
\ No newline at end of file
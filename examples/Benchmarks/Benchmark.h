@@ -0,0 +1,41 @@
+#ifndef _FURY_BENCHMARK_H_
+#define _FURY_BENCHMARK_H_
+
+// Small helpers shared by the benchmark executables.
+// They only need the engine library, no window or gl context, except OcclusionCullerBenchmark
+// which compares it's gpu path and needs a GL 4.3 context.
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+#include <Fury/Log.h>
+
+namespace benchmark
+{
+	// errors only, so engine warnings don't mix with results.
+	inline void InitializeLog()
+	{
+		fury::Log<0>::Initialize(fury::LogLevel::EROR, nullptr, true, fury::Formatter::Simple, false);
+	}
+
+	// average milliseconds of one call, after a warm up call.
+	inline double Measure(unsigned int iterations, const std::function<void()> &fn)
+	{
+		fn();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < iterations; i++)
+			fn();
+		auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+	}
+
+	inline void Report(const char *name, double ms)
+	{
+		std::printf("%-56s %12.4f ms\n", name, ms);
+	}
+}
+
+#endif // _FURY_BENCHMARK_H_
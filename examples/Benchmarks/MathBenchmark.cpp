@@ -0,0 +1,243 @@
+// Times Matrix4 kernels, after checking they match the scalar formulas, bit for bit for the kernels
+// that keep the scalar operation order and within an epsilon for the batched ones.
+// The scalar reference is the FURY_SIMD_DISABLE path, copied here so one build can compare both.
+// Exits with 1 if any result differs.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Fury/BoxBounds.h>
+#include <Fury/Matrix4.h>
+#include <Fury/Vector4.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+static void ScalarMultiply(const float *a, const float *b, float *out)
+{
+	for (int c = 0; c < 16; c += 4)
+		for (int r = 0; r < 4; r++)
+			out[c + r] = a[r] * b[c] + a[4 + r] * b[c + 1] + a[8 + r] * b[c + 2] + a[12 + r] * b[c + 3];
+}
+
+static void ScalarInverse(const float *m, float *out)
+{
+	for (int i = 0; i < 16; i++)
+		out[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+
+	float det = m[0] * (m[5] * m[10] - m[6] * m[9])
+		+ m[1] * (m[6] * m[8] - m[4] * m[10])
+		+ m[2] * (m[4] * m[9] - m[5] * m[8]);
+	if (det == 0)
+		return;
+
+	float det2 = 1.0f / det;
+	out[0] = (m[5] * m[10] - m[6] * m[9]) * det2;
+	out[1] = (m[2] * m[9] - m[1] * m[10]) * det2;
+	out[2] = (m[1] * m[6] - m[2] * m[5]) * det2;
+	out[3] = 0.0f;
+	out[4] = (m[6] * m[8] - m[4] * m[10]) * det2;
+	out[5] = (m[0] * m[10] - m[2] * m[8]) * det2;
+	out[6] = (m[2] * m[4] - m[0] * m[6]) * det2;
+	out[7] = 0.0f;
+	out[8] = (m[4] * m[9] - m[5] * m[8]) * det2;
+	out[9] = (m[1] * m[8] - m[0] * m[9]) * det2;
+	out[10] = (m[0] * m[5] - m[1] * m[4]) * det2;
+	out[11] = 0.0f;
+	out[12] = -(m[12] * out[0] + m[13] * out[4] + m[14] * out[8]);
+	out[13] = -(m[12] * out[1] + m[13] * out[5] + m[14] * out[9]);
+	out[14] = -(m[12] * out[2] + m[13] * out[6] + m[14] * out[10]);
+	out[15] = 1.0f;
+}
+
+static void ScalarTransformPoints(const float *m, const float *input, float *output, size_t count)
+{
+	for (size_t i = 0; i < count * 3; i += 3)
+	{
+		float x = input[i], y = input[i + 1], z = input[i + 2];
+		output[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+		output[i + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+		output[i + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+	}
+}
+
+static void ScalarTransformVectors(const float *m, const float *input, float *output, size_t count)
+{
+	for (size_t i = 0; i < count * 3; i += 3)
+	{
+		float x = input[i], y = input[i + 1], z = input[i + 2];
+		output[i] = x * m[0] + y * m[4] + z * m[8];
+		output[i + 1] = x * m[1] + y * m[5] + z * m[9];
+		output[i + 2] = x * m[2] + y * m[6] + z * m[10];
+	}
+}
+
+static void ScalarTransformAABBs(const float *m, const float *centers, const float *extents,
+	float *outCenters, float *outExtents, size_t count)
+{
+	ScalarTransformPoints(m, centers, outCenters, count);
+
+	float a[12];
+	for (int i = 0; i < 12; i++)
+		a[i] = std::abs(m[i]);
+
+	ScalarTransformVectors(a, extents, outExtents, count);
+}
+
+// min and max of the 8 transformed corners, as Multiply(BoxBounds) did before TransformAABBs.
+static void ScalarCornerBounds(const float *m, const BoxBounds &aabb, float *out)
+{
+	Vector4 min = aabb.GetMin(), max = aabb.GetMax();
+	for (int axis = 0; axis < 3; axis++)
+	{
+		out[axis] = INFINITY;
+		out[axis + 3] = -INFINITY;
+	}
+
+	for (int i = 0; i < 8; i++)
+	{
+		float corner[3] = { (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z };
+		float point[3];
+		ScalarTransformPoints(m, corner, point, 1);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			out[axis] = std::min(out[axis], point[axis]);
+			out[axis + 3] = std::max(out[axis + 3], point[axis]);
+		}
+	}
+}
+
+static bool Same(const char *name, const float *a, const float *b, size_t count)
+{
+	if (std::memcmp(a, b, count * sizeof(float)) == 0)
+		return true;
+
+	std::printf("%s differs from scalar path!\n", name);
+	return false;
+}
+
+// relative to the larger of 1 and the expected value.
+static bool Near(const char *name, const float *a, const float *b, size_t count, float epsilon = 1e-5f)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (std::abs(a[i] - b[i]) > epsilon * std::max(1.0f, std::abs(b[i])))
+		{
+			std::printf("%s differs from scalar path at %zu, %g != %g!\n", name, i, a[i], b[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	const unsigned int matrixCount = 4096;
+	const unsigned int pointCount = 1 << 16;
+	const unsigned int iterations = 100;
+
+	benchmark::InitializeLog();
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+	// affine matrices, with a few identity and translation free ones for signed zero results.
+	std::vector<Matrix4> matrices(matrixCount);
+	for (unsigned int i = 0; i < matrixCount; i++)
+	{
+		if (i % 16 == 0)
+			continue;
+
+		Matrix4 &m = matrices[i];
+		for (int j = 0; j < 12; j++)
+			m.Raw[j] = (j % 4 == 3) ? 0.0f : value(random);
+
+		for (int j = 12; j < 15; j++)
+			m.Raw[j] = i % 16 == 1 ? 0.0f : value(random);
+	}
+
+	std::vector<float> points(pointCount * 3);
+	for (auto &point : points)
+		point = value(random);
+
+	bool same = true;
+
+	for (unsigned int i = 0; i < matrixCount; i++)
+	{
+		const Matrix4 &a = matrices[i], &b = matrices[(i * 7 + 3) % matrixCount];
+		float expected[16];
+
+		ScalarMultiply(a.Raw, b.Raw, expected);
+		same &= Same("Matrix4::operator *", (a * b).Raw, expected, 16);
+
+		ScalarInverse(a.Raw, expected);
+		same &= Same("Matrix4::Inverse", a.Inverse().Raw, expected, 16);
+	}
+
+	std::vector<float> output(points.size()), expected(points.size());
+	Matrix4::TransformPoints(matrices[5], points.data(), output.data(), pointCount);
+	ScalarTransformPoints(matrices[5].Raw, points.data(), expected.data(), pointCount);
+	same &= Same("Matrix4::TransformPoints", output.data(), expected.data(), output.size());
+
+	Matrix4::TransformVectors(matrices[5], points.data(), output.data(), pointCount);
+	ScalarTransformVectors(matrices[5].Raw, points.data(), expected.data(), pointCount);
+	same &= Near("Matrix4::TransformVectors", output.data(), expected.data(), output.size());
+
+	// points as centers, their absolute values as extents.
+	std::vector<float> extents(points.size()), outExtents(points.size()), expectedExtents(points.size());
+	for (size_t i = 0; i < points.size(); i++)
+		extents[i] = std::abs(points[i]);
+
+	Matrix4::TransformAABBs(matrices[5], points.data(), extents.data(), output.data(), outExtents.data(), pointCount);
+	ScalarTransformAABBs(matrices[5].Raw, points.data(), extents.data(), expected.data(), expectedExtents.data(), pointCount);
+	same &= Near("Matrix4::TransformAABBs centers", output.data(), expected.data(), output.size());
+	same &= Near("Matrix4::TransformAABBs extents", outExtents.data(), expectedExtents.data(), outExtents.size());
+
+	BoxBounds bounds(Vector4(-1.0f, -2.0f, -3.0f), Vector4(1.0f, 2.0f, 3.0f)), transformed;
+	for (unsigned int i = 0; i < matrixCount; i++)
+	{
+		transformed = matrices[i].Multiply(bounds);
+		Vector4 min = transformed.GetMin(), max = transformed.GetMax();
+		float box[6] = { min.x, min.y, min.z, max.x, max.y, max.z }, corners[6];
+		ScalarCornerBounds(matrices[i].Raw, bounds, corners);
+		if (!Near("Matrix4::Multiply(BoxBounds)", box, corners, 6))
+		{
+			same = false;
+			break;
+		}
+	}
+
+	Matrix4 result;
+	benchmark::Report("Matrix4::operator *, 4096 matrices", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int i = 0; i < matrixCount; i++)
+			result = result * matrices[i];
+	}));
+
+	benchmark::Report("Matrix4::Inverse, 4096 matrices", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int i = 0; i < matrixCount; i++)
+			result = matrices[i].Inverse();
+	}));
+
+	benchmark::Report("Matrix4::TransformPoints, 64k points", benchmark::Measure(iterations, [&]
+	{
+		Matrix4::TransformPoints(matrices[5], points.data(), output.data(), pointCount);
+	}));
+
+	benchmark::Report("Matrix4::Multiply(BoxBounds), 4096 matrices", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int i = 0; i < matrixCount; i++)
+			transformed = matrices[i].Multiply(bounds);
+	}));
+
+	// keep results alive.
+	std::printf("%g %g\n", result.Raw[0], transformed.GetCenter().x);
+
+	std::printf(same ? "simd and scalar results match.\n" : "simd and scalar results differ!\n");
+	return same ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+// Builds OcclusionCuller's depth pyramid and culls instances on gpu, then compares both with the cpu reference
+// on the same synthetic depth buffer, a wall covering the left half of the view. Times both paths after that.
+// Unlike the other benchmarks this opens a hidden window, it needs a GL 4.3 context for compute shaders.
+// pass an instance count as first argument, 100k by default.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <SFML/Window.hpp>
+
+#include <Fury/BoxBounds.h>
+#include <Fury/Engine.h>
+#include <Fury/GLLoader.h>
+#include <Fury/GLState.h>
+#include <Fury/OcclusionCuller.h>
+#include <Fury/StreamBuffer.h>
+#include <Fury/Texture.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+static const int DEPTH_WIDTH = 1280;
+
+static const int DEPTH_HEIGHT = 720;
+
+static const unsigned int COMMAND_COUNT = 16;
+
+static float AsFloat(unsigned int bits)
+{
+	float value;
+	std::memcpy(&value, &bits, sizeof(float));
+	return value;
+}
+
+// largest difference between two pyramids, or -1 if their shapes differ.
+static float ComparePyramids(const std::vector<OcclusionCuller::Level> &a, const std::vector<OcclusionCuller::Level> &b)
+{
+	if (a.size() != b.size())
+		return -1.0f;
+
+	float diff = 0.0f;
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		if (a[i].width != b[i].width || a[i].height != b[i].height)
+			return -1.0f;
+
+		for (size_t j = 0; j < a[i].depths.size(); j++)
+			diff = std::max(diff, std::abs(a[i].depths[j] - b[i].depths[j]));
+	}
+	return diff;
+}
+
+// translation x of each matrix in a command's range, sorted, gpu writes them in atomic order.
+static std::vector<float> CommandMatrices(const std::vector<float> &culled, const DrawElementsIndirectCommand &command)
+{
+	std::vector<float> keys;
+	for (unsigned int i = 0; i < command.instanceCount; i++)
+		keys.push_back(culled[(command.baseInstance + i) * 16 + 12]);
+	std::sort(keys.begin(), keys.end());
+	return keys;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+	sf::Window window(sf::VideoMode(64, 64), "OcclusionCullerBenchmark", sf::Style::None, sf::ContextSettings(24, 8, 0, 4, 3));
+	window.setVisible(false);
+
+	if (!Engine::Initialize(window, 1, 0))
+		return 1;
+
+	if (!OcclusionCuller::IsSupported())
+	{
+		std::printf("no compute shader support, skipped.\n");
+		Engine::Shutdown();
+		return 0;
+	}
+
+	// camera at origin looking down -z.
+	Matrix4 viewProj;
+	viewProj.PerspectiveFov(1.0f, (float)DEPTH_WIDTH / DEPTH_HEIGHT, 1.0f, 500.0f);
+
+	Vector4 wall = viewProj.Multiply(Vector4(0.0f, 0.0f, -50.0f, 1.0f));
+	float wallDepth = wall.z / wall.w * 0.5f + 0.5f;
+
+	std::vector<float> depth(DEPTH_WIDTH * DEPTH_HEIGHT, 1.0f);
+	for (int y = 0; y < DEPTH_HEIGHT; y++)
+		std::fill_n(&depth[y * DEPTH_WIDTH], DEPTH_WIDTH / 2, wallDepth);
+
+	auto depthTexture = Texture::Create("depth");
+	depthTexture->CreateEmpty(DEPTH_WIDTH, DEPTH_HEIGHT, 0, TextureFormat::R32F);
+	GLState::ActiveTexture(GL_TEXTURE0);
+	GLState::BindTexture(GL_TEXTURE_2D, depthTexture->GetID());
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, DEPTH_WIDTH, DEPTH_HEIGHT, GL_RED, GL_FLOAT, &depth[0]);
+	GLState::BindTexture(GL_TEXTURE_2D, 0);
+
+	// boxes around the view, some in front of the wall, some behind it and some outside the frustum.
+	std::mt19937 random(9);
+	std::uniform_real_distribution<float> lateral(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> distance(-400.0f, -5.0f);
+	std::uniform_int_distribution<unsigned int> commandIndex(0, COMMAND_COUNT - 1);
+
+	std::vector<float> instances, bounds;
+	std::vector<DrawElementsIndirectCommand> commands(COMMAND_COUNT);
+	std::vector<unsigned int> owner(count);
+
+	instances.reserve(count * 16);
+	bounds.reserve(count * 8);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		owner[i] = commandIndex(random);
+		commands[owner[i]].instanceCount++;
+	}
+
+	unsigned int baseInstance = 0;
+	for (unsigned int c = 0; c < COMMAND_COUNT; c++)
+	{
+		commands[c].count = 36;
+		commands[c].firstIndex = 0;
+		commands[c].baseVertex = 0;
+		commands[c].baseInstance = baseInstance;
+		baseInstance += commands[c].instanceCount;
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		Vector4 position(lateral(random), lateral(random) * 0.5f, distance(random));
+
+		Matrix4 matrix;
+		matrix.Translate(position);
+		instances.insert(instances.end(), matrix.Raw, matrix.Raw + 16);
+
+		Vector4 min = position - Vector4(1.0f, 0.0f), max = position + Vector4(1.0f, 0.0f);
+		float box[8] = { min.x, min.y, min.z, AsFloat(owner[i]), max.x, max.y, max.z, AsFloat(i) };
+		bounds.insert(bounds.end(), box, box + 8);
+	}
+
+	auto culler = OcclusionCuller::Create();
+
+	std::vector<OcclusionCuller::Level> cpuPyramid, gpuPyramid;
+	std::vector<DrawElementsIndirectCommand> cpuCommands(commands);
+	std::vector<float> cpuCulled, gpuCulled(instances.size());
+
+	OcclusionCuller::BuildPyramid(&depth[0], DEPTH_WIDTH, DEPTH_HEIGHT, cpuPyramid);
+	OcclusionCuller::Cull(cpuPyramid, viewProj, viewProj, instances, bounds, cpuCommands, cpuCulled);
+
+	culler->BuildPyramid(depthTexture, viewProj);
+	culler->ReadPyramid(gpuPyramid);
+
+	StreamBuffer::BeginFrame();
+	culler->Cull(viewProj, instances, bounds, commands);
+	StreamBuffer::EndFrame();
+
+	std::vector<DrawElementsIndirectCommand> gpuCommands(COMMAND_COUNT);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler->GetCommandBuffer());
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, culler->GetCommandOffset(), COMMAND_COUNT * sizeof(DrawElementsIndirectCommand), &gpuCommands[0]);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler->GetInstanceBuffer());
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, gpuCulled.size() * sizeof(float), &gpuCulled[0]);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	float pyramidDiff = ComparePyramids(cpuPyramid, gpuPyramid);
+
+	unsigned int cpuVisible = 0, gpuVisible = 0, mismatches = 0;
+	for (unsigned int c = 0; c < COMMAND_COUNT; c++)
+	{
+		cpuVisible += cpuCommands[c].instanceCount;
+		gpuVisible += gpuCommands[c].instanceCount;
+		if (CommandMatrices(cpuCulled, cpuCommands[c]) != CommandMatrices(gpuCulled, gpuCommands[c]))
+			mismatches++;
+	}
+
+	std::printf("%u instances, %u commands, %d x %d depth, %zu levels\n", count, COMMAND_COUNT, DEPTH_WIDTH, DEPTH_HEIGHT, cpuPyramid.size());
+	std::printf("pyramid max difference %g, visible cpu %u gpu %u, %u commands differ\n", pyramidDiff, cpuVisible, gpuVisible, mismatches);
+
+	benchmark::Report("cpu BuildPyramid", benchmark::Measure(5, [&]
+	{
+		OcclusionCuller::BuildPyramid(&depth[0], DEPTH_WIDTH, DEPTH_HEIGHT, cpuPyramid);
+	}));
+
+	benchmark::Report("cpu Cull", benchmark::Measure(5, [&]
+	{
+		cpuCommands = commands;
+		OcclusionCuller::Cull(cpuPyramid, viewProj, viewProj, instances, bounds, cpuCommands, cpuCulled);
+	}));
+
+	// glFinish so the time covers the dispatches, not just queuing them.
+	benchmark::Report("gpu BuildPyramid", benchmark::Measure(5, [&]
+	{
+		culler->BuildPyramid(depthTexture, viewProj);
+		glFinish();
+	}));
+
+	benchmark::Report("gpu Cull, upload included", benchmark::Measure(5, [&]
+	{
+		StreamBuffer::BeginFrame();
+		culler->Cull(viewProj, instances, bounds, commands);
+		StreamBuffer::EndFrame();
+		glFinish();
+	}));
+
+	culler->DeleteBuffer();
+	depthTexture->DeleteBuffer();
+	Engine::Shutdown();
+
+	return pyramidDiff == 0.0f && mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
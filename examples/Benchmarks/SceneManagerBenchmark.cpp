@@ -0,0 +1,124 @@
+// Insert, update and GetRenderQuery cost of OcTree against LinearOcTree, at 10k, 100k and 1M nodes.
+// queries run with a narrow frustum that sees few nodes, and one above the scene that sees about half.
+// pass a smaller max node count as first argument to skip the larger scenes.
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Fury/BoxBounds.h>
+#include <Fury/Frustum.h>
+#include <Fury/LinearOcTree.h>
+#include <Fury/Material.h>
+#include <Fury/MathUtil.h>
+#include <Fury/Mesh.h>
+#include <Fury/MeshRender.h>
+#include <Fury/OcTree.h>
+#include <Fury/RenderQuery.h>
+#include <Fury/SceneNode.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+static const float WORLD_SIZE = 1000.0f;
+
+static void Run(const char *name, const SceneManager::Ptr &manager, std::vector<SceneNode::Ptr> &nodes)
+{
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> position(-WORLD_SIZE, WORLD_SIZE);
+
+	std::string prefix = std::string(name) + ", " + std::to_string(nodes.size() / 1000) + "k nodes, ";
+	std::string label;
+
+	label = prefix + "insert";
+	benchmark::Report(label.c_str(), benchmark::Measure(1, [&]
+	{
+		manager->Clear();
+		for (auto &node : nodes)
+			manager->AddSceneNode(node);
+	}));
+
+	// a tenth of the nodes move every frame.
+	std::vector<SceneNode::Ptr> moved;
+	for (size_t i = 0; i < nodes.size(); i += 10)
+		moved.push_back(nodes[i]);
+
+	label = prefix + "update 10%";
+	benchmark::Report(label.c_str(), benchmark::Measure(5, [&]
+	{
+		for (auto &node : moved)
+		{
+			node->SetLocalPosition(position(random), position(random) * 0.1f, position(random));
+			node->Recompose(true);
+		}
+	}));
+
+	Frustum narrow;
+	narrow.Setup(1.0f, 16.0f / 9.0f, 1.0f, WORLD_SIZE);
+	Matrix4 view;
+	view.AppendRotation(MathUtil::EulerRadToQuat(Vector4(0.2f, 0.8f, 0.0f)));
+	narrow.Transform(view);
+
+	// looks down at the scene, about half the nodes are visible.
+	Frustum wide;
+	wide.Setup(1.5f, 1.0f, 1.0f, WORLD_SIZE * 4.0f);
+	view.Identity();
+	view.AppendTranslation(Vector4(0.0f, WORLD_SIZE * 0.8f, 0.0f));
+	view.AppendRotation(MathUtil::EulerRadToQuat(Vector4(0.0f, -MathUtil::HalfPI, 0.0f)));
+	wide.Transform(view);
+
+	auto query = RenderQuery::Create();
+	label = prefix + "GetRenderQuery, narrow";
+	benchmark::Report(label.c_str(), benchmark::Measure(10, [&]
+	{
+		manager->GetRenderQuery(narrow, query);
+	}));
+
+	std::printf("%snarrow, %zu visible\n", prefix.c_str(), query->opaqueUnits.size());
+
+	label = prefix + "GetRenderQuery, wide";
+	benchmark::Report(label.c_str(), benchmark::Measure(3, [&]
+	{
+		manager->GetRenderQuery(wide, query);
+	}));
+
+	std::printf("%swide, %zu visible\n", prefix.c_str(), query->opaqueUnits.size());
+
+	manager->Clear();
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int maxCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+	benchmark::InitializeLog();
+
+	auto material = Material::Create("material");
+	auto mesh = Mesh::Create("mesh");
+	mesh->CalculateAABB(Vector4(-1.0f), Vector4(1.0f));
+
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-WORLD_SIZE, WORLD_SIZE);
+
+	for (unsigned int count = 10000; count <= maxCount; count *= 10)
+	{
+		std::vector<SceneNode::Ptr> nodes;
+		nodes.reserve(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			auto node = SceneNode::Create("node");
+			node->AddComponent(MeshRender::Create(material, mesh));
+			node->SetLocalPosition(position(random), position(random) * 0.1f, position(random));
+			node->Recompose(true);
+			nodes.push_back(node);
+		}
+
+		Run("OcTree", OcTree::Create(Vector4(-WORLD_SIZE), Vector4(WORLD_SIZE), 6), nodes);
+		Run("LinearOcTree", LinearOcTree::Create(Vector4(-WORLD_SIZE), Vector4(WORLD_SIZE), 6), nodes);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+// Empty job throughput of ThreadUtil, against a single mutex queue pool like the one it replaced,
+// and ParallelFor latency while a long Enqueue task keeps a worker busy.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <Fury/ThreadUtil.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// one std::queue of std::function behind one mutex and condition variable.
+class SingleQueuePool
+{
+protected:
+
+	std::vector<std::thread> m_Workers;
+
+	std::queue<std::function<void()>> m_Tasks;
+
+	std::mutex m_Mutex;
+
+	std::condition_variable m_Condition;
+
+	bool m_Stop = false;
+
+public:
+
+	SingleQueuePool(unsigned int numThreads)
+	{
+		for (unsigned int i = 0; i < numThreads; i++)
+		{
+			m_Workers.emplace_back([this]
+			{
+				while (true)
+				{
+					std::function<void()> task;
+					{
+						std::unique_lock<std::mutex> lock(m_Mutex);
+						m_Condition.wait(lock, [this] { return m_Stop || !m_Tasks.empty(); });
+						if (m_Stop && m_Tasks.empty())
+							return;
+
+						task = std::move(m_Tasks.front());
+						m_Tasks.pop();
+					}
+					task();
+				}
+			});
+		}
+	}
+
+	~SingleQueuePool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Stop = true;
+		}
+
+		m_Condition.notify_all();
+		for (auto &worker : m_Workers)
+			worker.join();
+	}
+
+	void Enqueue(std::function<void()> task)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Tasks.push(std::move(task));
+		}
+		m_Condition.notify_one();
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	const unsigned int jobCount = 100000;
+	const unsigned int iterations = 10;
+
+	unsigned int numThreads = argc > 1 ? std::atoi(argv[1]) : std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+	benchmark::InitializeLog();
+	ThreadUtil::Initialize(std::move(numThreads));
+	ThreadUtil::Instance()->SetMainThread();
+
+	auto threadUtil = ThreadUtil::Instance();
+	std::printf("%u empty jobs, %zu workers\n", jobCount, threadUtil->GetWorkerCount());
+
+	{
+		// the main thread only waits here, so the pool needs a worker even when ThreadUtil has none.
+		SingleQueuePool pool(std::max<unsigned int>(1, threadUtil->GetWorkerCount()));
+		benchmark::Report("single queue pool", benchmark::Measure(iterations, [&]
+		{
+			std::atomic<unsigned int> done(0);
+			for (unsigned int i = 0; i < jobCount; i++)
+				pool.Enqueue([&done] { done++; });
+
+			while (done.load() < jobCount)
+				std::this_thread::yield();
+		}));
+	}
+
+	// child jobs of one root, the pool only has MAX_JOB_COUNT slots.
+	benchmark::Report("ThreadUtil child jobs", benchmark::Measure(iterations, [&]
+	{
+		for (unsigned int batch = 0; batch < jobCount; batch += ThreadUtil::MAX_JOB_COUNT / 2)
+		{
+			auto root = threadUtil->CreateJob(nullptr);
+			unsigned int count = std::min<unsigned int>(ThreadUtil::MAX_JOB_COUNT / 2, jobCount - batch);
+			for (unsigned int i = 0; i < count; i++)
+				threadUtil->Run(threadUtil->CreateChildJob(root, nullptr));
+
+			threadUtil->Run(root);
+			threadUtil->WaitFor(root);
+		}
+	}));
+
+	benchmark::Report("ThreadUtil ParallelFor 100k empty items", benchmark::Measure(iterations, [&]
+	{
+		threadUtil->ParallelFor(0, jobCount, 1, [](size_t, size_t) {});
+	}));
+
+	std::vector<float> values(1 << 20, 1.0f);
+	auto Scale = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			values[i] = values[i] * 0.5f + 1.0f;
+	};
+
+	benchmark::Report("ParallelFor 1M floats", benchmark::Measure(iterations, [&]
+	{
+		threadUtil->ParallelFor(0, values.size(), 4096, Scale);
+	}));
+
+	// a long task shouldn't be run inline by the waiting thread.
+	std::atomic<bool> release(false);
+	bool finished = false;
+	threadUtil->Enqueue([&release](int&)
+	{
+		while (!release.load())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}, [&finished] { finished = true; });
+
+	benchmark::Report("ParallelFor 1M floats, busy background task", benchmark::Measure(iterations, [&]
+	{
+		threadUtil->ParallelFor(0, values.size(), 4096, Scale);
+	}));
+
+	release = true;
+	while (!finished)
+		threadUtil->Update();
+
+	threadUtil.reset();
+	ThreadUtil::Instance().reset();
+	return 0;
+}
@@ -0,0 +1,132 @@
+// Moves the root of deep and wide hierarchies inside an OcTree and times TransformManager::Update,
+// which recomposes the hierarchy level by level and batches octree updates and signals,
+// against the recursive SceneNode::Recompose it replaced.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Fury/BoxBounds.h>
+#include <Fury/OcTree.h>
+#include <Fury/SceneManager.h>
+#include <Fury/SceneNode.h>
+#include <Fury/ThreadUtil.h>
+#include <Fury/TransformManager.h>
+#include <Fury/Vector4.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// count nodes below root, each node has up to branching children.
+static SceneNode::Ptr CreateHierarchy(unsigned int count, unsigned int branching, std::vector<SceneNode::Ptr> &nodes)
+{
+	auto root = SceneNode::Create("root");
+	root->SetModelAABB(BoxBounds(Vector4(-1.0f), Vector4(1.0f)));
+	nodes.push_back(root);
+
+	for (unsigned int i = 1; i < count; i++)
+	{
+		auto node = SceneNode::Create("node" + std::to_string(i));
+		node->SetModelAABB(BoxBounds(Vector4(-1.0f), Vector4(1.0f)));
+		node->SetLocalPosition((float)(i % 7), 1.0f, (float)(i % 5));
+		nodes[(i - 1) / branching]->AddChild(node);
+		nodes.push_back(node);
+	}
+
+	return root;
+}
+
+// SceneNode::Recompose before TransformManager: depth first, inverse matrices computed eagerly,
+// octree update and OnTransformChange per node. UpdateTransform is protected, a derived class reaches it.
+struct RecursiveRecompose : public SceneNode
+{
+	static void Run(const SceneNode::Ptr &node)
+	{
+		bool (SceneNode::*updateTransform)() = &RecursiveRecompose::UpdateTransform;
+		(node.get()->*updateTransform)();
+
+		node->GetInvertLocalMatrix();
+		node->GetInvertWorldMatrix();
+
+		if (SceneManager *manager = node->GetSceneManager())
+			manager->UpdateSceneNode(node);
+
+		node->OnTransformChange->Emit(node);
+
+		for (unsigned int i = 0; i < node->GetChildCount(); i++)
+			Run(node->GetChildAt(i));
+	}
+};
+
+static void Run(const char *name, unsigned int count, unsigned int branching)
+{
+	const unsigned int iterations = 20;
+
+	auto octree = OcTree::Create(Vector4(-10000.0f), Vector4(10000.0f), 6);
+
+	std::vector<SceneNode::Ptr> nodes;
+	auto root = CreateHierarchy(count, branching, nodes);
+	root->Recompose(true);
+	octree->AddSceneNodeRecursively(root);
+
+	float offset = 0.0f;
+	std::string label = std::string(name) + ", move root + recursive Recompose";
+	benchmark::Report(label.c_str(), benchmark::Measure(iterations, [&]
+	{
+		offset += 1.0f;
+		root->SetLocalPosition(offset, 0.0f, 0.0f);
+		RecursiveRecompose::Run(root);
+	}));
+
+	// root is still queued in TransformManager from the moves above.
+	TransformManager::Instance()->Update();
+
+	label = std::string(name) + ", move root + Update";
+	benchmark::Report(label.c_str(), benchmark::Measure(iterations, [&]
+	{
+		offset += 1.0f;
+		root->SetLocalPosition(offset, 0.0f, 0.0f);
+		TransformManager::Instance()->Update();
+	}));
+
+	// inverse world matrices are computed on first request after a recompose.
+	label = std::string(name) + ", first GetInvertWorldMatrix";
+	benchmark::Report(label.c_str(), benchmark::Measure(iterations, [&]
+	{
+		root->SetLocalPosition(offset, 1.0f, 0.0f);
+		TransformManager::Instance()->Update();
+
+		for (auto &node : nodes)
+			node->GetInvertWorldMatrix();
+	}) - benchmark::Measure(iterations, [&]
+	{
+		root->SetLocalPosition(offset, 2.0f, 0.0f);
+		TransformManager::Instance()->Update();
+	}));
+
+	octree->Clear();
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int numThreads = argc > 1 ? std::atoi(argv[1]) : std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+	benchmark::InitializeLog();
+	ThreadUtil::Initialize(std::move(numThreads));
+	ThreadUtil::Instance()->SetMainThread();
+	TransformManager::Initialize();
+
+	std::printf("%zu workers\n", ThreadUtil::Instance()->GetWorkerCount());
+
+	Run("10k nodes, depth 10k", 10000, 1);
+	Run("10k nodes, binary tree", 10000, 2);
+	Run("10k nodes, 100 per parent", 10000, 100);
+	Run("100k nodes, 8 per parent", 100000, 8);
+
+	TransformManager::Instance().reset();
+	ThreadUtil::Instance().reset();
+	return 0;
+}
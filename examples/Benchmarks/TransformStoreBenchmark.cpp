@@ -0,0 +1,148 @@
+// Full scene transform update, frustum cull and GetRenderQuery, first with transforms read from SceneNodes,
+// then with TransformStore enabled, where TransformManager also writes the store and queries stream it.
+// pass a node count as first argument, 100k by default.
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Fury/BoxBounds.h>
+#include <Fury/Frustum.h>
+#include <Fury/Material.h>
+#include <Fury/MathUtil.h>
+#include <Fury/Mesh.h>
+#include <Fury/MeshRender.h>
+#include <Fury/OcTree.h>
+#include <Fury/RenderQuery.h>
+#include <Fury/SceneNode.h>
+#include <Fury/TransformManager.h>
+#include <Fury/TransformStore.h>
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+static const float WORLD_SIZE = 1000.0f;
+
+// children per root node.
+static const unsigned int BRANCHING = 100;
+
+static void Run(const char *name, unsigned int count, const Material::Ptr &material, const Mesh::Ptr &mesh)
+{
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> position(-WORLD_SIZE, WORLD_SIZE);
+	std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+
+	std::vector<SceneNode::Ptr> roots, nodes;
+	nodes.reserve(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		auto node = SceneNode::Create("node");
+		node->AddComponent(MeshRender::Create(material, mesh));
+
+		if (i % BRANCHING == 0)
+		{
+			node->SetLocalPosition(position(random), position(random) * 0.1f, position(random));
+			roots.push_back(node);
+		}
+		else
+		{
+			node->SetLocalPosition(offset(random), offset(random), offset(random));
+			roots.back()->AddChild(node);
+		}
+		nodes.push_back(node);
+	}
+
+	TransformManager::Recompose(roots);
+
+	auto octree = OcTree::Create(Vector4(-WORLD_SIZE * 1.1f), Vector4(WORLD_SIZE * 1.1f), 6);
+	for (auto &root : roots)
+		octree->AddSceneNodeRecursively(root);
+
+	std::string prefix = std::string(name) + ", ";
+	std::string label;
+
+	label = prefix + "full scene update";
+	benchmark::Report(label.c_str(), benchmark::Measure(5, [&]
+	{
+		TransformManager::Recompose(roots);
+	}));
+
+	Frustum narrow;
+	narrow.Setup(1.0f, 16.0f / 9.0f, 1.0f, WORLD_SIZE);
+	Matrix4 view;
+	view.AppendRotation(MathUtil::EulerRadToQuat(Vector4(0.2f, 0.8f, 0.0f)));
+	narrow.Transform(view);
+
+	// looks down at the scene, about half the nodes are visible.
+	Frustum wide;
+	wide.Setup(1.5f, 1.0f, 1.0f, WORLD_SIZE * 4.0f);
+	view.Identity();
+	view.AppendTranslation(Vector4(0.0f, WORLD_SIZE * 0.8f, 0.0f));
+	view.AppendRotation(MathUtil::EulerRadToQuat(Vector4(0.0f, -MathUtil::HalfPI, 0.0f)));
+	wide.Transform(view);
+
+	auto query = RenderQuery::Create();
+
+	for (auto frustum : { &narrow, &wide })
+	{
+		const char *frustumName = frustum == &narrow ? "narrow" : "wide";
+		unsigned int visible = 0;
+
+		// culls every node, without the octree.
+		label = prefix + "cull all nodes, " + frustumName;
+		benchmark::Report(label.c_str(), benchmark::Measure(5, [&]
+		{
+			visible = 0;
+			if (TransformStore::HasInstance())
+			{
+				TransformStore::Instance()->Cull(*frustum, octree.get(), [&](const SceneNode::Ptr&)
+				{
+					visible++;
+				});
+			}
+			else
+			{
+				for (auto &node : nodes)
+				{
+					if (frustum->IsInsideFast(node->GetWorldAABB()))
+						visible++;
+				}
+			}
+		}));
+
+		label = prefix + "OcTree GetRenderQuery, " + frustumName;
+		benchmark::Report(label.c_str(), benchmark::Measure(5, [&]
+		{
+			octree->GetRenderQuery(*frustum, query);
+		}));
+
+		std::printf("%s%s, %u culled visible, %zu in query\n", prefix.c_str(), frustumName, visible, query->opaqueUnits.size());
+	}
+
+	octree->Clear();
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+	benchmark::InitializeLog();
+
+	auto material = Material::Create("material");
+	auto mesh = Mesh::Create("mesh");
+	mesh->CalculateAABB(Vector4(-1.0f), Vector4(1.0f));
+
+	std::printf("%u nodes, %u per root\n", count, BRANCHING);
+
+	Run("SceneNode", count, material, mesh);
+
+	// nodes only get a handle when they are created after the store.
+	TransformStore::Initialize();
+	Run("TransformStore", count, material, mesh);
+	TransformStore::Instance().reset();
+
+	return 0;
+}
\ No newline at end of file
@@ -1,5 +1,15 @@
 #version 330
 
+// shared by all programs, see Shader::CAMERA_BLOCK.
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_near;
+	float camera_far;
+};
+
 #ifdef VERTEX_SHADER
 
 in vec3 vertex_position;
@@ -9,16 +19,23 @@ in vec3 vertex_normal;
 #ifdef SKINNED_MESH
 in ivec4 bone_ids;
 in vec3 bone_weights;
-uniform mat4 bone_matrices[35];
+// skinning palette, streamed per draw, see Shader::BONE_BLOCK.
+layout (std140) uniform BoneBlock
+{
+	mat4 bone_matrices[35];
+};
 #endif
 
 out vec3 out_normal;
 out vec2 out_uv;
 out float out_depth;
 
-uniform mat4 projection_matrix;
-uniform mat4 invert_view_matrix;
+#ifdef INSTANCED
+in mat4 instance_matrix;
+#define world_matrix instance_matrix
+#else
 uniform mat4 world_matrix;
+#endif
 
 void main()
 {
@@ -49,8 +66,6 @@ in vec3 out_normal;
 in vec2 out_uv;
 in float out_depth;
 
-uniform float camera_far = 10000;
-
 uniform vec3 ambient_color;
 
 uniform sampler2D diffuse_texture;